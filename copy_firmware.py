@@ -1,9 +1,47 @@
 import shutil
 import os
+import re
 import json
+import gzip
+import hashlib
 
 Import("env")
 
+def report_size_delta(src, dst):
+    # Compare the fresh image against the one currently published in docs/,
+    # so the effect of feature flags (see src/Config/Features.h) is visible.
+    new_size = os.path.getsize(src)
+    if os.path.exists(dst):
+        old_size = os.path.getsize(dst)
+        delta = new_size - old_size
+        pct = (delta * 100.0 / old_size) if old_size else 0.0
+        print(f"Firmware size: {new_size} bytes ({delta:+d} bytes, {pct:+.1f}% vs previous {old_size})")
+    else:
+        print(f"Firmware size: {new_size} bytes (no previous image to compare)")
+
+def read_version(project_dir):
+    # Single source of truth shared with the firmware (OTA version check)
+    with open(os.path.join(project_dir, "src", "Config", "Version.h")) as f:
+        match = re.search(r'#define\s+DLS_FW_VERSION\s+"([^"]+)"', f.read())
+    return match.group(1) if match else "0.0.0"
+
+def write_ota_image(src, firmware_dir):
+    # Compressed copy for HTTP OTA (src/Ota inflates it while flashing).
+    # mtime=0 keeps the archive byte-identical for identical firmware.
+    with open(src, "rb") as f:
+        data = f.read()
+    dst = os.path.join(firmware_dir, "firmware.bin.gz")
+    with open(dst, "wb") as raw:
+        with gzip.GzipFile(filename="", mode="wb", compresslevel=9, fileobj=raw, mtime=0) as gz:
+            gz.write(data)
+    gz_size = os.path.getsize(dst)
+    print(f"OTA image: {gz_size} bytes ({gz_size * 100.0 / len(data):.0f}% of {len(data)})")
+    return {
+        "path": "firmware.bin.gz",
+        "md5": hashlib.md5(data).hexdigest(), # Of the decompressed image
+        "size": len(data)
+    }
+
 def copy_firmware(source, target, env):
     print("Copying firmware files to docs/ folder for Webflasher...")
     
@@ -32,7 +70,7 @@ def copy_firmware(source, target, env):
 
     manifest = {
         "name": f"DLS Weather Node - {env_name}",
-        "version": "1.0.2",
+        "version": read_version(env.subst("$PROJECT_DIR")),
         "builds": [
             {
                 "chipFamily": "ESP32" if is_esp32 else board.upper().replace("DEVKIT", "").replace("-", ""), # Approximate
@@ -46,6 +84,8 @@ def copy_firmware(source, target, env):
         src = os.path.join(build_dir, filename)
         dst = os.path.join(firmware_dir, filename)
         if os.path.exists(src):
+            if filename == "firmware.bin":
+                report_size_delta(src, dst)
             shutil.copy(src, dst)
             manifest["builds"][0]["parts"].append({
                 "path": filename,
@@ -82,6 +122,7 @@ def copy_firmware(source, target, env):
     print(f"Generated manifest at {manifest_path}")
 
     # --- Generate UPDATE Manifest (Minimal - Only Firmware) ---
+    ota_entry = write_ota_image(os.path.join(build_dir, "firmware.bin"), firmware_dir)
     manifest_update = {
         "name": f"DLS Weather Node (Update) - {env_name}",
         "version": manifest["version"],
@@ -95,7 +136,8 @@ def copy_firmware(source, target, env):
                     }
                 ]
             }
-        ]
+        ],
+        "ota": ota_entry
     }
     update_path = os.path.join(firmware_dir, "manifest_update.json")
     with open(update_path, "w") as f:
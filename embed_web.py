@@ -0,0 +1,101 @@
+import os
+import gzip
+import hashlib
+
+# Pre-build step: gzip the dashboard in web/ and embed it as
+# src/Web/WebAssets.h. Also runs standalone: python3 embed_web.py
+try:
+    Import("env")
+    PROJECT_DIR = env.subst("$PROJECT_DIR")
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+WEB_DIR = os.path.join(PROJECT_DIR, "web")
+OUT_PATH = os.path.join(PROJECT_DIR, "src", "Web", "WebAssets.h")
+
+MIME_TYPES = {
+    ".html": "text/html",
+    ".js": "application/javascript",
+    ".css": "text/css",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+}
+
+def compress(data):
+    # mtime=0: identical input gives identical bytes, so the ETag is stable
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+def etag_of(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+def embed_web():
+    names = sorted(n for n in os.listdir(WEB_DIR) if os.path.splitext(n)[1] in MIME_TYPES)
+    pages = [n for n in names if n.endswith(".html")]
+    statics = [n for n in names if n not in pages]
+
+    assets = []
+    tags = {}
+    # Static assets first: their hashes are baked into the page URLs, so the
+    # files themselves can be cached forever
+    for name in statics:
+        with open(os.path.join(WEB_DIR, name), "rb") as f:
+            gz = compress(f.read())
+        tags[name] = etag_of(gz)
+        assets.append((name, gz, True))
+
+    for name in pages:
+        with open(os.path.join(WEB_DIR, name), "r", encoding="utf-8") as f:
+            html = f.read()
+        for static, tag in tags.items():
+            html = html.replace("{{" + static + "}}", f"/{static}?v={tag}")
+        assets.append((name, compress(html.encode("utf-8")), False))
+
+    lines = [
+        "// Generated by embed_web.py from web/ - do not edit.",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "struct WebAsset {",
+        "    const char* path;",
+        "    const char* type;",
+        "    const char* etag; // Quoted strong ETag of the gzip body",
+        "    const uint8_t* data;",
+        "    size_t size;",
+        "    bool immutable; // URL carries the content hash",
+        "};",
+        "",
+    ]
+    raw_total = 0
+    for i, (name, gz, _) in enumerate(assets):
+        lines.append(f"// {name}: {len(gz)} bytes gzip")
+        lines.append(f"static const uint8_t WEB_ASSET_{i}[] PROGMEM = {{")
+        for ofs in range(0, len(gz), 16):
+            lines.append("    " + ", ".join(f"0x{b:02x}" for b in gz[ofs:ofs + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+        raw_total += len(gz)
+
+    lines.append("static const WebAsset WEB_ASSETS[] = {")
+    for i, (name, gz, immutable) in enumerate(assets):
+        path = "/" if name == "index.html" else "/" + name
+        mime = MIME_TYPES[os.path.splitext(name)[1]]
+        lines.append(f'    {{"{path}", "{mime}", "\\"{etag_of(gz)}\\"", WEB_ASSET_{i}, sizeof(WEB_ASSET_{i}), {"true" if immutable else "false"}}},')
+    lines.append("};")
+    lines.append("")
+    lines.append(f"#define WEB_ASSET_COUNT {len(assets)}")
+    lines.append("")
+    content = "\n".join(lines)
+
+    # Only touch the header when the assets changed (no needless rebuilds)
+    old = None
+    if os.path.exists(OUT_PATH):
+        with open(OUT_PATH, "r", encoding="utf-8") as f:
+            old = f.read()
+    if old != content:
+        os.makedirs(os.path.dirname(OUT_PATH), exist_ok=True)
+        with open(OUT_PATH, "w", encoding="utf-8") as f:
+            f.write(content)
+        print(f"Embedded {len(assets)} web assets ({raw_total} bytes gzip) -> {OUT_PATH}")
+
+embed_web()
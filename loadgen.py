@@ -0,0 +1,72 @@
+import sys
+import time
+import threading
+import urllib.request
+import urllib.error
+
+# Hammers a node's HTTP API to check admission control:
+#   python3 loadgen.py <node-ip> [req/s] [seconds] [path]
+# Reports how many requests were answered, shed with 429 and failed, and the
+# latency of answered requests. Meanwhile, "trace" over serial should still
+# show sensor.air spans every 2 s and uploads on schedule.
+
+def main():
+    if len(sys.argv) < 2:
+        print("usage: loadgen.py <node-ip> [req/s] [seconds] [path]")
+        return 1
+    host = sys.argv[1]
+    rate = float(sys.argv[2]) if len(sys.argv) > 2 else 50
+    duration = float(sys.argv[3]) if len(sys.argv) > 3 else 30
+    path = sys.argv[4] if len(sys.argv) > 4 else "/api/weather"
+    url = "http://%s%s" % (host, path)
+
+    lock = threading.Lock()
+    counts = {"ok": 0, "shed": 0, "error": 0}
+    latencies = []
+    retry_after = set()
+
+    def one():
+        start = time.monotonic()
+        try:
+            with urllib.request.urlopen(url, timeout=5) as r:
+                r.read()
+            with lock:
+                counts["ok"] += 1
+                latencies.append(time.monotonic() - start)
+        except urllib.error.HTTPError as e:
+            with lock:
+                if e.code == 429:
+                    counts["shed"] += 1
+                    retry_after.add(e.headers.get("Retry-After"))
+                else:
+                    counts["error"] += 1
+        except Exception:
+            with lock:
+                counts["error"] += 1
+
+    threads = []
+    end = time.monotonic() + duration
+    next_at = time.monotonic()
+    while time.monotonic() < end:
+        t = threading.Thread(target=one, daemon=True)
+        t.start()
+        threads.append(t)
+        next_at += 1.0 / rate
+        time.sleep(max(0, next_at - time.monotonic()))
+    for t in threads:
+        t.join(6)
+
+    sent = len(threads)
+    print("%d requests in %.0f s to %s" % (sent, duration, url))
+    print("  answered %d, shed (429) %d, failed %d" % (counts["ok"], counts["shed"], counts["error"]))
+    if retry_after:
+        print("  Retry-After seen: %s" % ", ".join(sorted(str(v) for v in retry_after)))
+    if latencies:
+        latencies.sort()
+        p50 = latencies[len(latencies) // 2] * 1000
+        p99 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.99))] * 1000
+        print("  latency p50 %.0f ms, p99 %.0f ms" % (p50, p99))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,124 @@
+import argparse
+import json
+import socket
+import struct
+import sys
+
+# Minimal MQTT 3.1.1 broker for checking a node's publisher without
+# mosquitto:
+#   python3 mqttbroker.py [--port 1883] [--drop-after N] [--refuse N]
+# Point the node at it with SET_CONFIG {"mqttHost":"<this-pc-ip>"}. Every
+# CONNECT and PUBLISH is printed, and QoS 1 publishes get a PUBACK.
+#   --drop-after N  closes the first connection after N sample/batch
+#                   publishes without acking the last one; the node must
+#                   reconnect and resend it with DUP set
+#   --refuse N      closes the first N connections right away, like a broker
+#                   that is down; the node must keep its samples until acked
+# At exit (Ctrl-C or after --exit-after connections) it prints how many
+# distinct samples arrived and how many were duplicates.
+
+def read_exact(conn, n):
+    data = b""
+    while len(data) < n:
+        chunk = conn.recv(n - len(data))
+        if not chunk:
+            raise EOFError
+        data += chunk
+    return data
+
+def read_length(conn):
+    mult, value = 1, 0
+    while True:
+        b = read_exact(conn, 1)[0]
+        value += (b & 0x7F) * mult
+        mult *= 128
+        if not b & 0x80:
+            return value
+
+def samples_of(payload):
+    try:
+        data = json.loads(payload)
+    except ValueError:
+        return []
+    items = data if isinstance(data, list) else [data]
+    return [s.get("ts") for s in items if isinstance(s, dict)]
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--port", type=int, default=1883)
+    ap.add_argument("--drop-after", type=int, default=0)
+    ap.add_argument("--refuse", type=int, default=0)
+    ap.add_argument("--exit-after", type=int, default=0, help="stop after this many connections")
+    args = ap.parse_args()
+
+    srv = socket.socket()
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(("0.0.0.0", args.port))
+    srv.listen(1)
+    print("listening on %d" % args.port, flush=True)
+
+    session = set()  # Client ids seen, for the session present flag
+    seen = {}
+    connections = 0
+    try:
+        while not args.exit_after or connections < args.exit_after:
+            conn, addr = srv.accept()
+            connections += 1
+            if connections <= args.refuse:
+                print("-- refused %s" % addr[0], flush=True)
+                conn.close()
+                continue
+            published = 0
+            try:
+                while True:
+                    header = read_exact(conn, 1)[0]
+                    body = read_exact(conn, read_length(conn))
+                    kind = header >> 4
+                    if kind == 1:  # CONNECT
+                        flags = body[7]
+                        keepalive = struct.unpack(">H", body[8:10])[0]
+                        id_len = struct.unpack(">H", body[10:12])[0]
+                        client = body[12:12 + id_len].decode()
+                        print("CONNECT %s clean=%d will=%d keepalive=%d"
+                              % (client, (flags >> 1) & 1, (flags >> 2) & 1, keepalive), flush=True)
+                        present = 1 if client in session and not flags & 0x02 else 0
+                        session.add(client)
+                        conn.sendall(bytes([0x20, 2, present, 0]))
+                    elif kind == 3:  # PUBLISH
+                        qos = (header >> 1) & 3
+                        topic_len = struct.unpack(">H", body[0:2])[0]
+                        topic = body[2:2 + topic_len].decode()
+                        pos = 2 + topic_len
+                        pid = 0
+                        if qos:
+                            pid = struct.unpack(">H", body[pos:pos + 2])[0]
+                            pos += 2
+                        payload = body[pos:].decode(errors="replace")
+                        print("PUBLISH dup=%d qos=%d retain=%d id=%d %s %s"
+                              % ((header >> 3) & 1, qos, header & 1, pid, topic, payload), flush=True)
+                        if not topic.endswith("/status"):
+                            for ts in samples_of(payload):
+                                seen[ts] = seen.get(ts, 0) + 1
+                            published += 1
+                            if connections == args.refuse + 1 and published == args.drop_after:
+                                print("-- dropping without PUBACK", flush=True)
+                                break
+                        if qos:
+                            conn.sendall(bytes([0x40, 2]) + struct.pack(">H", pid))
+                    elif kind == 12:  # PINGREQ
+                        print("PINGREQ", flush=True)
+                        conn.sendall(bytes([0xD0, 0]))
+                    elif kind == 14:  # DISCONNECT
+                        print("DISCONNECT", flush=True)
+                        break
+            except (EOFError, ConnectionResetError):
+                print("-- connection closed", flush=True)
+            conn.close()
+    except KeyboardInterrupt:
+        pass
+    dups = sum(n - 1 for n in seen.values())
+    print("%d distinct samples, %d duplicates" % (len(seen), dups), flush=True)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,306 @@
+#include "Archive.h"
+#include "Log/Log.h"
+
+#define ARCHIVE_MAGIC 0x41534C44 // "DLSA"
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_MIN_EPOCH 1600000000UL // Anything earlier: NTP not synced yet
+
+static const char* const TIER_NAMES[TIER_COUNT] = {"raw", "5m", "1h"};
+static const uint32_t TIER_PERIOD_S[TIER_COUNT] = {60, 300, 3600};
+static const uint8_t TIER_PAGE_BUDGET[TIER_COUNT] = {64, 48, 16}; // 256 + 192 + 64 KB
+static const char* const CHANNEL_NAMES[ARCHIVE_CHANNELS] = {
+    "temperature", "humidity", "pressure", "iaq", "uv_index"
+};
+
+// Values per record: raw stores one per channel, rollups min/mean/max
+static inline uint8_t tierValues(ArchiveTier tier) {
+    return tier == TIER_RAW ? ARCHIVE_CHANNELS : ARCHIVE_CHANNELS * 3;
+}
+
+struct PageHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t tier;
+    uint8_t values;
+    uint8_t reserved;
+    uint32_t baseTs;
+};
+
+struct TierWriter {
+    uint32_t magic;
+    uint32_t pageBase; // Page being appended
+    uint32_t pageBytes;
+    GorillaState series;
+};
+
+struct Rollup {
+    uint32_t bucket; // epoch / period of the bucket being collected
+    int32_t min[ARCHIVE_CHANNELS];
+    int32_t max[ARCHIVE_CHANNELS];
+    int64_t sum[ARCHIVE_CHANNELS];
+    uint16_t count[ARCHIVE_CHANNELS];
+};
+
+// Survive deep sleep; a cold boot starts fresh pages
+RTC_DATA_ATTR static TierWriter s_writers[TIER_COUNT];
+RTC_DATA_ATTR static Rollup s_rollups[TIER_COUNT - 1]; // 5m, 1h
+RTC_DATA_ATTR static uint32_t s_lastRawSlot;
+
+static void pagePath(char* out, size_t size, ArchiveTier tier, uint32_t base) {
+    snprintf(out, size, "/arc/%u/%08lx", (unsigned)tier, (unsigned long)base);
+}
+
+// missing: the channel's sentinel (-999.0, or -1.0 for uvIndex)
+static inline int32_t toFixed(float v, float missing) {
+    if (v == missing || isnan(v)) return GORILLA_MISSING;
+    return (int32_t)lroundf(v * ARCHIVE_SCALE);
+}
+
+static void printFixed(Print &out, int32_t v) {
+    if (v == GORILLA_MISSING) {
+        out.print("null");
+        return;
+    }
+    out.printf("%s%ld.%02ld", v < 0 ? "-" : "", labs(v) / ARCHIVE_SCALE, labs(v) % ARCHIVE_SCALE);
+}
+
+bool Archive::begin() {
+    if (!LittleFS.begin(true)) {
+        LOG_E("Archive", "LittleFS baslatilamadi!");
+        return false;
+    }
+    LittleFS.mkdir("/arc");
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        char dir[12];
+        snprintf(dir, sizeof(dir), "/arc/%u", t);
+        LittleFS.mkdir(dir);
+        scanTier((ArchiveTier)t);
+
+        // RTC state pointing at a page that is gone (cold boot, wipe)
+        TierWriter &w = s_writers[t];
+        if (w.magic == ARCHIVE_MAGIC) {
+            PageIndex &idx = _pages[t];
+            if (idx.count == 0 || idx.base[idx.count - 1] != w.pageBase) w.magic = 0;
+        }
+    }
+    _ready = true;
+    LOG_I("Archive", "%u/%u/%u sayfa (raw/5m/1h)",
+          _pages[0].count, _pages[1].count, _pages[2].count);
+    return true;
+}
+
+void Archive::scanTier(ArchiveTier tier) {
+    PageIndex &idx = _pages[tier];
+    idx.count = 0;
+
+    char path[20];
+    snprintf(path, sizeof(path), "/arc/%u", (unsigned)tier);
+    File dir = LittleFS.open(path);
+    if (!dir || !dir.isDirectory()) return;
+
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+        const char* name = strrchr(f.name(), '/');
+        name = name ? name + 1 : f.name();
+        uint32_t base = strtoul(name, nullptr, 16);
+        f.close();
+        if (base == 0 || idx.count >= ARCHIVE_MAX_PAGES) continue;
+
+        // Insertion sort; directory order is not guaranteed
+        uint8_t i = idx.count++;
+        while (i > 0 && idx.base[i - 1] > base) {
+            idx.base[i] = idx.base[i - 1];
+            i--;
+        }
+        idx.base[i] = base;
+    }
+}
+
+bool Archive::startPage(ArchiveTier tier, uint32_t ts) {
+    PageIndex &idx = _pages[tier];
+    char path[24];
+
+    // Retention: drop the oldest page(s) before going over budget
+    while (idx.count >= TIER_PAGE_BUDGET[tier]) {
+        pagePath(path, sizeof(path), tier, idx.base[0]);
+        LittleFS.remove(path);
+        memmove(idx.base, idx.base + 1, (idx.count - 1) * sizeof(uint32_t));
+        idx.count--;
+    }
+
+    // Page names must stay unique and ascending (reboot within one slot)
+    if (idx.count && ts <= idx.base[idx.count - 1]) ts = idx.base[idx.count - 1] + 1;
+
+    pagePath(path, sizeof(path), tier, ts);
+    File f = LittleFS.open(path, "w");
+    if (!f) return false;
+    PageHeader hdr = {ARCHIVE_MAGIC, ARCHIVE_VERSION, (uint8_t)tier, tierValues(tier), 0, ts};
+    f.write((const uint8_t*)&hdr, sizeof(hdr));
+    f.close();
+
+    idx.base[idx.count++] = ts;
+    TierWriter &w = s_writers[tier];
+    w.magic = ARCHIVE_MAGIC;
+    w.pageBase = ts;
+    w.pageBytes = sizeof(hdr);
+    w.series.reset(ts);
+    return true;
+}
+
+void Archive::append(ArchiveTier tier, uint32_t ts, const int32_t* values) {
+    TierWriter &w = s_writers[tier];
+    uint8_t record[GORILLA_MAX_RECORD_BYTES];
+
+    if (w.magic != ARCHIVE_MAGIC && !startPage(tier, ts)) return;
+
+    GorillaState next = w.series;
+    size_t len = Gorilla::encode(next, ts, values, tierValues(tier), record, sizeof(record));
+    if (len == 0) return;
+    if (w.pageBytes + len > ARCHIVE_PAGE_BYTES) {
+        if (!startPage(tier, ts)) return;
+        next = w.series;
+        len = Gorilla::encode(next, ts, values, tierValues(tier), record, sizeof(record));
+    }
+
+    char path[24];
+    pagePath(path, sizeof(path), tier, w.pageBase);
+    File f = LittleFS.open(path, "a"); // Open per record: nothing buffered across a power cut
+    if (!f) return;
+    if (f.write(record, len) == len) {
+        w.series = next;
+        w.pageBytes += len;
+    }
+    f.close();
+}
+
+void Archive::rollup(uint8_t level, uint32_t epoch, const int32_t* values) {
+    ArchiveTier tier = (ArchiveTier)(level + 1);
+    Rollup &r = s_rollups[level];
+    uint32_t bucket = epoch / TIER_PERIOD_S[tier];
+
+    if (bucket != r.bucket) {
+        bool any = false;
+        int32_t out[ARCHIVE_CHANNELS * 3];
+        for (uint8_t c = 0; c < ARCHIVE_CHANNELS; c++) {
+            bool has = r.count[c] > 0;
+            any |= has;
+            out[c * 3 + 0] = has ? r.min[c] : GORILLA_MISSING;
+            out[c * 3 + 1] = has ? (int32_t)(r.sum[c] / r.count[c]) : GORILLA_MISSING;
+            out[c * 3 + 2] = has ? r.max[c] : GORILLA_MISSING;
+        }
+        if (any && r.bucket != 0) append(tier, r.bucket * TIER_PERIOD_S[tier], out);
+
+        r.bucket = bucket;
+        for (uint8_t c = 0; c < ARCHIVE_CHANNELS; c++) {
+            r.min[c] = INT32_MAX;
+            r.max[c] = INT32_MIN;
+            r.sum[c] = 0;
+            r.count[c] = 0;
+        }
+    }
+
+    for (uint8_t c = 0; c < ARCHIVE_CHANNELS; c++) {
+        int32_t v = values[c];
+        if (v == GORILLA_MISSING) continue;
+        if (v < r.min[c]) r.min[c] = v;
+        if (v > r.max[c]) r.max[c] = v;
+        r.sum[c] += v;
+        r.count[c]++;
+    }
+}
+
+void Archive::add(uint32_t epoch, const AirData &air, const LightData &light) {
+    if (!_ready || epoch < ARCHIVE_MIN_EPOCH) return;
+
+    // One raw point per minute: the first sample of each minute
+    uint32_t slot = epoch / TIER_PERIOD_S[TIER_RAW];
+    if (slot == s_lastRawSlot) return;
+    s_lastRawSlot = slot;
+
+    int32_t values[ARCHIVE_CHANNELS] = {
+        air.valid ? toFixed(air.temperature, -999.0f) : GORILLA_MISSING,
+        air.valid ? toFixed(air.humidity, -999.0f) : GORILLA_MISSING,
+        air.valid ? toFixed(air.pressure, -999.0f) : GORILLA_MISSING,
+        air.valid ? toFixed(air.iaq, -999.0f) : GORILLA_MISSING,
+        light.valid ? toFixed(light.uvIndex, -1.0f) : GORILLA_MISSING,
+    };
+
+    uint32_t ts = slot * TIER_PERIOD_S[TIER_RAW];
+    append(TIER_RAW, ts, values);
+    rollup(0, ts, values);
+    rollup(1, ts, values);
+}
+
+void Archive::query(ArchiveTier tier, uint32_t from, uint32_t to, Print &out) {
+    const uint8_t n = tierValues(tier);
+    static const char* const SUFFIX[3] = {"_min", "_mean", "_max"};
+
+    out.printf("{\"tier\":\"%s\",\"fields\":[\"time\"", TIER_NAMES[tier]);
+    for (uint8_t c = 0; c < ARCHIVE_CHANNELS; c++) {
+        if (tier == TIER_RAW) out.printf(",\"%s\"", CHANNEL_NAMES[c]);
+        else for (uint8_t k = 0; k < 3; k++) out.printf(",\"%s%s\"", CHANNEL_NAMES[c], SUFFIX[k]);
+    }
+    out.print("],\"rows\":[");
+
+    const PageIndex &idx = _pages[tier];
+    const char* sep = "";
+    uint32_t rows = 0;
+    for (uint8_t p = 0; p < idx.count; p++) {
+        // Page p holds [base[p], base[p+1])
+        if (idx.base[p] > to) break;
+        if (p + 1 < idx.count && idx.base[p + 1] <= from) continue;
+
+        char path[24];
+        pagePath(path, sizeof(path), tier, idx.base[p]);
+        File f = LittleFS.open(path, "r");
+        if (!f) continue;
+        PageHeader hdr;
+        if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) || hdr.magic != ARCHIVE_MAGIC ||
+            hdr.version != ARCHIVE_VERSION || hdr.values != n) {
+            f.close();
+            continue;
+        }
+
+        BitReader reader(f);
+        GorillaState state;
+        state.reset(hdr.baseTs);
+        uint32_t ts;
+        int32_t values[GORILLA_MAX_VALUES];
+        while (Gorilla::decode(reader, state, ts, values, n)) {
+            if (ts < from) continue;
+            if (ts > to) break;
+            out.printf("%s[%lu", sep, (unsigned long)ts);
+            for (uint8_t i = 0; i < n; i++) {
+                out.print(',');
+                printFixed(out, values[i]);
+            }
+            out.print(']');
+            sep = ",";
+            rows++;
+        }
+        f.close();
+    }
+    out.printf("],\"count\":%lu}", (unsigned long)rows);
+    out.println();
+}
+
+void Archive::printStatus(Print &out) {
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        const PageIndex &idx = _pages[t];
+        const TierWriter &w = s_writers[t];
+        out.printf("Archive %-3s: %u/%u sayfa", TIER_NAMES[t], idx.count, TIER_PAGE_BUDGET[t]);
+        if (idx.count) out.printf(", %lu .. ", (unsigned long)idx.base[0]);
+        if (w.magic == ARCHIVE_MAGIC) out.printf("son sayfa %lu B", (unsigned long)w.pageBytes);
+        out.println();
+    }
+    out.printf("LittleFS: %u / %u B\n", (unsigned)LittleFS.usedBytes(), (unsigned)LittleFS.totalBytes());
+}
+
+bool Archive::parseTier(const char* name, ArchiveTier &tier) {
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        if (strcasecmp(name, TIER_NAMES[t]) == 0) {
+            tier = (ArchiveTier)t;
+            return true;
+        }
+    }
+    return false;
+}
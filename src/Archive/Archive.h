@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "Sensor/Sensor.h"
+#include "GorillaCodec.h"
+
+// Long-term history on LittleFS in three tiers:
+//   raw  one snapshot per minute                      (~4 weeks)
+//   5m   min/mean/max per channel, rolled up from raw (~5 weeks)
+//   1h   min/mean/max per channel, rolled up from raw (~5 months)
+// (typical 6-17 bytes per record; 512 KB of LittleFS in total)
+// Each tier is a set of append-only page files (/arc/<tier>/<base ts hex>,
+// up to ARCHIVE_PAGE_BYTES) encoded with GorillaCodec. When a tier is over
+// its page budget the oldest page is deleted.
+//
+// Writer and rollup state live in RTC memory, so deep sleep wake-ups keep
+// appending to the same page instead of opening a new one every cycle.
+
+#define ARCHIVE_CHANNELS 5 // temperature, humidity, pressure, iaq, uv_index
+#define ARCHIVE_PAGE_BYTES 4096
+#define ARCHIVE_SCALE 100 // Fixed point: 0.01 units
+#define ARCHIVE_MAX_PAGES 64 // Per tier, upper bound for the index
+
+enum ArchiveTier : uint8_t {
+    TIER_RAW,
+    TIER_5MIN,
+    TIER_1H,
+    TIER_COUNT
+};
+
+class Archive {
+public:
+    bool begin();
+
+    // Feed every sample; epoch must come from NTP (ignored until synced).
+    void add(uint32_t epoch, const AirData &air, const LightData &light);
+
+    // Streams the rows of one tier in [from, to] as JSON, decoding page by
+    // page through a small buffer.
+    void query(ArchiveTier tier, uint32_t from, uint32_t to, Print &out);
+
+    void printStatus(Print &out);
+
+    static bool parseTier(const char* name, ArchiveTier &tier);
+
+private:
+    struct PageIndex {
+        uint32_t base[ARCHIVE_MAX_PAGES]; // Sorted page base timestamps
+        uint8_t count;
+    };
+
+    PageIndex _pages[TIER_COUNT];
+    bool _ready = false;
+
+    void scanTier(ArchiveTier tier);
+    void append(ArchiveTier tier, uint32_t ts, const int32_t* values);
+    bool startPage(ArchiveTier tier, uint32_t ts);
+    void rollup(uint8_t level, uint32_t epoch, const int32_t* values);
+};
@@ -0,0 +1,137 @@
+#include "GorillaCodec.h"
+
+void GorillaState::reset(uint32_t baseTs) {
+    ts = baseTs;
+    tsDelta = 0;
+    for (int32_t &v : values) v = 0;
+}
+
+void BitWriter::write(uint32_t value, uint8_t bits) {
+    while (bits--) {
+        size_t byte = _bitPos >> 3;
+        if (byte >= _cap) {
+            _overflow = true;
+            return;
+        }
+        uint8_t mask = 0x80 >> (_bitPos & 7);
+        if (value & (1UL << bits)) _buf[byte] |= mask;
+        else _buf[byte] &= ~mask;
+        _bitPos++;
+    }
+}
+
+bool BitReader::read(uint8_t bits, uint32_t &value) {
+    value = 0;
+    while (bits--) {
+        if (_bitsLeft == 0) {
+            if (_pos >= _len) {
+                int n = _in.read(_buf, sizeof(_buf));
+                if (n <= 0) return false;
+                _len = n;
+                _pos = 0;
+            }
+            _cur = _buf[_pos++];
+            _bitsLeft = 8;
+        }
+        _bitsLeft--;
+        value = (value << 1) | ((_cur >> _bitsLeft) & 1);
+    }
+    return true;
+}
+
+// --- Variable-length buckets ---
+// Prefix '0', '10', '110', '1110', '1111' selects the payload width.
+static const uint8_t TS_BITS[] = {0, 7, 9, 12, 32};
+static const uint8_t VALUE_BITS[] = {0, 7, 12, 20, 32};
+
+static inline uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+static void writePrefix(BitWriter &w, uint8_t bucket) {
+    if (bucket == 0) w.write(0, 1);
+    else if (bucket < 4) w.write(((1UL << bucket) - 1) << 1, bucket + 1); // 10, 110, 1110
+    else w.write(0xF, 4);
+}
+
+static bool readPrefix(BitReader &r, uint8_t &bucket) {
+    bucket = 0;
+    uint32_t bit;
+    while (bucket < 4) {
+        if (!r.read(1, bit)) return false;
+        if (!bit) break;
+        bucket++;
+    }
+    return true;
+}
+
+namespace Gorilla {
+
+size_t encode(GorillaState &state, uint32_t ts, const int32_t* values, uint8_t count,
+              uint8_t* out, size_t capacity) {
+    BitWriter w(out, capacity);
+
+    // --- Timestamp: delta of delta ---
+    int32_t delta = (int32_t)(ts - state.ts);
+    int64_t dod = (int64_t)delta - state.tsDelta;
+    uint32_t zz = zigzag((int32_t)dod);
+    uint8_t bucket = 0;
+    if (dod < INT32_MIN || dod > INT32_MAX) bucket = 4;
+    else if (dod != 0) {
+        bucket = 4;
+        for (uint8_t b = 1; b < 4; b++) {
+            if (zz < (1UL << TS_BITS[b])) { bucket = b; break; }
+        }
+    }
+    writePrefix(w, bucket);
+    if (bucket == 4) w.write((uint32_t)delta, 32); // Absolute delta, not dod
+    else if (bucket) w.write(zz, TS_BITS[bucket]);
+    state.tsDelta = delta;
+    state.ts = ts;
+
+    // --- Values: delta, or absolute when it does not fit in 20 bits ---
+    for (uint8_t i = 0; i < count; i++) {
+        int64_t d = (int64_t)values[i] - state.values[i];
+        uint8_t vb = 4;
+        if (d == 0) vb = 0;
+        else if (d >= -(1L << 19) && d < (1L << 19)) {
+            uint32_t z = zigzag((int32_t)d);
+            for (uint8_t b = 1; b < 4; b++) {
+                if (z < (1UL << VALUE_BITS[b])) { vb = b; break; }
+            }
+        }
+        writePrefix(w, vb);
+        if (vb == 4) w.write((uint32_t)values[i], 32);
+        else if (vb) w.write(zigzag((int32_t)d), VALUE_BITS[vb]);
+        state.values[i] = values[i];
+    }
+
+    return w.overflow() ? 0 : w.bytes();
+}
+
+bool decode(BitReader &in, GorillaState &state, uint32_t &ts, int32_t* values, uint8_t count) {
+    uint8_t bucket;
+    uint32_t raw = 0;
+    if (!readPrefix(in, bucket)) return false;
+    if (bucket && !in.read(TS_BITS[bucket], raw)) return false;
+    int32_t delta = (bucket == 4) ? (int32_t)raw : state.tsDelta + (bucket ? unzigzag(raw) : 0);
+
+    GorillaState next = state; // Commit only complete records
+    next.tsDelta = delta;
+    next.ts = state.ts + delta;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (!readPrefix(in, bucket)) return false;
+        raw = 0;
+        if (bucket && !in.read(VALUE_BITS[bucket], raw)) return false;
+        if (bucket == 4) next.values[i] = (int32_t)raw;
+        else if (bucket) next.values[i] = state.values[i] + unzigzag(raw);
+    }
+    in.align();
+
+    state = next;
+    ts = state.ts;
+    for (uint8_t i = 0; i < count; i++) values[i] = state.values[i];
+    return true;
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+// Gorilla-style record codec (Pelkonen et al., VLDB 2015), adapted to
+// fixed-point sensor values:
+// - timestamps: delta-of-delta in seconds, '0' when the cadence holds
+// - values: int32 fixed-point, zigzag delta against the previous record,
+//   '0' when unchanged; large jumps and gaps are stored as absolute 32 bit
+// Records are padded to a byte boundary, so a page is a plain sequence of
+// records that can be appended to a file and decoded from a stream.
+
+#define GORILLA_MAX_VALUES 16
+#define GORILLA_MISSING INT32_MIN // Fixed-point "no value"
+#define GORILLA_MAX_RECORD_BYTES (6 + GORILLA_MAX_VALUES * 5)
+
+// Per-series encoder/decoder state; both sides start from the page base.
+struct GorillaState {
+    uint32_t ts;
+    int32_t tsDelta;
+    int32_t values[GORILLA_MAX_VALUES];
+
+    void reset(uint32_t baseTs);
+};
+
+class BitWriter {
+public:
+    BitWriter(uint8_t* buf, size_t capacity) : _buf(buf), _cap(capacity) {}
+    void write(uint32_t value, uint8_t bits);
+    size_t bytes() const { return (_bitPos + 7) / 8; } // Padded to a byte
+    bool overflow() const { return _overflow; }
+
+private:
+    uint8_t* _buf;
+    size_t _cap;
+    size_t _bitPos = 0;
+    bool _overflow = false;
+};
+
+// Reads bits from a file through a small buffer (a page is never loaded
+// into RAM as a whole).
+class BitReader {
+public:
+    explicit BitReader(File &in) : _in(in) {}
+    bool read(uint8_t bits, uint32_t &value);
+    void align() { _bitsLeft = 0; }
+
+private:
+    File &_in;
+    uint8_t _buf[64];
+    uint8_t _len = 0;
+    uint8_t _pos = 0;
+    uint8_t _cur = 0;
+    uint8_t _bitsLeft = 0;
+};
+
+namespace Gorilla {
+// Encodes one record; returns bytes written to out (0 if it did not fit).
+size_t encode(GorillaState &state, uint32_t ts, const int32_t* values, uint8_t count,
+              uint8_t* out, size_t capacity);
+
+// Decodes the next record; false at end of stream or on a torn record.
+bool decode(BitReader &in, GorillaState &state, uint32_t &ts, int32_t* values, uint8_t count);
+}
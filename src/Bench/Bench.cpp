@@ -0,0 +1,147 @@
+#include "Bench.h"
+
+#if DLS_FEATURE_BENCH
+
+#include "BenchBaseline.h"
+#include <esp_timer.h>
+#include <stdlib.h>
+#include <Preferences.h>
+
+// --- Allocation Counting ---
+// Enabled through -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc in the
+// bench environments; every heap allocation in the image goes through here.
+static volatile uint32_t s_allocCount = 0;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    s_allocCount++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    s_allocCount++;
+    return __real_calloc(n, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    s_allocCount++;
+    return __real_realloc(ptr, size);
+}
+}
+
+uint32_t Bench::allocCount() {
+    return s_allocCount;
+}
+
+bool Bench::add(const char* name, BenchFn fn, uint16_t iterations) {
+    if (_count >= BENCH_MAX_CASES || iterations == 0) return false;
+    _cases[_count].name = name;
+    _cases[_count].fn = fn;
+    _cases[_count].iterations = iterations;
+    _count++;
+    return true;
+}
+
+BenchResult Bench::measure(const Case &c) {
+    BenchResult r;
+    r.name = c.name;
+
+    c.fn(); // Warm-up (lazy allocations, caches)
+
+    uint32_t allocStart = s_allocCount;
+    int64_t start = esp_timer_get_time();
+    for (uint16_t i = 0; i < c.iterations; i++) {
+        c.fn();
+    }
+    int64_t elapsedUs = esp_timer_get_time() - start;
+    uint32_t allocs = s_allocCount - allocStart;
+
+    r.nsPerIter = (uint32_t)((elapsedUs * 1000) / c.iterations);
+    r.allocsPerIter = (allocs + c.iterations - 1) / c.iterations;
+    return r;
+}
+
+static const BenchBaseline* findBaseline(const char* name) {
+    for (const BenchBaseline* b = BENCH_BASELINE; b->name != nullptr; b++) {
+        if (strcmp(b->name, name) == 0) return b;
+    }
+    return nullptr;
+}
+
+// --- Board-recorded baselines ---
+// NVS keys are limited to 15 characters, so each case is stored under the
+// FNV-1a hash of its name as {nsPerIter, allocsPerIter}.
+static void recordKey(const char* name, char key[9]) {
+    uint32_t h = 2166136261u;
+    for (const char* p = name; *p; p++) h = (h ^ (uint8_t)*p) * 16777619u;
+    snprintf(key, 9, "%08lx", (unsigned long)h);
+}
+
+void Bench::forgetRecorded() {
+    Preferences prefs;
+    prefs.begin(BENCH_NVS_NAMESPACE, false);
+    prefs.clear();
+    prefs.end();
+}
+
+bool Bench::run(Print &out) {
+    BenchResult results[BENCH_MAX_CASES];
+    bool pass = true;
+    Preferences prefs;
+    prefs.begin(BENCH_NVS_NAMESPACE, false);
+
+    out.println("\n[Bench] Running microbenchmarks...");
+    out.println("case                 ns/iter   allocs   baseline   status");
+
+    for (uint8_t i = 0; i < _count; i++) {
+        results[i] = measure(_cases[i]);
+        const BenchResult &r = results[i];
+        const BenchBaseline* b = findBaseline(r.name);
+
+        const char* status = "NEW";
+        BenchBaseline expect = {r.name, 0, 0};
+        bool fresh = false;
+        if (b) {
+            expect = *b;
+            if (expect.nsPerIter == BENCH_FROM_BOARD || expect.allocsPerIter == BENCH_FROM_BOARD) {
+                char key[9];
+                recordKey(r.name, key);
+                uint32_t recorded[2];
+                if (prefs.getBytes(key, recorded, sizeof(recorded)) != sizeof(recorded)) {
+                    recorded[0] = r.nsPerIter;
+                    recorded[1] = r.allocsPerIter;
+                    prefs.putBytes(key, recorded, sizeof(recorded));
+                    fresh = true;
+                }
+                if (expect.nsPerIter == BENCH_FROM_BOARD) expect.nsPerIter = recorded[0];
+                if (expect.allocsPerIter == BENCH_FROM_BOARD) expect.allocsPerIter = recorded[1];
+            }
+            uint32_t limit = expect.nsPerIter + (expect.nsPerIter * BENCH_TIME_TOLERANCE_PCT) / 100;
+            bool slow = r.nsPerIter > limit;
+            bool allocs = r.allocsPerIter > expect.allocsPerIter;
+            status = slow ? (allocs ? "SLOW+ALLOC" : "SLOW") : (allocs ? "ALLOC" : (fresh ? "REC" : "OK"));
+            if (slow || allocs) pass = false;
+        }
+
+        out.printf("%-20s %8u %8u %10u   %s\n",
+                   r.name, (unsigned)r.nsPerIter, (unsigned)r.allocsPerIter,
+                   (unsigned)expect.nsPerIter, status);
+    }
+    prefs.end();
+
+    // Paste-ready block for BenchBaseline.h
+    out.println("[Bench] Baseline:");
+    for (uint8_t i = 0; i < _count; i++) {
+        out.printf("    { \"%s\", %u, %u },\n", results[i].name,
+                   (unsigned)results[i].nsPerIter, (unsigned)results[i].allocsPerIter);
+    }
+
+    out.println(pass ? "[Bench] PASS" : "[Bench] FAIL (regression beyond threshold)");
+    return pass;
+}
+
+#endif
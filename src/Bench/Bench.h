@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include "Config/Features.h"
+
+// Minimal on-device microbenchmark runner.
+// Each case is timed over N iterations and compared against the recorded
+// baseline in BenchBaseline.h; a case fails when it is slower than the
+// baseline by more than BENCH_TIME_TOLERANCE_PCT or allocates more often.
+// Baselines marked BENCH_FROM_BOARD are recorded in NVS on the first run.
+
+#define BENCH_MAX_CASES 16
+#define BENCH_TIME_TOLERANCE_PCT 20
+#define BENCH_NVS_NAMESPACE "dls-bench"
+
+struct BenchResult {
+    const char* name = nullptr;
+    uint32_t nsPerIter = 0;
+    uint32_t allocsPerIter = 0;
+};
+
+class Bench {
+public:
+    typedef std::function<void()> BenchFn;
+
+    // Registers a case; name must be a string literal (stored by pointer).
+    bool add(const char* name, BenchFn fn, uint16_t iterations = 100);
+
+    // Runs all cases, prints a report and returns false on any regression.
+    bool run(Print &out);
+
+    // Heap allocations seen by the malloc wrappers (0 if not wrapped).
+    static uint32_t allocCount();
+
+    // Drops the board-recorded baselines; the next run records them again.
+    static void forgetRecorded();
+
+private:
+    struct Case {
+        const char* name;
+        BenchFn fn;
+        uint16_t iterations;
+    };
+
+    Case _cases[BENCH_MAX_CASES];
+    uint8_t _count = 0;
+
+    BenchResult measure(const Case &c);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+
+// Recorded benchmark baselines per target.
+// Regenerate by flashing the matching *_bench environment and pasting the
+// "Baseline" block printed on the serial monitor. Cases without an entry are
+// reported as NEW and never fail.
+//
+// BENCH_FROM_BOARD takes the value from the first run on the board itself:
+// it is stored in NVS (status REC) and later runs are checked against it
+// with the same tolerance. "bench reset" forgets the stored values. Pasted
+// numbers replace the marker and hold for every board of that target.
+//
+// The allocation counts below hold on every target: after the warm-up call
+// page rendering draws from the cached layers and stack buffers, and the
+// conversion and metrics paths are plain arithmetic. api_json and the
+// config cases build Strings, so their counts depend on the core version.
+
+#define BENCH_FROM_BOARD 0xFFFFFFFFUL
+
+struct BenchBaseline {
+    const char* name;
+    uint32_t nsPerIter;
+    uint32_t allocsPerIter;
+};
+
+#if CONFIG_IDF_TARGET_ESP32C3
+static const BenchBaseline BENCH_BASELINE[] = {
+    { "api_json",         BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { "page_net",         BENCH_FROM_BOARD, 0 },
+    { "page_air",         BENCH_FROM_BOARD, 0 },
+    { "page_rain",        BENCH_FROM_BOARD, 0 },
+    { "page_wind",        BENCH_FROM_BOARD, 0 },
+    { "page_light",       BENCH_FROM_BOARD, 0 },
+    { "sensor_convert",   BENCH_FROM_BOARD, 0 },
+    { "metrics_float",    BENCH_FROM_BOARD, 0 },
+    { "metrics_fixed",    BENCH_FROM_BOARD, 0 },
+    { "config_to_json",   BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { "config_from_json", BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { nullptr, 0, 0 }
+};
+#elif CONFIG_IDF_TARGET_ESP32S3
+static const BenchBaseline BENCH_BASELINE[] = {
+    { "api_json",         BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { "page_net",         BENCH_FROM_BOARD, 0 },
+    { "page_air",         BENCH_FROM_BOARD, 0 },
+    { "page_rain",        BENCH_FROM_BOARD, 0 },
+    { "page_wind",        BENCH_FROM_BOARD, 0 },
+    { "page_light",       BENCH_FROM_BOARD, 0 },
+    { "sensor_convert",   BENCH_FROM_BOARD, 0 },
+    { "metrics_float",    BENCH_FROM_BOARD, 0 },
+    { "metrics_fixed",    BENCH_FROM_BOARD, 0 },
+    { "config_to_json",   BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { "config_from_json", BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { nullptr, 0, 0 }
+};
+#else
+static const BenchBaseline BENCH_BASELINE[] = {
+    { "api_json",         BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { "page_net",         BENCH_FROM_BOARD, 0 },
+    { "page_air",         BENCH_FROM_BOARD, 0 },
+    { "page_rain",        BENCH_FROM_BOARD, 0 },
+    { "page_wind",        BENCH_FROM_BOARD, 0 },
+    { "page_light",       BENCH_FROM_BOARD, 0 },
+    { "sensor_convert",   BENCH_FROM_BOARD, 0 },
+    { "metrics_float",    BENCH_FROM_BOARD, 0 },
+    { "metrics_fixed",    BENCH_FROM_BOARD, 0 },
+    { "config_to_json",   BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { "config_from_json", BENCH_FROM_BOARD, BENCH_FROM_BOARD },
+    { nullptr, 0, 0 }
+};
+#endif
@@ -0,0 +1,176 @@
+#include "I2CBus.h"
+#include <esp_timer.h>
+#include "Log/Log.h"
+
+struct DeviceProfile {
+    const char* name;
+    uint32_t ratedHz;
+};
+
+static const DeviceProfile PROFILES[I2C_DEV_COUNT] = {
+    {"default",  DLS_I2C_DEFAULT_HZ},
+    {"oled",     DLS_I2C_OLED_HZ},
+    {"bme680",   400000UL},  // HS mode (3.4 MHz) needs a master code, Fm is the usable limit
+    {"bme280",   400000UL},
+    {"bmp280",   400000UL},
+    {"shtc3",    1000000UL},
+    {"sht3x",    1000000UL},
+    {"veml6075", 400000UL},
+};
+
+TwoWire* I2CBus::_wire = nullptr;
+int I2CBus::_sda = -1;
+int I2CBus::_scl = -1;
+uint32_t I2CBus::_recoveries = 0;
+I2CBus::Health I2CBus::_health[I2C_DEV_COUNT];
+uint32_t I2CBus::_clock = 0;
+I2CDevice I2CBus::_owner = I2C_DEV_DEFAULT;
+uint8_t I2CBus::_depth = 0;
+uint64_t I2CBus::_acquiredUs = 0;
+uint64_t I2CBus::_windowStartUs = 0;
+uint32_t I2CBus::_switches = 0;
+I2CBus::Stats I2CBus::_stats[I2C_DEV_COUNT];
+
+void I2CBus::begin(TwoWire &wire, int sda, int scl) {
+    _wire = &wire;
+    _sda = sda;
+    _scl = scl;
+    _clock = DLS_I2C_DEFAULT_HZ;
+    checkLines(); // A part may still be mid-transfer from before the reset
+    wire.begin(sda, scl, _clock);
+    wire.setTimeOut(DLS_I2C_TIMEOUT_MS);
+    resetStats();
+}
+
+uint32_t I2CBus::clockFor(I2CDevice dev) {
+    uint32_t hz = PROFILES[dev].ratedHz;
+    return hz < DLS_I2C_MAX_HZ ? hz : DLS_I2C_MAX_HZ;
+}
+
+void I2CBus::acquire(I2CDevice dev) {
+    if (_depth++ > 0) return;
+    _owner = dev;
+
+    uint32_t hz = clockFor(dev);
+    if (_wire && hz != _clock) {
+        _wire->setClock(hz);
+        _clock = hz;
+        _switches++;
+    }
+    _acquiredUs = esp_timer_get_time();
+}
+
+void I2CBus::release() {
+    if (_depth == 0 || --_depth > 0) return;
+    Stats &s = _stats[_owner];
+    s.heldUs += esp_timer_get_time() - _acquiredUs;
+    s.transactions++;
+}
+
+// --- Fault Handling ---
+bool I2CBus::ready(I2CDevice dev) {
+    const Health &h = _health[dev];
+    return !h.degraded || (long)(millis() - h.retryAt) >= 0;
+}
+
+void I2CBus::report(I2CDevice dev, bool ok) {
+    Health &h = _health[dev];
+    if (ok) {
+        if (h.degraded) LOG_I("I2C", "%s tekrar calisiyor.", PROFILES[dev].name);
+        h.fails = 0;
+        h.backoffLevel = 0;
+        h.degraded = false;
+        return;
+    }
+
+    _stats[dev].failures++;
+    checkLines();
+    if (h.fails < 255) h.fails++;
+    if (h.degraded || h.fails >= DLS_I2C_DEGRADE_FAILS) {
+        // Failed re-probes double the wait
+        unsigned long wait = DLS_I2C_BACKOFF_BASE_MS << h.backoffLevel;
+        if (wait > DLS_I2C_BACKOFF_MAX_MS) wait = DLS_I2C_BACKOFF_MAX_MS;
+        else h.backoffLevel++;
+        if (!h.degraded) LOG_W("I2C", "%s devre disi, %lu ms sonra denenecek.", PROFILES[dev].name, wait);
+        h.degraded = true;
+        h.retryAt = millis() + wait;
+    }
+}
+
+bool I2CBus::ping(uint8_t addr) {
+    if (!_wire) return false;
+    _wire->beginTransmission(addr);
+    return _wire->endTransmission() == 0;
+}
+
+bool I2CBus::checkLines() {
+    if (_sda < 0 || _scl < 0) return true;
+    if (digitalRead(_sda) == HIGH && digitalRead(_scl) == HIGH) return true;
+    return recover();
+}
+
+// Clock out whatever byte the slave thinks it is sending, then STOP
+bool I2CBus::recover() {
+    bool started = _wire && _wire->end();
+
+    pinMode(_sda, INPUT_PULLUP);
+    pinMode(_scl, OUTPUT_OPEN_DRAIN);
+    digitalWrite(_scl, HIGH);
+    delayMicroseconds(5);
+    for (uint8_t i = 0; i < 9 && digitalRead(_sda) == LOW; i++) {
+        digitalWrite(_scl, LOW);
+        delayMicroseconds(5);
+        digitalWrite(_scl, HIGH);
+        delayMicroseconds(5);
+    }
+    pinMode(_sda, OUTPUT_OPEN_DRAIN);
+    digitalWrite(_sda, LOW);
+    delayMicroseconds(5);
+    digitalWrite(_sda, HIGH);
+    delayMicroseconds(5);
+    pinMode(_sda, INPUT_PULLUP);
+    pinMode(_scl, INPUT_PULLUP);
+    bool freed = digitalRead(_sda) == HIGH && digitalRead(_scl) == HIGH;
+
+    if (started) {
+        _wire->begin(_sda, _scl, _clock);
+        _wire->setTimeOut(DLS_I2C_TIMEOUT_MS);
+    }
+    _recoveries++;
+    LOG_W("I2C", "Bus kurtarma: %s", freed ? "OK" : "SDA/SCL hala dusuk!");
+    return freed;
+}
+
+void I2CBus::resetStats() {
+    memset(_stats, 0, sizeof(_stats)); // Health is state, not a statistic
+    _switches = 0;
+    _windowStartUs = esp_timer_get_time();
+}
+
+void I2CBus::printStatus(Print &out) {
+    uint64_t windowUs = esp_timer_get_time() - _windowStartUs;
+    uint64_t busyUs = 0;
+    for (const Stats &s : _stats) busyUs += s.heldUs;
+
+    out.printf("I2C: %lu Hz now, cap %lu Hz, %lu clock switches, %lu recoveries\n",
+               (unsigned long)_clock, (unsigned long)DLS_I2C_MAX_HZ, (unsigned long)_switches,
+               (unsigned long)_recoveries);
+    out.printf("  Busy %.2f %% of %lu s\n",
+               windowUs ? busyUs * 100.0f / windowUs : 0.0f, (unsigned long)(windowUs / 1000000));
+    out.println("  device        Hz    trans    held ms    avg us  fails");
+    for (uint8_t i = 0; i < I2C_DEV_COUNT; i++) {
+        const Stats &s = _stats[i];
+        const Health &h = _health[i];
+        if (!s.transactions && !s.failures && !h.degraded) continue;
+        out.printf("  %-8s %7lu %8lu %10lu %9lu %6lu", PROFILES[i].name,
+                   (unsigned long)clockFor((I2CDevice)i), (unsigned long)s.transactions,
+                   (unsigned long)(s.heldUs / 1000),
+                   (unsigned long)(s.transactions ? s.heldUs / s.transactions : 0),
+                   (unsigned long)s.failures);
+        if (h.degraded) {
+            long wait = (long)(h.retryAt - millis());
+            out.printf("  DEGRADED, retry in %ld s", wait > 0 ? wait / 1000 : 0);
+        }
+        out.println();
+    }
+}
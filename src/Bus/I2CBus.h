@@ -0,0 +1,123 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// --- I2C Clock Profiles ---
+// Every transaction is tagged with the device it talks to. The bus is
+// switched to that device's profile on entry (only when it differs from the
+// current clock) and the time the device holds the bus is counted, so the
+// bus utilization can be read back with "i2c" over serial. Held time
+// includes conversion waits inside a driver call; nothing else can use the
+// bus meanwhile, so it is counted as busy.
+//
+// Profile = min(what the part is rated for, DLS_I2C_MAX_HZ). The cap stays
+// at 400 kHz by default: breakout pull-ups (4.7-10k) are too weak for clean
+// Fm+ edges and parts rated for Fm only may misread faster traffic meant for
+// others. Raise it with -DDLS_I2C_MAX_HZ=1000000 on a short, stiff bus.
+
+#ifndef DLS_I2C_MAX_HZ
+#define DLS_I2C_MAX_HZ 400000UL
+#endif
+
+// SSD1306/SH1106 are specified for 400 kHz, but the common modules run a
+// full-frame flush at 1 MHz Fm+ (~10 ms instead of ~25 ms)
+#ifndef DLS_I2C_OLED_HZ
+#define DLS_I2C_OLED_HZ 1000000UL
+#endif
+
+// Probing and anything untagged
+#ifndef DLS_I2C_DEFAULT_HZ
+#define DLS_I2C_DEFAULT_HZ 100000UL
+#endif
+
+// --- Fault Handling ---
+// Every Wire transfer gives up after DLS_I2C_TIMEOUT_MS. A failed
+// transaction checks the lines; a slave holding SDA low is freed with up to
+// 9 SCL pulses and a STOP. After DLS_I2C_DEGRADE_FAILS failures in a row the
+// device is degraded: callers skip it and re-probe it with exponential
+// backoff. So a dead part costs at most DLS_I2C_DEGRADE_FAILS timed-out
+// transactions before the loop stops waiting for it.
+#ifndef DLS_I2C_TIMEOUT_MS
+#define DLS_I2C_TIMEOUT_MS 25
+#endif
+
+#define DLS_I2C_DEGRADE_FAILS 3
+#define DLS_I2C_BACKOFF_BASE_MS 5000UL
+#define DLS_I2C_BACKOFF_MAX_MS 600000UL
+
+enum I2CDevice : uint8_t {
+    I2C_DEV_DEFAULT,
+    I2C_DEV_OLED,
+    I2C_DEV_BME680,
+    I2C_DEV_BME280,
+    I2C_DEV_BMP280,
+    I2C_DEV_SHTC3,
+    I2C_DEV_SHT3X,
+    I2C_DEV_VEML6075,
+    I2C_DEV_COUNT
+};
+
+class I2CBus {
+public:
+    static void begin(TwoWire &wire, int sda, int scl);
+    static TwoWire* wire() { return _wire; }
+
+    static uint32_t clockFor(I2CDevice dev);
+
+    // Nested acquires (a driver calling another tagged helper) keep the
+    // outer device and are not counted twice
+    static void acquire(I2CDevice dev);
+    static void release();
+
+    // ready(): healthy, or degraded with its re-probe due (the caller
+    // re-probes, then reports the result). report() feeds the degrade logic.
+    static bool ready(I2CDevice dev);
+    static bool degraded(I2CDevice dev) { return _health[dev].degraded; }
+    static void report(I2CDevice dev, bool ok);
+
+    static bool ping(uint8_t addr); // Address-only write, true on ACK
+    static bool checkLines();       // Recovers a stuck bus; true if idle high
+
+    static void resetStats();
+    static void printStatus(Print &out);
+
+private:
+    struct Stats {
+        uint64_t heldUs;
+        uint32_t transactions;
+        uint32_t failures;
+    };
+
+    struct Health {
+        uint8_t fails;         // In a row
+        uint8_t backoffLevel;
+        bool degraded;
+        unsigned long retryAt; // millis()
+    };
+
+    static bool recover();
+
+    static TwoWire* _wire;
+    static int _sda;
+    static int _scl;
+    static uint32_t _recoveries;
+    static Health _health[I2C_DEV_COUNT];
+    static uint32_t _clock;
+    static I2CDevice _owner;
+    static uint8_t _depth;
+    static uint64_t _acquiredUs;
+    static uint64_t _windowStartUs;
+    static uint32_t _switches;
+    static Stats _stats[I2C_DEV_COUNT];
+};
+
+class I2CTransaction {
+public:
+    explicit I2CTransaction(I2CDevice dev) { I2CBus::acquire(dev); }
+    ~I2CTransaction() { I2CBus::release(); }
+};
+
+#define DLS_I2C_CONCAT_(a, b) a##b
+#define DLS_I2C_CONCAT(a, b) DLS_I2C_CONCAT_(a, b)
+#define DLS_I2C_SCOPE(dev) I2CTransaction DLS_I2C_CONCAT(_i2cTx, __LINE__)(dev)
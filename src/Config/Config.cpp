@@ -1,114 +1,231 @@
 #include "Config.h"
 #include <ArduinoJson.h>
+#include "Log/Log.h"
 
 Config::Config() {
     _ssid = "WIFI_SSID_GIRIN";
     _pass = "WIFI_SIFRE_GIRIN";
+    _altNetCount = 0;
     _apiKey = "API_KEY";
     _stationId = "STATION_ID";
+    _otaUrl = "";
     _lat = 0.0;
     _lon = 0.0;
+    _altitude = 0.0;
     _intervalMin = 30; // Default 30 mins
+    _gasIntervalSec = 300; // One heated gas reading per 5 mins
     _isDeepSleepEnabled = false;
+    _eventUploads = true;
+    _sensorGating = false; // Costs a boot+ready delay per sample and resets the BME680 heater state
+    _relay = "off";
+    _relayPeer = "";
+    _relayPeers = "";
+    _mqttHost = "";
+    _mqttPort = 1883;
+    _mqttUser = "";
+    _mqttPass = "";
+    _mqttBatch = 1;
 }
 
 void Config::begin() {
     _prefs.begin("dls-config", false);
     load();
+    registerCommands();
 }
 
 void Config::load() {
     _ssid = _prefs.getString("ssid", _ssid);
     _pass = _prefs.getString("pass", _pass);
+    JsonDocument nets;
+    if (!deserializeJson(nets, _prefs.getString("nets", "[]"))) loadNetworks(nets.as<JsonArrayConst>());
     _apiKey = _prefs.getString("api", _apiKey);
     _stationId = _prefs.getString("station", _stationId);
+    _otaUrl = _prefs.getString("ota", _otaUrl);
     _lat = _prefs.getFloat("lat", _lat);
     _lon = _prefs.getFloat("lon", _lon);
+    _altitude = _prefs.getFloat("alt", _altitude);
     _intervalMin = _prefs.getInt("interval", _intervalMin);
+    _gasIntervalSec = _prefs.getInt("gasint", _gasIntervalSec);
     _isDeepSleepEnabled = _prefs.getBool("deepsleep", _isDeepSleepEnabled);
+    _eventUploads = _prefs.getBool("events", _eventUploads);
+    _sensorGating = _prefs.getBool("pgate", _sensorGating);
+    _relay = _prefs.getString("relay", _relay);
+    _relayPeer = _prefs.getString("rpeer", _relayPeer);
+    _relayPeers = _prefs.getString("rpeers", _relayPeers);
+    _mqttHost = _prefs.getString("mqhost", _mqttHost);
+    _mqttPort = (uint16_t)_prefs.getUInt("mqport", _mqttPort);
+    _mqttUser = _prefs.getString("mquser", _mqttUser);
+    _mqttPass = _prefs.getString("mqpass", _mqttPass);
+    _mqttBatch = _prefs.getInt("mqbatch", _mqttBatch);
+}
+
+void Config::save() {
+    _prefs.putString("ssid", _ssid);
+    _prefs.putString("pass", _pass);
+    JsonDocument nets;
+    JsonArray list = nets.to<JsonArray>();
+    for (uint8_t i = 0; i < _altNetCount; i++) {
+        JsonObject net = list.add<JsonObject>();
+        net["ssid"] = _altSsid[i];
+        net["pass"] = _altPass[i];
+    }
+    String netsJson;
+    serializeJson(nets, netsJson);
+    _prefs.putString("nets", netsJson);
+    _prefs.putString("api", _apiKey);
+    _prefs.putString("station", _stationId);
+    _prefs.putString("ota", _otaUrl);
+    _prefs.putFloat("lat", _lat);
+    _prefs.putFloat("lon", _lon);
+    _prefs.putFloat("alt", _altitude);
+    _prefs.putInt("interval", _intervalMin);
+    _prefs.putInt("gasint", _gasIntervalSec);
+    _prefs.putBool("deepsleep", _isDeepSleepEnabled);
+    _prefs.putBool("events", _eventUploads);
+    _prefs.putBool("pgate", _sensorGating);
+    _prefs.putString("relay", _relay);
+    _prefs.putString("rpeer", _relayPeer);
+    _prefs.putString("rpeers", _relayPeers);
+    _prefs.putString("mqhost", _mqttHost);
+    _prefs.putUInt("mqport", _mqttPort);
+    _prefs.putString("mquser", _mqttUser);
+    _prefs.putString("mqpass", _mqttPass);
+    _prefs.putInt("mqbatch", _mqttBatch);
+}
+
+void Config::toJson(String &out) const {
+    JsonDocument doc;
+    doc["ssid"] = _ssid;
+    doc["pass"] = _pass;
+    JsonArray nets = doc["networks"].to<JsonArray>();
+    for (uint8_t i = 0; i < _altNetCount; i++) {
+        JsonObject net = nets.add<JsonObject>();
+        net["ssid"] = _altSsid[i];
+        net["pass"] = _altPass[i];
+    }
+    doc["api"] = _apiKey;
+    doc["station"] = _stationId;
+    doc["otaUrl"] = _otaUrl;
+    doc["lat"] = _lat;
+    doc["lon"] = _lon;
+    doc["alt"] = _altitude;
+    doc["interval"] = _intervalMin;
+    doc["gasInterval"] = _gasIntervalSec;
+    doc["deepSleep"] = _isDeepSleepEnabled;
+    doc["eventUploads"] = _eventUploads;
+    doc["sensorPowerGating"] = _sensorGating;
+    doc["relay"] = _relay;
+    doc["relayPeer"] = _relayPeer;
+    doc["relayPeers"] = _relayPeers;
+    doc["mqttHost"] = _mqttHost;
+    doc["mqttPort"] = _mqttPort;
+    doc["mqttUser"] = _mqttUser;
+    doc["mqttPass"] = _mqttPass;
+    doc["mqttBatch"] = _mqttBatch;
+
+    serializeJson(doc, out);
+}
+
+bool Config::fromJson(const String &json) {
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, json);
+    if (error) return false;
+
+    if (doc.containsKey("ssid")) _ssid = doc["ssid"].as<String>();
+    if (doc.containsKey("pass")) _pass = doc["pass"].as<String>();
+    if (doc.containsKey("networks")) loadNetworks(doc["networks"].as<JsonArrayConst>());
+    if (doc.containsKey("api")) _apiKey = doc["api"].as<String>();
+    if (doc.containsKey("station")) _stationId = doc["station"].as<String>();
+    if (doc.containsKey("otaUrl")) _otaUrl = doc["otaUrl"].as<String>();
+    if (doc.containsKey("lat")) _lat = doc["lat"].as<float>();
+    if (doc.containsKey("lon")) _lon = doc["lon"].as<float>();
+    if (doc.containsKey("alt")) _altitude = doc["alt"].as<float>();
+    if (doc.containsKey("interval")) _intervalMin = doc["interval"].as<int>();
+    if (doc.containsKey("gasInterval")) _gasIntervalSec = doc["gasInterval"].as<int>();
+    if (doc.containsKey("deepSleep")) _isDeepSleepEnabled = doc["deepSleep"].as<bool>();
+    if (doc.containsKey("eventUploads")) _eventUploads = doc["eventUploads"].as<bool>();
+    if (doc.containsKey("sensorPowerGating")) _sensorGating = doc["sensorPowerGating"].as<bool>();
+    if (doc.containsKey("relay")) _relay = doc["relay"].as<String>();
+    if (doc.containsKey("relayPeer")) _relayPeer = doc["relayPeer"].as<String>();
+    if (doc.containsKey("relayPeers")) _relayPeers = doc["relayPeers"].as<String>();
+    if (doc.containsKey("mqttHost")) _mqttHost = doc["mqttHost"].as<String>();
+    if (doc.containsKey("mqttPort")) _mqttPort = doc["mqttPort"].as<uint16_t>();
+    if (doc.containsKey("mqttUser")) _mqttUser = doc["mqttUser"].as<String>();
+    if (doc.containsKey("mqttPass")) _mqttPass = doc["mqttPass"].as<String>();
+    if (doc.containsKey("mqttBatch")) _mqttBatch = doc["mqttBatch"].as<int>();
+    return true;
+}
+
+void Config::loadNetworks(JsonArrayConst list) {
+    _altNetCount = 0;
+    for (JsonObjectConst net : list) {
+        if (_altNetCount >= CONFIG_MAX_NETWORKS - 1) break;
+        const char* ssid = net["ssid"] | "";
+        if (!*ssid) continue;
+        _altSsid[_altNetCount] = ssid;
+        _altPass[_altNetCount] = net["pass"] | "";
+        _altNetCount++;
+    }
 }
 
 void Config::checkSerialCommands() {
-    if (Serial.available()) {
-        String cmd = Serial.readStringUntil('\n');
-        cmd.trim();
-        
-        // --- JSON BASED CONFIG ---
-        if (cmd.equals("GET_CONFIG")) {
-            JsonDocument doc;
-            doc["ssid"] = _ssid;
-            doc["pass"] = _pass;
-            doc["api"] = _apiKey;
-            doc["station"] = _stationId;
-            doc["lat"] = _lat;
-            doc["lon"] = _lon;
-            doc["interval"] = _intervalMin;
-            doc["deepSleep"] = _isDeepSleepEnabled;
-            
-            String response;
-            serializeJson(doc, response);
-            Serial.println(response);
-        }
-        else if (cmd.startsWith("SET_CONFIG ")) {
-            String jsonStr = cmd.substring(11);
-            JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, jsonStr);
-            
-            if (!error) {
-                if (doc.containsKey("ssid")) _ssid = doc["ssid"].as<String>();
-                if (doc.containsKey("pass")) _pass = doc["pass"].as<String>();
-                if (doc.containsKey("api")) _apiKey = doc["api"].as<String>();
-                if (doc.containsKey("station")) _stationId = doc["station"].as<String>();
-                if (doc.containsKey("lat")) _lat = doc["lat"].as<float>();
-                if (doc.containsKey("lon")) _lon = doc["lon"].as<float>();
-                if (doc.containsKey("interval")) _intervalMin = doc["interval"].as<int>();
-                if (doc.containsKey("deepSleep")) _isDeepSleepEnabled = doc["deepSleep"].as<bool>();
-                
-                // Save all
-                _prefs.putString("ssid", _ssid);
-                _prefs.putString("pass", _pass);
-                _prefs.putString("api", _apiKey);
-                _prefs.putString("station", _stationId);
-                _prefs.putFloat("lat", _lat);
-                _prefs.putFloat("lon", _lon);
-                _prefs.putInt("interval", _intervalMin);
-                _prefs.putBool("deepsleep", _isDeepSleepEnabled);
-                
-                Serial.println("CONFIG_SAVED");
-                delay(500);
-                ESP.restart();
-            } else {
-                Serial.println("JSON_ERROR");
-            }
-        }
-        // --- LEGACY COMMANDS (Optional fallback) ---
-        else if (cmd.startsWith("ssid=")) {
-            // ... (keep legacy if desired, but user wants JSON now) ...
-            // Let's keep basics for simple manual terminal usage
-            String val = cmd.substring(5);
-            _prefs.putString("ssid", val);
-            _ssid = val;
-            Serial.println("SSID Kaydedildi: " + val);
-        } 
-        // ... (Simplified legacy blocks or remove if strictly JSON preferred) ...
-        // Keeping "restart" command for utility
-        else if (cmd.equalsIgnoreCase("restart")) {
-            Serial.println("Yeniden baslatiliyor...");
-            delay(1000);
+    _commands.poll();
+}
+
+void Config::registerCommands() {
+    _commands.begin(Serial);
+
+    // --- JSON BASED CONFIG ---
+    _commands.add("GET_CONFIG", [this](const char*) {
+        String response;
+        toJson(response);
+        Serial.println(response);
+    }, "Ayarlari JSON olarak yaz");
+
+    _commands.add("SET_CONFIG", [this](const char* args) {
+        if (fromJson(args)) {
+            save();
+            Serial.println("CONFIG_SAVED");
+            Log::flush();
             ESP.restart();
-        } 
-        else if (cmd.equalsIgnoreCase("info")) {
-            info();
+        } else {
+            Serial.println("JSON_ERROR");
         }
-    }
+    }, "SET_CONFIG {json}: kaydet ve yeniden baslat");
+
+    // --- LEGACY COMMANDS (simple manual terminal usage) ---
+    _commands.add("ssid=", [this](const char* args) {
+        _ssid = args;
+        _prefs.putString("ssid", _ssid);
+        Serial.print("SSID Kaydedildi: "); Serial.println(args);
+    }, "ssid=<ad>: SSID kaydet");
+
+    _commands.add("restart", [](const char*) {
+        Serial.println("Yeniden baslatiliyor...");
+        Log::flush();
+        ESP.restart();
+    }, "Cihazi yeniden baslat");
+
+    _commands.add("info", [this](const char*) { info(); }, "Mevcut ayarlar");
+
+    _commands.add("help", [this](const char*) { _commands.printHelp(Serial); }, "Bu liste");
 }
 
 void Config::info() {
     Serial.println("--- Mevcut Ayarlar ---");
     Serial.println("SSID: " + _ssid);
+    for (uint8_t i = 0; i < _altNetCount; i++) Serial.println("SSID " + String(i + 2) + ": " + _altSsid[i]);
     Serial.println("Station: " + _stationId);
+    Serial.println("OTA URL: " + (_otaUrl.length() ? _otaUrl : String("-")));
     Serial.println("Lat: " + String(_lat, 6));
     Serial.println("Lon: " + String(_lon, 6));
+    Serial.println("Alt: " + String(_altitude, 1) + " m");
     Serial.println("Interval: " + String(_intervalMin) + " dk");
+    Serial.println("Gas Interval: " + String(_gasIntervalSec) + " sn");
     Serial.println("Deep Sleep: " + String(_isDeepSleepEnabled ? "Aktif" : "Pasif"));
+    Serial.println("Event Upload: " + String(_eventUploads ? "Aktif" : "Pasif"));
+    Serial.println("Sensor Power Gating: " + String(_sensorGating ? "Aktif" : "Pasif"));
+    Serial.println("MQTT: " + (_mqttHost.length() ? _mqttHost + ":" + String(_mqttPort) + " x" + String(_mqttBatch) : String("-")));
+    Serial.println("Relay: " + _relay + (isRelayNode() ? " -> " + _relayPeer
+                                        : isRelayGateway() ? " <- " + _relayPeers : String("")));
 }
@@ -2,36 +2,87 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include <ArduinoJson.h>
+#include "SerialCommands.h"
+
+#define CONFIG_MAX_NETWORKS 4 // Primary ssid/pass + 3 alternates
 
 class Config {
 public:
     Config();
     void begin();
-    void checkSerialCommands();
+    void checkSerialCommands(); // Non-blocking; call every loop
+
+    // Command table shared with other modules (main registers its own)
+    SerialCommands &commands() { return _commands; }
+
+    // JSON (de)serialization used by GET_CONFIG / SET_CONFIG
+    void toJson(String &out) const;
+    bool fromJson(const String &json);
 
     // Getters
-    String getSSID() const { return _ssid; }
-    String getPass() const { return _pass; }
-    String getAPIKey() const { return _apiKey; }
-    String getStationID() const { return _stationId; }
+    const String &getSSID() const { return _ssid; }
+    const String &getPass() const { return _pass; }
+    // Wi-Fi networks for roaming: index 0 is ssid/pass, then the "networks" list
+    uint8_t getNetworkCount() const { return 1 + _altNetCount; }
+    const String &getNetworkSSID(uint8_t i) const { return i == 0 ? _ssid : _altSsid[i - 1]; }
+    const String &getNetworkPass(uint8_t i) const { return i == 0 ? _pass : _altPass[i - 1]; }
+    const String &getAPIKey() const { return _apiKey; }
+    const String &getStationID() const { return _stationId; }
+    const String &getOtaUrl() const { return _otaUrl; } // Firmware folder; empty = OTA off
     float getLat() const { return _lat; }
     float getLon() const { return _lon; }
+    float getAltitude() const { return _altitude; } // Meters above sea level
     int getInterval() const { return _intervalMin; }
+    int getGasInterval() const { return _gasIntervalSec; } // BME680 heater period (s)
     bool isDeepSleepEnabled() const { return _isDeepSleepEnabled; }
+    bool isEventUploadEnabled() const { return _eventUploads; } // Extra uploads on rapid changes
+    bool isSensorGatingEnabled() const { return _sensorGating; } // Sensor rail off between samples
+    // ESP-NOW relay: "node" uploads through the gateway at getRelayPeer()
+    bool isRelayNode() const { return _relay == "node"; }
+    bool isRelayGateway() const { return _relay == "gateway"; }
+    const String &getRelayPeer() const { return _relayPeer; } // Gateway MAC
+    const String &getRelayPeers() const { return _relayPeers; } // Gateway: "MAC=station,..." allowed to relay
+    // MQTT output; empty host = off
+    const String &getMqttHost() const { return _mqttHost; }
+    uint16_t getMqttPort() const { return _mqttPort; }
+    const String &getMqttUser() const { return _mqttUser; }
+    const String &getMqttPass() const { return _mqttPass; }
+    int getMqttBatch() const { return _mqttBatch; } // Samples per message
 
 private:
     Preferences _prefs;
+    SerialCommands _commands;
     
     // Vars
     String _ssid;
     String _pass;
+    String _altSsid[CONFIG_MAX_NETWORKS - 1];
+    String _altPass[CONFIG_MAX_NETWORKS - 1];
+    uint8_t _altNetCount;
     String _apiKey;
     String _stationId;
+    String _otaUrl;
     float _lat;
     float _lon;
+    float _altitude;
     int _intervalMin;
+    int _gasIntervalSec;
     bool _isDeepSleepEnabled;
+    bool _eventUploads;
+    bool _sensorGating;
+    String _relay;     // "off", "node" or "gateway"
+    String _relayPeer;
+    String _relayPeers;
+    String _mqttHost;
+    uint16_t _mqttPort;
+    String _mqttUser;
+    String _mqttPass;
+    int _mqttBatch;
 
     void load();
+    void loadNetworks(JsonArrayConst list);
+    void save();
     void info();
+    void registerCommands();
 };
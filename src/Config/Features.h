@@ -0,0 +1,145 @@
+#pragma once
+
+// --- Compile-Time Feature Selection ---
+// Every driver and subsystem below is enabled by default, except where a
+// target default below says otherwise. A variant can turn off hardware it
+// never carries in its variant.h, or a build can override a flag with
+// build_flags (e.g. -DDLS_SENSOR_BME680=0). Disabled drivers are not
+// included, instantiated or probed, so the library code drops out of the image.
+
+#include "variant.h"
+
+// --- Target Defaults ---
+// ESP32-C3: no FPU and the least RAM of the supported chips. Super Mini
+// boards carry an SSD1306, and the tracing, archive and dashboard extras are
+// sized for the ESP32/S3, so they stay out of the C3 image unless turned back on.
+#if CONFIG_IDF_TARGET_ESP32C3
+#ifndef DLS_METRICS_FIXED_POINT
+#define DLS_METRICS_FIXED_POINT 1
+#endif
+#ifndef DLS_DISPLAY_SH1106
+#define DLS_DISPLAY_SH1106 0
+#endif
+#ifndef DLS_FEATURE_TRACE
+#define DLS_FEATURE_TRACE 0
+#endif
+#ifndef DLS_FEATURE_ARCHIVE
+#define DLS_FEATURE_ARCHIVE 0
+#endif
+#ifndef DLS_FEATURE_DASHBOARD
+#define DLS_FEATURE_DASHBOARD 0
+#endif
+#endif
+
+// --- Air Sensors ---
+#ifndef DLS_SENSOR_BME680
+#define DLS_SENSOR_BME680 1
+#endif
+
+#ifndef DLS_SENSOR_BME280
+#define DLS_SENSOR_BME280 1
+#endif
+
+#ifndef DLS_SENSOR_BMP280
+#define DLS_SENSOR_BMP280 1
+#endif
+
+#ifndef DLS_SENSOR_SHTC3
+#define DLS_SENSOR_SHTC3 1
+#endif
+
+#ifndef DLS_SENSOR_SHT3X
+#define DLS_SENSOR_SHT3X 1
+#endif
+
+// --- Rain Sensors ---
+// No rain gauge driver exists yet; rainRate stays at the -1.0 placeholder.
+// Enables the rain onset event rule once one does.
+#ifndef DLS_SENSOR_RAIN
+#define DLS_SENSOR_RAIN 0
+#endif
+
+// --- Light Sensors ---
+#ifndef DLS_SENSOR_VEML6075
+#define DLS_SENSOR_VEML6075 1
+#endif
+
+// --- Displays ---
+#ifndef DLS_DISPLAY_SSD1306
+#define DLS_DISPLAY_SSD1306 1
+#endif
+
+#ifndef DLS_DISPLAY_SH1106
+#define DLS_DISPLAY_SH1106 1
+#endif
+
+// In-memory framebuffer used when no OLED answers (benchmarks, bring-up).
+#ifndef DLS_DISPLAY_HEADLESS
+#define DLS_DISPLAY_HEADLESS 0
+#endif
+
+// --- Subsystems ---
+#ifndef DLS_FEATURE_MDNS
+#define DLS_FEATURE_MDNS 1
+#endif
+
+#ifndef DLS_FEATURE_WEBSERVER
+#define DLS_FEATURE_WEBSERVER 1
+#endif
+
+// Gzip dashboard at http://<node>/ (see web/ and src/Web); needs the web server.
+#ifndef DLS_FEATURE_DASHBOARD
+#define DLS_FEATURE_DASHBOARD DLS_FEATURE_WEBSERVER
+#endif
+
+// HTTP pull updates (see src/Ota); also needs "otaUrl" in the config.
+#ifndef DLS_FEATURE_OTA
+#define DLS_FEATURE_OTA 1
+#endif
+
+// Scoped trace spans around blocking calls (see src/Trace); exported as
+// Chrome trace JSON. Costs ~4 KB of RAM for the event ring.
+#ifndef DLS_FEATURE_TRACE
+#define DLS_FEATURE_TRACE 1
+#endif
+
+// Compressed long-term history on LittleFS (see src/Archive); uses up to
+// 512 KB of the data partition.
+#ifndef DLS_FEATURE_ARCHIVE
+#define DLS_FEATURE_ARCHIVE 1
+#endif
+
+// ESP-NOW relay for nodes out of Wi-Fi range (see src/Relay); the role is
+// chosen with "relay" in the config.
+#ifndef DLS_FEATURE_RELAY
+#define DLS_FEATURE_RELAY 1
+#endif
+
+// MQTT output next to the DLSWeather uploader (see src/Mqtt); also needs
+// "mqttHost" in the config.
+#ifndef DLS_FEATURE_MQTT
+#define DLS_FEATURE_MQTT 1
+#endif
+
+// Per-cycle energy accounting and battery-life estimate (see src/Energy).
+#ifndef DLS_FEATURE_ENERGY
+#define DLS_FEATURE_ENERGY 1
+#endif
+
+// Diagnostic log verbosity (see src/Log): 0 none, 1 error, 2 warn, 3 info,
+// 4 debug. Lines above the level are compiled out of the image.
+#ifndef DLS_LOG_LEVEL
+#define DLS_LOG_LEVEL 3
+#endif
+
+// Integer-only derived metrics (dew point, heat index, ...) for targets
+// without a hardware FPU; see src/Metrics.
+#ifndef DLS_METRICS_FIXED_POINT
+#define DLS_METRICS_FIXED_POINT 0
+#endif
+
+// On-device microbenchmarks (see src/Bench). Off in release images; the
+// *_bench environments enable it together with the malloc wrappers.
+#ifndef DLS_FEATURE_BENCH
+#define DLS_FEATURE_BENCH 0
+#endif
@@ -0,0 +1,78 @@
+#include "SerialCommands.h"
+
+bool SerialCommands::add(const char* name, Handler handler, const char* help) {
+    if (_count >= SERIAL_CMD_MAX) return false;
+    _commands[_count].name = name;
+    _commands[_count].help = help;
+    _commands[_count].handler = handler;
+    _count++;
+    return true;
+}
+
+void SerialCommands::poll() {
+    if (!_io) return;
+    int budget = SERIAL_CMD_POLL_BUDGET;
+    while (budget-- > 0 && _io->available() > 0) {
+        int c = _io->read();
+        if (c < 0) break;
+        feed((char)c);
+    }
+}
+
+void SerialCommands::feed(char c) {
+    if (c == '\n' || c == '\r') {
+        if (_overflow) {
+            if (_io) _io->println("LINE_TOO_LONG");
+        } else if (_len > 0) {
+            _line[_len] = '\0';
+            dispatch(_line);
+        }
+        _len = 0;
+        _overflow = false;
+        return;
+    }
+
+    if (_overflow) return; // Drop the rest of an oversized line
+    if (_len >= SERIAL_CMD_LINE_MAX - 1) {
+        _overflow = true;
+        return;
+    }
+    _line[_len++] = c;
+}
+
+bool SerialCommands::dispatch(char* line) {
+    // Trim
+    while (*line == ' ' || *line == '\t') line++;
+    size_t n = strlen(line);
+    while (n > 0 && (line[n - 1] == ' ' || line[n - 1] == '\t')) line[--n] = '\0';
+    if (n == 0) return false;
+
+    for (uint8_t i = 0; i < _count; i++) {
+        const Command &cmd = _commands[i];
+        size_t len = strlen(cmd.name);
+        if (strncasecmp(line, cmd.name, len) != 0) continue;
+
+        const char* args;
+        if (cmd.name[len - 1] == '=') {
+            args = line + len;                   // "ssid=MyNet"
+        } else if (line[len] == '\0') {
+            args = line + len;                   // "info"
+        } else if (line[len] == ' ') {
+            args = line + len + 1;               // "SET_CONFIG {...}"
+            while (*args == ' ') args++;
+        } else {
+            continue;                            // Longer word, e.g. "infox"
+        }
+
+        cmd.handler(args);
+        return true;
+    }
+    return false;
+}
+
+void SerialCommands::printHelp(Print &out) const {
+    out.println("--- Komutlar ---");
+    for (uint8_t i = 0; i < _count; i++) {
+        out.printf("%-12s %s\n", _commands[i].name, _commands[i].help ? _commands[i].help : "");
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+// Non-blocking serial command processor.
+// Bytes are assembled into a fixed line buffer as they arrive; a complete
+// line (\n or \r) is matched against a command table and dispatched. A
+// partial line never blocks the caller, and no heap Strings are built.
+//
+// Matching is case-insensitive on the first word. A name ending in '='
+// (e.g. "ssid=") matches as a prefix and receives the rest as arguments.
+
+#define SERIAL_CMD_LINE_MAX 1024
+#define SERIAL_CMD_MAX 24
+#define SERIAL_CMD_POLL_BUDGET 256 // Max bytes consumed per poll()
+
+class SerialCommands {
+public:
+    typedef std::function<void(const char* args)> Handler;
+
+    void begin(Stream &io) { _io = &io; }
+
+    // name and help must be string literals (stored by pointer)
+    bool add(const char* name, Handler handler, const char* help = nullptr);
+
+    // Drain available input without waiting; dispatches complete lines.
+    void poll();
+
+    // Feed a single byte (poll() uses this; also handy for replaying input).
+    void feed(char c);
+
+    // Match and run one complete line. Returns false if no command matched.
+    bool dispatch(char* line);
+
+    void printHelp(Print &out) const;
+
+private:
+    struct Command {
+        const char* name;
+        const char* help;
+        Handler handler;
+    };
+
+    Stream* _io = nullptr;
+    Command _commands[SERIAL_CMD_MAX];
+    uint8_t _count = 0;
+
+    char _line[SERIAL_CMD_LINE_MAX];
+    size_t _len = 0;
+    bool _overflow = false;
+};
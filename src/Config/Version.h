@@ -0,0 +1,5 @@
+#pragma once
+
+// Firmware version. copy_firmware.py reads this line for the web installer
+// manifests, and the OTA updater compares it with manifest_update.json.
+#define DLS_FW_VERSION "1.0.2"
@@ -1,41 +1,114 @@
 #include "Display.h"
+#include "Trace/Trace.h"
+#include "Energy/Energy.h"
+#include "Bus/I2CBus.h"
+#include "Log/Log.h"
+#include "Memory/Arena.h"
+
+#define OLED_ADDR 0x3C
+#define CHAR_W 6 // Glyph advance at text size 1
+
+// --- Page Layout ---
+// Static text of every page. Labels are baked into the cached layer; values
+// are drawn right after their label on each frame.
+struct FieldLayout {
+    int16_t y;
+    const char* label;
+};
+
+struct PageLayout {
+    const char* title;
+    uint8_t count;
+    FieldLayout fields[5];
+};
+
+// Order matches DisplayPage
+static const PageLayout PAGE_LAYOUT[PAGE_COUNT] = {
+    { "NETWORK",    2, { {15, "SSID: "}, {28, "IP:   "} } },
+    { "WEATHER",    5, { {10, "Temp: "}, {19, "Hum:  "}, {28, "Dew:  "}, {37, "Pres: "}, {46, "IAQ:  "} } },
+    { "RAIN",       2, { {15, "Rate:  "}, {30, "Daily: "} } },
+    { "WIND",       2, { {15, "Speed: "}, {30, "Dir:   "} } },
+    { "UV / LIGHT", 2, { {15, "UV Index: "}, {30, "Light:    "} } },
+};
+
+// Trend graphs sit right of the values: 40 columns at x 88..127. The AIR
+// page stacks two beside its five rows; the two-row pages use the free
+// band below their values.
+#define TREND_X 88
+#define TREND_AIR_H 20
+#define TREND_LOW_H 14
+#define TREND_TEMP_Y 9
+#define TREND_PRES_Y 32
+#define TREND_LOW_Y 39
+
+// Page layer cache, only reserved once a panel answers
+static Arena s_layerArena("display", PAGE_COUNT * SCREEN_BUFFER_SIZE);
+
+static void copyText(char* dst, size_t size, const char* src) {
+    strncpy(dst, src ? src : "", size - 1);
+    dst[size - 1] = '\0';
+}
 
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
-#define OLED_RESET -1
-
-Display::Display() {
+Display::Display()
+    : _tempTrend(TREND_AIR_H), _presTrend(TREND_AIR_H),
+      _rainTrend(TREND_LOW_H), _windTrend(TREND_LOW_H), _uvTrend(TREND_LOW_H) {
     _type = DISP_NONE;
-    _ssd1306 = nullptr;
-    _sh1106 = nullptr;
+    _backend = nullptr;
+    _gfx = nullptr;
 }
 
 void Display::begin(TwoWire *wire) {
-    Serial.println("\n[Display] Scanning...");
+    LOG_I("Display", "Scanning...");
     
-    _ssd1306 = new Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT, wire, OLED_RESET);
-    if (_ssd1306->begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+#if DLS_DISPLAY_SSD1306
+    _backend = new SSD1306Backend(wire, OLED_ADDR);
+    if (_backend->begin()) {
         _type = DISP_SSD1306;
-        Serial.println("[Display] SSD1306 (0x3C) Found!");
-        _ssd1306->clearDisplay();
-        _ssd1306->setTextColor(SSD1306_WHITE);
-        _ssd1306->display();
-        return;
-    } 
-    delete _ssd1306; _ssd1306 = nullptr;
-
-    _sh1106 = new Adafruit_SH1106G(SCREEN_WIDTH, SCREEN_HEIGHT, wire, OLED_RESET);
-    if (_sh1106->begin(0x3C, true)) {
-        _type = DISP_SH1106;
-        Serial.println("[Display] SH1106 (0x3C) Found!");
-        _sh1106->clearDisplay();
-        _sh1106->setTextColor(SH110X_WHITE);
-        _sh1106->display();
+        LOG_I("Display", "SSD1306 (0x3C) Found!");
+    } else {
+        delete _backend; _backend = nullptr;
+    }
+#endif
+
+#if DLS_DISPLAY_SH1106
+    if (_type == DISP_NONE) {
+        _backend = new SH1106Backend(wire, OLED_ADDR);
+        if (_backend->begin()) {
+            _type = DISP_SH1106;
+            LOG_I("Display", "SH1106 (0x3C) Found!");
+        } else {
+            delete _backend; _backend = nullptr;
+        }
+    }
+#endif
+
+#if DLS_DISPLAY_HEADLESS
+    if (_type == DISP_NONE) {
+        _backend = new HeadlessBackend();
+        _backend->begin();
+        _type = DISP_HEADLESS;
+        LOG_I("Display", "No OLED, using headless framebuffer.");
+    }
+#endif
+
+    if (_type == DISP_NONE) {
+        LOG_W("Display", "NO DISPLAY FOUND.");
         return;
     }
-    delete _sh1106; _sh1106 = nullptr;
+    _gfx = &_backend->gfx();
+    setPowered(_type != DISP_HEADLESS);
+
+    uint8_t* layers = s_layerArena.alloc<uint8_t>(PAGE_COUNT * SCREEN_BUFFER_SIZE);
+    for (uint8_t p = 0; layers && p < PAGE_COUNT; p++) _layers[p] = layers + p * SCREEN_BUFFER_SIZE;
+}
 
-    Serial.println("[Display] NO DISPLAY FOUND.");
+void Display::setPowered(bool on) {
+    if (on == _powered) return;
+    _powered = on;
+#if DLS_FEATURE_ENERGY
+    if (on) Energy::start(ENERGY_DISPLAY);
+    else Energy::stop(ENERGY_DISPLAY);
+#endif
 }
 
 void Display::update() {
@@ -46,12 +119,36 @@ void Display::update() {
         if (next >= PAGE_COUNT) next = 0;
         _currentPage = (DisplayPage)next;
         _lastSwitchTime = millis();
+        _dirty = true;
     }
 
+    // Nothing changed since the last flush: skip the 1 KB I2C transfer
+    if (!_dirty) return;
+
+    renderPage(_currentPage);
+    display();
+    _dirty = false;
+}
+
+void Display::renderPage(DisplayPage page) {
+    if (_type == DISP_NONE || page >= PAGE_COUNT) return;
+
+    // Static layer: render once, then blit. clear() also resets the
+    // driver's dirty window (SH110X only sends the touched region).
+    uint8_t* fb = _backend->buffer();
     clear();
-    
-    // Page Order: NET -> AIR -> RAIN -> WIND -> LIGHT
-    switch (_currentPage) {
+    if (!_layers[page]) {
+        drawStaticLayer(page); // Out of memory: no cache, draw it every frame
+    } else if (!_layerReady[page]) {
+        drawStaticLayer(page);
+        memcpy(_layers[page], fb, SCREEN_BUFFER_SIZE);
+        _layerReady[page] = true;
+    } else {
+        memcpy(fb, _layers[page], SCREEN_BUFFER_SIZE);
+    }
+
+    // Dynamic fields. Page Order: NET -> AIR -> RAIN -> WIND -> LIGHT
+    switch (page) {
         case PAGE_NET:   drawNetPage(); break;
         case PAGE_AIR:   drawAirPage(); break;
         case PAGE_RAIN:  drawRainPage(); break;
@@ -61,51 +158,86 @@ void Display::update() {
     }
 
     drawFooter();
-    display();
 }
 
 // --- Data Setters ---
-void Display::setAirData(float temp, float hum, float pres, float gas) {
+// Each setter only marks the frame dirty when a value or a trend graph
+// actually changed, so the loop can call them every iteration without
+// forcing a redraw.
+void Display::setAirData(float temp, float hum, float pres, float iaq, uint8_t iaqAccuracy, float dew) {
+    unsigned long now = millis();
+    if (temp != -999.0 ? _tempTrend.add(temp, now) : _tempTrend.advance(now)) _dirty = true;
+    if (pres != -999.0 ? _presTrend.add(pres, now) : _presTrend.advance(now)) _dirty = true;
+    if (_airData.valid && _airData.temp == temp && _airData.hum == hum && _airData.pres == pres &&
+        _airData.iaq == iaq && _airData.iaqAccuracy == iaqAccuracy && _airData.dew == dew) return;
     _airData.temp = temp;
     _airData.hum = hum;
     _airData.pres = pres;
-    _airData.gas = gas;
+    _airData.iaq = iaq;
+    _airData.iaqAccuracy = iaqAccuracy;
+    _airData.dew = dew;
     _airData.valid = true;
+    _dirty = true;
 }
 
 void Display::setWindData(float speed, float dir) {
+    unsigned long now = millis();
+    if (speed != -1.0 ? _windTrend.add(speed, now) : _windTrend.advance(now)) _dirty = true;
+    if (_windData.valid && _windData.speed == speed && _windData.dir == dir) return;
     _windData.speed = speed;
     _windData.dir = dir;
     _windData.valid = true;
+    _dirty = true;
 }
 
 void Display::setRainData(float rate, float daily) {
+    unsigned long now = millis();
+    if (rate != -1.0 ? _rainTrend.add(rate, now) : _rainTrend.advance(now)) _dirty = true;
+    if (_rainData.valid && _rainData.rate == rate && _rainData.daily == daily) return;
     _rainData.rate = rate;
     _rainData.daily = daily;
     _rainData.valid = true;
+    _dirty = true;
 }
 
 void Display::setLightData(float uv, float lux) {
+    unsigned long now = millis();
+    if (uv != -1.0 ? _uvTrend.add(uv, now) : _uvTrend.advance(now)) _dirty = true;
+    if (_lightData.valid && _lightData.uv == uv && _lightData.lux == lux) return;
     _lightData.uv = uv;
     _lightData.lux = lux;
     _lightData.valid = true;
+    _dirty = true;
 }
 
-void Display::setNetworkInfo(String ip, String ssid, String status, bool connected) {
-    _netData.ip = ip;
-    _netData.ssid = ssid;
-    _netData.status = status;
+void Display::setNetworkInfo(const char* ip, const char* ssid, const char* status, bool connected) {
+    if (_netData.connected == connected && strcmp(_netData.ip, ip) == 0 &&
+        strcmp(_netData.ssid, ssid) == 0 && strcmp(_netData.status, status) == 0) return;
+    copyText(_netData.ip, sizeof(_netData.ip), ip);
+    copyText(_netData.ssid, sizeof(_netData.ssid), ssid);
+    copyText(_netData.status, sizeof(_netData.status), status);
     _netData.connected = connected;
+    _dirty = true;
 }
 
 // --- Drawing Pages ---
 
-// --- Drawing Pages ---
+void Display::drawStaticLayer(DisplayPage page) {
+    const PageLayout &layout = PAGE_LAYOUT[page];
+
+    drawCenteredHeader(layout.title);
+    for (uint8_t i = 0; i < layout.count; i++) {
+        setCursor(0, layout.fields[i].y);
+        print(layout.fields[i].label);
+    }
 
-void Display::drawCenteredHeader(String title) {
+    // Footer line
+    _gfx->drawLine(0, 54, 128, 54, DISP_WHITE);
+}
+
+void Display::drawCenteredHeader(const char* title) {
     setTextSize(1);
-    int charWidth = 6; // Approx for size 1
-    int textWidth = title.length() * charWidth;
+    int textWidth = strlen(title) * CHAR_W;
     int xStart = (SCREEN_WIDTH - textWidth) / 2;
     if (xStart < 0) xStart = 0;
 
@@ -117,107 +249,73 @@ void Display::drawCenteredHeader(String title) {
     int lineY = 3; // Middle of char height approx
     // Left Line
     if (xStart > 5) {
-        if (_type == DISP_SSD1306) _ssd1306->drawLine(0, lineY, xStart - 3, lineY, SSD1306_WHITE);
-        else if (_type == DISP_SH1106) _sh1106->drawLine(0, lineY, xStart - 3, lineY, SH110X_WHITE);
+        _gfx->drawLine(0, lineY, xStart - 3, lineY, DISP_WHITE);
     }
     // Right Line
     int xEnd = xStart + textWidth;
     if (xEnd < SCREEN_WIDTH - 5) {
-        if (_type == DISP_SSD1306) _ssd1306->drawLine(xEnd + 3, lineY, SCREEN_WIDTH, lineY, SSD1306_WHITE);
-        else if (_type == DISP_SH1106) _sh1106->drawLine(xEnd + 3, lineY, SCREEN_WIDTH, lineY, SH110X_WHITE);
+        _gfx->drawLine(xEnd + 3, lineY, SCREEN_WIDTH, lineY, DISP_WHITE);
     }
 }
 
-void Display::drawNetPage() {
-    drawCenteredHeader("NETWORK");
+void Display::drawField(DisplayPage page, int row, const char* value) {
+    const FieldLayout &field = PAGE_LAYOUT[page].fields[row];
+    setCursor(strlen(field.label) * CHAR_W, field.y);
+    print(value);
+}
 
-    setTextSize(1);
-    setCursor(0, 15);
-    print("SSID: "); println(_netData.ssid);
+void Display::drawValue(DisplayPage page, int row, float value, bool ok, int dec, const char* unit) {
+    char buf[16];
+    if (ok) snprintf(buf, sizeof(buf), "%.*f%s", dec, value, unit);
+    else strcpy(buf, "NaN");
+    drawField(page, row, buf);
+}
 
-    setCursor(0, 28);
-    print("IP:   "); println(_netData.ip);
+void Display::drawTrend(const Sparkline &trend, int y) {
+    trend.blit(_backend->buffer(), TREND_X, y);
+}
+
+void Display::drawNetPage() {
+    drawField(PAGE_NET, 0, _netData.ssid);
+    drawField(PAGE_NET, 1, _netData.ip);
 }
 
 void Display::drawAirPage() {
-    drawCenteredHeader("WEATHER");
-    setTextSize(1);
-    
-    // Temp
-    setCursor(0, 12);
-    print("Temp: ");
-    if (_airData.temp != -999.0) { print(_airData.temp, 1); println(" C"); }
-    else println("NaN");
-
-    // Hum
-    setCursor(0, 22);
-    print("Hum:  ");
-    if (_airData.hum != -999.0) { print(_airData.hum, 0); println(" %"); }
-    else println("NaN");
-
-    // Pres
-    setCursor(0, 32);
-    print("Pres: ");
-    if (_airData.pres != -999.0) { print(_airData.pres, 0); println(" hPa"); }
-    else println("NaN");
-
-    // IAQ / Gas
-    setCursor(0, 42);
-    print("IAQ:  "); // Changed from Gas to IAQ
-    if (_airData.gas != -999.0 && _airData.gas > 0) { print(_airData.gas / 1000.0, 1); println(" kOhm"); }
-    else println("NaN");
+    drawValue(PAGE_AIR, 0, _airData.temp, _airData.temp != -999.0, 1, " C");
+    drawValue(PAGE_AIR, 1, _airData.hum, _airData.hum != -999.0, 0, " %");
+    drawValue(PAGE_AIR, 2, _airData.dew, _airData.dew != -999.0, 1, " C");
+    drawValue(PAGE_AIR, 3, _airData.pres, _airData.pres != -999.0, 0, " hPa");
+    // "?" while the baseline is still being learned (first hour)
+    drawValue(PAGE_AIR, 4, _airData.iaq, _airData.iaq != -999.0, 0, _airData.iaqAccuracy >= 2 ? "" : " ?");
+    drawTrend(_tempTrend, TREND_TEMP_Y);
+    drawTrend(_presTrend, TREND_PRES_Y);
 }
 
 void Display::drawRainPage() {
-    drawCenteredHeader("RAIN");
-    setTextSize(1);
-    
-    setCursor(0, 15);
-    print("Rate:  ");
-    if (_rainData.valid && _rainData.rate != -1.0) { print(_rainData.rate, 1); println(" mm/h"); }
-    else println("NaN");
-
-    setCursor(0, 30);
-    print("Daily: ");
-    if (_rainData.valid && _rainData.daily != -1.0) { print(_rainData.daily, 1); println(" mm"); }
-    else println("NaN");
+    drawValue(PAGE_RAIN, 0, _rainData.rate, _rainData.valid && _rainData.rate != -1.0, 1, " mm/h");
+    drawValue(PAGE_RAIN, 1, _rainData.daily, _rainData.valid && _rainData.daily != -1.0, 1, " mm");
+    drawTrend(_rainTrend, TREND_LOW_Y);
 }
 
 void Display::drawWindPage() {
-    drawCenteredHeader("WIND");
-    setTextSize(1);
-
-    setCursor(0, 15);
-    print("Speed: ");
-    if (_windData.valid && _windData.speed != -1.0) { print(_windData.speed, 1); println(" m/s"); }
-    else println("NaN");
-
-    setCursor(0, 30);
-    print("Dir:   ");
-    if (_windData.valid && _windData.dir != -1.0) { print(_windData.dir, 0); println(" dg"); }
-    else println("NaN");
+    drawValue(PAGE_WIND, 0, _windData.speed, _windData.valid && _windData.speed != -1.0, 1, " m/s");
+    drawValue(PAGE_WIND, 1, _windData.dir, _windData.valid && _windData.dir != -1.0, 0, " dg");
+    drawTrend(_windTrend, TREND_LOW_Y);
 }
 
 void Display::drawLightPage() {
-    drawCenteredHeader("UV / LIGHT");
-    setTextSize(1);
-
-    setCursor(0, 15);
-    print("UV Index: ");
-    if (_lightData.valid && _lightData.uv != -1.0) print(_lightData.uv, 1);
-    else print("NaN");
-
-    setCursor(0, 30);
-    print("Light:    ");
-    if (_lightData.valid && _lightData.lux != -1.0) { print(_lightData.lux, 0); println(" lx"); }
-    else println("NaN");
+    drawValue(PAGE_LIGHT, 0, _lightData.uv, _lightData.valid && _lightData.uv != -1.0, 1, "");
+    drawValue(PAGE_LIGHT, 1, _lightData.lux, _lightData.valid && _lightData.lux != -1.0, 0, " lx");
+    drawTrend(_uvTrend, TREND_LOW_Y);
 }
 
 // --- New UI Methods ---
-void Display::setStatus(String status, bool isError) {
-    _statusMsg = status;
+void Display::setStatus(const char* status, bool isError) {
+    if (_isStatusError == isError && strcmp(_statusMsg, status) == 0) return;
+    copyText(_statusMsg, sizeof(_statusMsg), status);
     _isStatusError = isError;
     _statusTime = millis();
+    _dirty = true;
 }
 
 void Display::drawWifiIcon(int x, int y, bool connected) {
@@ -229,38 +327,26 @@ void Display::drawWifiIcon(int x, int y, bool connected) {
     // Center at y+6. Footer starts ~55. Icon y=55. Center=61. Max Y=64.
     // 61+2=63 (Fits). 
     if (connected) {
-         if (_type == DISP_SSD1306) _ssd1306->fillCircle(x+6, y+6, 2, SSD1306_WHITE);
-         else if (_type == DISP_SH1106) _sh1106->fillCircle(x+6, y+6, 2, SH110X_WHITE);
+         _gfx->fillCircle(x+6, y+6, 2, DISP_WHITE);
     } else {
         // Empty circle for disconnected
-        if (_type == DISP_SSD1306) _ssd1306->drawCircle(x+6, y+6, 2, SSD1306_WHITE);
-        else if (_type == DISP_SH1106) _sh1106->drawCircle(x+6, y+6, 2, SH110X_WHITE);
+        _gfx->drawCircle(x+6, y+6, 2, DISP_WHITE);
     }
 }
 
 void Display::drawFooter() {
-    // Footer line
-    if (_type == DISP_SSD1306) _ssd1306->drawLine(0, 54, 128, 54, SSD1306_WHITE);
-    else if (_type == DISP_SH1106) _sh1106->drawLine(0, 54, 128, 54, SH110X_WHITE);
-
+    // Footer line is part of the static layer
     setTextSize(1);
     
     // Left: Status Msg (e.g. "Sending...", "Success!", "HTTP:403")
     setCursor(0, 56);
     if (_isStatusError) {
-        // Invert or just print?
         print("ERR: "); print(_statusMsg);
+    } else if (_statusMsg[0] != '\0') {
+        // Persistent until changed by main ("Sending..." -> "Success!")
+        print(_statusMsg);
     } else {
-        if (_statusMsg.length() > 0) {
-             print(_statusMsg);
-             // Clear status after 5 sec if it is not an error?
-             // Or keep it? User wants "Sending.." then "Success".
-             // Let main reset it or timeouts? 
-             // For now, persistent until changed.
-        } else {
-             // Default if empty?
-             print("Stat: "); print(_netData.status); 
-        }
+        print("Stat: "); print(_netData.status);
     }
     
     // Right: WiFi Icon
@@ -271,7 +357,7 @@ void Display::drawFooter() {
 
 // --- Helpers & Existing Wrappers ---
 
-void Display::printStartup(String ssid) {
+void Display::printStartup(const char* ssid) {
     if (_type == DISP_NONE) return;
     clear();
     
@@ -283,67 +369,85 @@ void Display::printStartup(String ssid) {
     setTextSize(1); 
     
     setCursor(30, 15);
-    println("DLS Weather");
+    print("DLS Weather");
     setCursor(40, 28);
-    println("Station");
+    print("Station");
     
     // Status at bottom
     setCursor(0, 50);
-    print("WiFi: "); println(ssid);
+    print("WiFi: "); print(ssid);
     
     display();
+    _dirty = true; // Next update() must repaint the page
 }
 
-void Display::showMessage(String msg) {
+void Display::showMessage(const char* msg) {
     if (_type == DISP_NONE) return;
     clear();
     setTextSize(1); setCursor(0, 0);
-    println(msg);
+    print(msg);
     display();
+    _dirty = true;
 }
 
 void Display::off() {
     if (_type == DISP_NONE) return;
     clear();
     display(); // Make it black
+    if (busReady()) _backend->setPower(false);
+    setPowered(false);
+    _dirty = true;
 }
 
 void Display::on() {
     if (_type == DISP_NONE) return;
+    if (busReady()) _backend->setPower(true);
+    setPowered(_type != DISP_HEADLESS);
+    _dirty = true;
     update(); // Force a redraw to "turn on"
 }
 
 void Display::clear() {
-    if (_type == DISP_SSD1306) _ssd1306->clearDisplay();
-    else if (_type == DISP_SH1106) _sh1106->clearDisplay();
+    _backend->clear();
 }
 
 void Display::display() {
-    if (_type == DISP_SSD1306) _ssd1306->display();
-    else if (_type == DISP_SH1106) _sh1106->display();
+    DLS_TRACE_SCOPE("oled.flush");
+    if (!busReady()) return;
+    _backend->flush();
 }
 
-void Display::setCursor(int x, int y) {
-    if (_type == DISP_SSD1306) _ssd1306->setCursor(x, y);
-    else if (_type == DISP_SH1106) _sh1106->setCursor(x, y);
-}
-
-void Display::setTextSize(int s) {
-    if (_type == DISP_SSD1306) _ssd1306->setTextSize(s);
-    else if (_type == DISP_SH1106) _sh1106->setTextSize(s);
+// A missing ACK skips the 1 KB transfer instead of timing out on every
+// chunk. A degraded panel (e.g. after a brown-out) is re-initialized when
+// its re-probe is due.
+bool Display::busReady() {
+    if (_type == DISP_HEADLESS) return true;
+    if (!I2CBus::ready(I2C_DEV_OLED)) return false;
+
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    bool ok = I2CBus::ping(OLED_ADDR);
+    if (ok && I2CBus::degraded(I2C_DEV_OLED)) {
+        // begin() wipes the framebuffer; keep the frame about to be sent.
+        // clear() first so SH110X marks the whole window dirty again.
+        uint8_t frame[SCREEN_BUFFER_SIZE];
+        memcpy(frame, _backend->buffer(), sizeof(frame));
+        ok = _backend->begin();
+        _backend->clear();
+        memcpy(_backend->buffer(), frame, sizeof(frame));
+        if (ok && !_powered) _backend->setPower(false);
+    }
+    I2CBus::report(I2C_DEV_OLED, ok);
+    return ok;
 }
 
-void Display::print(String s) {
-    if (_type == DISP_SSD1306) _ssd1306->print(s);
-    else if (_type == DISP_SH1106) _sh1106->print(s);
+void Display::setCursor(int x, int y) {
+    _gfx->setCursor(x, y);
 }
 
-void Display::print(float f, int dec) {
-    if (_type == DISP_SSD1306) _ssd1306->print(f, dec);
-    else if (_type == DISP_SH1106) _sh1106->print(f, dec);
+void Display::setTextSize(int s) {
+    _gfx->setTextSize(s);
 }
 
-void Display::println(String s) {
-    if (_type == DISP_SSD1306) _ssd1306->println(s);
-    else if (_type == DISP_SH1106) _sh1106->println(s);
+void Display::print(const char* s) {
+    _gfx->print(s);
 }
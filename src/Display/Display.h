@@ -2,14 +2,14 @@
 
 #include <Arduino.h>
 #include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
-#include <Adafruit_SH110X.h>
+#include "DisplayBackend.h"
+#include "Sparkline.h"
 
 enum DisplayType {
     DISP_NONE,
     DISP_SSD1306,
-    DISP_SH1106
+    DISP_SH1106,
+    DISP_HEADLESS
 };
 
 enum DisplayPage {
@@ -25,7 +25,9 @@ struct DispAirData {
     float temp = -999.0;
     float hum = -999.0;
     float pres = -999.0;
-    float gas = -999.0; // IAQ / Gas Res
+    float iaq = -999.0; // IAQ index (0..500)
+    uint8_t iaqAccuracy = 0;
+    float dew = -999.0; // Dew point (derived)
     bool valid = false;
 };
 
@@ -48,9 +50,9 @@ struct DispLightData {
 };
 
 struct DispNetData {
-    String ip = "";
-    String ssid = "";
-    String status = "";
+    char ip[16] = "";
+    char ssid[33] = "";
+    char status[16] = "";
     bool connected = false;
 };
 
@@ -59,30 +61,51 @@ public:
     Display();
     void begin(TwoWire *wire = &Wire);
     void update(); // Main loop
+    void renderPage(DisplayPage page); // Draw a page into the framebuffer without flushing
 
     // Data Setters
-    void setAirData(float temp, float hum, float pres, float gas);
+    void setAirData(float temp, float hum, float pres, float iaq, uint8_t iaqAccuracy, float dew = -999.0);
     void setWindData(float speed, float dir); 
     void setRainData(float rate, float daily); 
     void setLightData(float uv, float lux);
-    void setNetworkInfo(String ip, String ssid, String status, bool connected);
-    void setStatus(String status, bool isError = false); // New Status Bar method
+    void setNetworkInfo(const char* ip, const char* ssid, const char* status, bool connected);
+    void setStatus(const char* status, bool isError = false); // New Status Bar method
 
-    void printStartup(String ssid);
-    void showMessage(String msg);
+    void printStartup(const char* ssid);
+    void showMessage(const char* msg);
 
     void off(); // Clear display and turn off
     void on();  // Restore/Turn on
 
+    DisplayType getType() const { return _type; }
+    const uint8_t* framebuffer() { return _backend ? _backend->buffer() : nullptr; }
+
 private:
     DisplayType _type;
-    Adafruit_SSD1306* _ssd1306;
-    Adafruit_SH1106G* _sh1106;
+    DisplayBackend* _backend; // Selected once in begin()
+    Adafruit_GFX* _gfx;       // Cached _backend->gfx() for drawing
+
+    void setPowered(bool on);
     
     // Internal State
     DisplayPage _currentPage = PAGE_NET;
     unsigned long _lastSwitchTime = 0;
     const unsigned long _pageDuration = 5000; // 5 seconds
+    bool _dirty = true; // Data changed since the last flush
+    bool _powered = false; // Panel on, for energy accounting
+
+    // Static layer cache: header, labels and footer rule of each page,
+    // rendered once and blitted before the dynamic fields are drawn. Lives
+    // in the "display" arena (PSRAM on boards that have it).
+    uint8_t* _layers[PAGE_COUNT] = {};
+    bool _layerReady[PAGE_COUNT] = {};
+
+    // Trend graphs beside the values, 3 h each (see Sparkline.h)
+    Sparkline _tempTrend;
+    Sparkline _presTrend;
+    Sparkline _rainTrend;
+    Sparkline _windTrend;
+    Sparkline _uvTrend;
 
     // Data
     DispAirData _airData;
@@ -92,12 +115,13 @@ private:
     DispNetData _netData;
 
     // Status Bar
-    String _statusMsg = "";
+    char _statusMsg[24] = "";
     bool _isStatusError = false;
     unsigned long _statusTime = 0;
 
     // Drawing Helpers
-    void drawCenteredHeader(String title);
+    void drawStaticLayer(DisplayPage page);
+    void drawCenteredHeader(const char* title);
     void drawFooter();
     void drawWifiIcon(int x, int y, bool connected);
     void drawAirPage();
@@ -105,13 +129,15 @@ private:
     void drawRainPage();
     void drawLightPage();
     void drawNetPage();
+    void drawField(DisplayPage page, int row, const char* value);
+    void drawValue(DisplayPage page, int row, float value, bool ok, int dec, const char* unit);
+    void drawTrend(const Sparkline &trend, int y);
 
     // Hardware Wrappers
     void clear();
     void display();
+    bool busReady();
     void setCursor(int x, int y);
     void setTextSize(int s);
-    void print(String s);
-    void print(float f, int dec = 1);
-    void println(String s);
+    void print(const char* s);
 };
@@ -0,0 +1,78 @@
+#include "DisplayBackend.h"
+#include "Bus/I2CBus.h"
+
+#define OLED_RESET -1
+
+// --- SSD1306 ---
+#if DLS_DISPLAY_SSD1306
+SSD1306Backend::SSD1306Backend(TwoWire *wire, uint8_t addr)
+    // The library sets its own clock around each transfer; keep the OLED
+    // clock afterwards too so I2CBus knows what the bus runs at
+    : _oled(SCREEN_WIDTH, SCREEN_HEIGHT, wire, OLED_RESET,
+            I2CBus::clockFor(I2C_DEV_OLED), I2CBus::clockFor(I2C_DEV_OLED)), _addr(addr) {
+    _gfx = &_oled;
+}
+
+bool SSD1306Backend::begin() {
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    if (!_oled.begin(SSD1306_SWITCHCAPVCC, _addr)) return false;
+    _oled.clearDisplay();
+    _oled.setTextColor(SSD1306_WHITE);
+    _oled.display();
+    return true;
+}
+
+void SSD1306Backend::flush() {
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    _oled.display();
+}
+
+void SSD1306Backend::setPower(bool on) {
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    _oled.ssd1306_command(on ? SSD1306_DISPLAYON : SSD1306_DISPLAYOFF);
+}
+#endif
+
+// --- SH1106 ---
+#if DLS_DISPLAY_SH1106
+SH1106Backend::SH1106Backend(TwoWire *wire, uint8_t addr)
+    : _oled(SCREEN_WIDTH, SCREEN_HEIGHT, wire, OLED_RESET,
+            I2CBus::clockFor(I2C_DEV_OLED), I2CBus::clockFor(I2C_DEV_OLED)), _addr(addr) {
+    _gfx = &_oled;
+}
+
+bool SH1106Backend::begin() {
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    if (!_oled.begin(_addr, true)) return false;
+    _oled.clearDisplay();
+    _oled.setTextColor(SH110X_WHITE);
+    _oled.display();
+    return true;
+}
+
+void SH1106Backend::flush() {
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    _oled.display();
+}
+
+void SH1106Backend::setPower(bool on) {
+    DLS_I2C_SCOPE(I2C_DEV_OLED);
+    _oled.oled_command(on ? SH110X_DISPLAYON : SH110X_DISPLAYOFF);
+}
+#endif
+
+// --- Headless ---
+#if DLS_DISPLAY_HEADLESS
+HeadlessBackend::HeadlessBackend() {
+    _gfx = &_canvas;
+    _canvas.setTextColor(DISP_WHITE);
+    clear();
+}
+
+void HeadlessBackend::Canvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) return;
+    uint8_t &b = data[x + (y / 8) * SCREEN_WIDTH];
+    if (color) b |= (1 << (y & 7));
+    else b &= ~(1 << (y & 7));
+}
+#endif
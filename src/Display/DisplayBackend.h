@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include "Config/Features.h"
+#if DLS_DISPLAY_SSD1306
+#include <Adafruit_SSD1306.h>
+#endif
+#if DLS_DISPLAY_SH1106
+#include <Adafruit_SH110X.h>
+#endif
+
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+#define SCREEN_BUFFER_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+
+// 1bpp colours shared by every backend (SSD1306_WHITE == SH110X_WHITE == 1)
+#define DISP_BLACK 0
+#define DISP_WHITE 1
+
+// Display hardware abstraction.
+// The backend is chosen once in Display::begin(). Drawing goes straight to
+// the Adafruit_GFX returned by gfx(); only frame-level operations (clear,
+// flush, power) are virtual, so there is no per-primitive type switch.
+// buffer() exposes the framebuffer in SSD1306 page layout:
+// byte (x + (y / 8) * SCREEN_WIDTH), bit (y & 7).
+class DisplayBackend {
+public:
+    virtual ~DisplayBackend() {}
+
+    virtual bool begin() = 0;
+    virtual void clear() = 0;
+    virtual void flush() = 0;
+    virtual void setPower(bool on) = 0;
+    virtual uint8_t* buffer() = 0;
+    virtual const char* name() const = 0;
+
+    Adafruit_GFX &gfx() { return *_gfx; }
+
+protected:
+    Adafruit_GFX* _gfx = nullptr;
+};
+
+#if DLS_DISPLAY_SSD1306
+class SSD1306Backend : public DisplayBackend {
+public:
+    SSD1306Backend(TwoWire *wire, uint8_t addr);
+    bool begin() override;
+    void clear() override { _oled.clearDisplay(); }
+    void flush() override;
+    void setPower(bool on) override;
+    uint8_t* buffer() override { return _oled.getBuffer(); }
+    const char* name() const override { return "SSD1306"; }
+
+private:
+    Adafruit_SSD1306 _oled;
+    uint8_t _addr;
+};
+#endif
+
+#if DLS_DISPLAY_SH1106
+class SH1106Backend : public DisplayBackend {
+public:
+    SH1106Backend(TwoWire *wire, uint8_t addr);
+    bool begin() override;
+    void clear() override { _oled.clearDisplay(); }
+    void flush() override;
+    void setPower(bool on) override;
+    uint8_t* buffer() override { return _oled.rawBuffer(); }
+    const char* name() const override { return "SH1106"; }
+
+private:
+    // Adafruit_GrayOLED keeps its buffer protected; expose it for blits.
+    class Driver : public Adafruit_SH1106G {
+    public:
+        using Adafruit_SH1106G::Adafruit_SH1106G;
+        uint8_t* rawBuffer() { return buffer; }
+    };
+
+    Driver _oled;
+    uint8_t _addr;
+};
+#endif
+
+#if DLS_DISPLAY_HEADLESS
+// Renders into RAM only. Used for benchmarking and for bring-up without an
+// OLED; flush() just counts frames.
+class HeadlessBackend : public DisplayBackend {
+public:
+    HeadlessBackend();
+    bool begin() override { clear(); return true; }
+    void clear() override { memset(_canvas.data, 0, sizeof(_canvas.data)); }
+    void flush() override { _frames++; }
+    void setPower(bool on) override { (void)on; }
+    uint8_t* buffer() override { return _canvas.data; }
+    const char* name() const override { return "Headless"; }
+
+    uint32_t frames() const { return _frames; }
+
+private:
+    class Canvas : public Adafruit_GFX {
+    public:
+        Canvas() : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT) {}
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+        uint8_t data[SCREEN_BUFFER_SIZE];
+    };
+
+    Canvas _canvas;
+    uint32_t _frames = 0;
+};
+#endif
@@ -0,0 +1,119 @@
+#include "Sparkline.h"
+#include "DisplayBackend.h" // SCREEN_WIDTH / SCREEN_HEIGHT, page layout
+
+Sparkline::Sparkline(uint8_t height) {
+    _height = height > SPARK_MAX_HEIGHT ? SPARK_MAX_HEIGHT : (height < 2 ? 2 : height);
+    for (uint8_t i = 0; i < SPARK_COLS; i++) {
+        _min[i] = INT16_MAX;
+        _max[i] = INT16_MIN;
+        _bits[i] = 0;
+    }
+}
+
+bool Sparkline::advance(unsigned long now) {
+    if (!_started) {
+        _started = true;
+        _colStart = now;
+        return false;
+    }
+    unsigned long steps = (now - _colStart) / SPARK_COL_MS;
+    if (steps == 0) return false;
+    _colStart += steps * SPARK_COL_MS;
+
+    // Shift the data and the rasterized plot together; new columns start empty
+    uint8_t n = steps < SPARK_COLS ? steps : SPARK_COLS;
+    uint8_t keep = SPARK_COLS - n;
+    memmove(&_min[0], &_min[n], keep * sizeof(_min[0]));
+    memmove(&_max[0], &_max[n], keep * sizeof(_max[0]));
+    memmove(&_bits[0], &_bits[n], keep * sizeof(_bits[0]));
+    for (uint8_t i = keep; i < SPARK_COLS; i++) {
+        _min[i] = INT16_MAX;
+        _max[i] = INT16_MIN;
+        _bits[i] = 0;
+    }
+
+    // An extreme may have scrolled out; rescale() redraws only if the range moves
+    rescale();
+    return true;
+}
+
+bool Sparkline::add(float value, unsigned long now) {
+    bool changed = advance(now);
+    float scaled = value * SPARK_SCALE;
+    if (isnan(scaled)) return changed;
+    int16_t v = scaled >= INT16_MAX - 1 ? INT16_MAX - 1 : (scaled <= INT16_MIN + 1 ? INT16_MIN + 1 : (int16_t)lroundf(scaled));
+
+    const uint8_t live = SPARK_COLS - 1;
+    bool wasEmpty = isEmpty(live);
+    if (!wasEmpty && v >= _min[live] && v <= _max[live]) return changed;
+    if (wasEmpty || v < _min[live]) _min[live] = v;
+    if (wasEmpty || v > _max[live]) _max[live] = v;
+
+    if ((v < _lo || v > _hi || _lo == _hi) && rescale()) {
+        // Whole plot redrawn on the new scale
+    } else {
+        uint32_t before = _bits[live];
+        rasterize(live);
+        if (_bits[live] == before) return changed;
+    }
+    return true;
+}
+
+uint8_t Sparkline::rowOf(int16_t v) const {
+    int32_t span = (int32_t)_hi - _lo;
+    int32_t r = (int32_t)(_height - 1) - ((int32_t)(v - _lo) * (_height - 1) + span / 2) / span;
+    return r < 0 ? 0 : (r >= _height ? _height - 1 : r);
+}
+
+void Sparkline::rasterize(uint8_t col) {
+    if (isEmpty(col) || _hi == _lo) {
+        _bits[col] = 0;
+        return;
+    }
+    uint8_t top = rowOf(_max[col]);
+    uint8_t bottom = rowOf(_min[col]);
+    uint64_t run = ((uint64_t)1 << (bottom - top + 1)) - 1;
+    _bits[col] = (uint32_t)(run << top);
+}
+
+bool Sparkline::rescale() {
+    int16_t lo = INT16_MAX, hi = INT16_MIN;
+    for (uint8_t i = 0; i < SPARK_COLS; i++) {
+        if (isEmpty(i)) continue;
+        if (_min[i] < lo) lo = _min[i];
+        if (_max[i] > hi) hi = _max[i];
+    }
+    if (lo > hi) return false; // No data yet
+
+    // Keep the current range while it holds the data and is not too loose
+    int32_t range = (int32_t)_hi - _lo;
+    if (_hi != _lo && lo >= _lo && hi <= _hi && (int32_t)(hi - lo) * 2 >= range - SPARK_MIN_RANGE) return false;
+
+    // Pad by 1/8 of the span on each side so small moves do not rescale
+    int32_t span = (int32_t)hi - lo;
+    if (span < SPARK_MIN_RANGE) span = SPARK_MIN_RANGE;
+    int32_t mid = ((int32_t)lo + hi) / 2;
+    int32_t half = span / 2 + span / 8 + 1;
+    int16_t newLo = (int16_t)max((int32_t)INT16_MIN, mid - half);
+    int16_t newHi = (int16_t)min((int32_t)INT16_MAX, mid + half);
+    if (newLo == _lo && newHi == _hi) return false;
+    _lo = newLo;
+    _hi = newHi;
+
+    for (uint8_t i = 0; i < SPARK_COLS; i++) rasterize(i);
+    return true;
+}
+
+void Sparkline::blit(uint8_t* fb, int x, int y) const {
+    if (!fb || y < 0 || y + _height > SCREEN_HEIGHT) return;
+    uint8_t firstPage = y / 8;
+    uint8_t lastPage = (y + _height - 1) / 8;
+    for (uint8_t c = 0; c < SPARK_COLS; c++) {
+        int px = x + c;
+        if (px < 0 || px >= SCREEN_WIDTH || !_bits[c]) continue;
+        uint64_t shifted = (uint64_t)_bits[c] << y;
+        for (uint8_t p = firstPage; p <= lastPage; p++) {
+            fb[px + p * SCREEN_WIDTH] |= (uint8_t)(shifted >> (p * 8));
+        }
+    }
+}
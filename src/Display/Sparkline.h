@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+
+// --- Trend Sparklines ---
+// The last SPARK_SPAN_MS of one value, downsampled to SPARK_COLS columns
+// that each keep the min and max seen in their SPARK_COL_MS slot and are
+// drawn as a vertical bar between the two. The rightmost column is live.
+//
+// The plot is kept rasterized, one bit column per data column (bit 0 =
+// top), so when time moves on the existing plot is shifted with a memmove
+// and only the new column is rasterized. The whole plot is redrawn only
+// when the vertical scale has to change: a value outside the current
+// range, or the data shrinking to under half of it.
+//
+// About 330 bytes per graph.
+
+#define SPARK_COLS 40
+#define SPARK_MAX_HEIGHT 32
+#define SPARK_SPAN_MS (3UL * 3600 * 1000) // 3 h on screen
+#define SPARK_COL_MS (SPARK_SPAN_MS / SPARK_COLS) // 4.5 min per column
+#define SPARK_SCALE 10 // Values are kept in tenths
+#define SPARK_MIN_RANGE 10 // Flattest scale, in tenths (e.g. 1 C over the full height)
+
+class Sparkline {
+public:
+    explicit Sparkline(uint8_t height);
+
+    // Both return true when the plot changed
+    bool add(float value, unsigned long now);
+    bool advance(unsigned long now); // No sample this time; keeps columns in step
+
+    // ORs the plot into a page-layout framebuffer (see DisplayBackend.h)
+    // with its top-left corner at (x, y)
+    void blit(uint8_t* fb, int x, int y) const;
+
+private:
+    bool isEmpty(uint8_t col) const { return _min[col] > _max[col]; }
+    uint8_t rowOf(int16_t v) const;
+    void rasterize(uint8_t col);
+    bool rescale(); // Picks a new range and redraws everything; false if unchanged
+
+    int16_t _min[SPARK_COLS]; // Oldest first, tenths
+    int16_t _max[SPARK_COLS];
+    uint32_t _bits[SPARK_COLS];
+    int16_t _lo = 0;
+    int16_t _hi = 0;
+    uint8_t _height;
+    bool _started = false;
+    unsigned long _colStart = 0;
+};
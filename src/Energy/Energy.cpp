@@ -0,0 +1,197 @@
+#include "Energy.h"
+
+#if DLS_FEATURE_ENERGY
+
+#include <Preferences.h>
+#include <esp_timer.h>
+
+#define ENERGY_MAGIC 0x454E5247 // "ENRG"
+#define ENERGY_DEFAULT_BATTERY_MAH 2000
+
+static const char* const CHANNEL_NAMES[ENERGY_CHANNELS] = {
+    "cpu", "radio", "boot", "wifi", "ntp", "sensor", "heater", "display", "http", "sleep"
+};
+
+// Typical ESP32-C3 node with a 0.96" OLED, in uA
+static const uint32_t DEFAULT_MODEL[ENERGY_CHANNELS] = {
+    25000, // cpu: 80-160 MHz, radio off
+    70000, // radio: Wi-Fi associated, modem sleep off
+    0,     // boot: CPU only, already in "cpu"
+    40000, // wifi: scan/association peaks
+    0,     // ntp: a single UDP round trip, covered by "radio"
+    700,   // sensor: BME/SHT conversion
+    12000, // heater: BME680 gas plate
+    12000, // display: OLED at ~50 % pixels lit
+    40000, // http: TX bursts
+    15     // sleep: deep sleep incl. regulator quiescent current
+};
+
+// Survives deep sleep; a power cycle fails the magic check and starts over
+struct EnergyTotals {
+    uint32_t magic;
+    uint32_t cycles;
+    uint64_t elapsedMs;                  // Awake + sleep
+    uint64_t chargeNAs;                  // nA*s (= uA*ms)
+    uint64_t channelMs[ENERGY_CHANNELS];
+    uint32_t lastMs[ENERGY_CHANNELS];
+    uint64_t lastNAs;
+};
+
+RTC_DATA_ATTR static EnergyTotals s_totals;
+
+static uint32_t s_model[ENERGY_CHANNELS];
+static uint32_t s_batteryMah = ENERGY_DEFAULT_BATTERY_MAH;
+
+uint64_t Energy::_startUs[ENERGY_CHANNELS];
+uint64_t Energy::_cycleUs[ENERGY_CHANNELS];
+uint8_t Energy::_depth[ENERGY_CHANNELS];
+
+static float toMah(uint64_t nAs) {
+    return nAs / 3.6e9f;
+}
+
+void Energy::begin() {
+    if (s_totals.magic != ENERGY_MAGIC) {
+        memset(&s_totals, 0, sizeof(s_totals));
+        s_totals.magic = ENERGY_MAGIC;
+    }
+    loadModel();
+
+    // The CPU has been running since reset, not since begin()
+    _depth[ENERGY_CPU] = 1;
+    _startUs[ENERGY_CPU] = 0;
+}
+
+void Energy::loadModel() {
+    Preferences prefs;
+    prefs.begin("dls-energy", true);
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        s_model[i] = prefs.getUInt(CHANNEL_NAMES[i], DEFAULT_MODEL[i]);
+    }
+    s_batteryMah = prefs.getUInt("battery", ENERGY_DEFAULT_BATTERY_MAH);
+    prefs.end();
+}
+
+void Energy::start(EnergyChannel ch) {
+    if (_depth[ch]++ == 0) _startUs[ch] = esp_timer_get_time();
+}
+
+void Energy::stop(EnergyChannel ch) {
+    if (_depth[ch] == 0) return;
+    if (--_depth[ch] == 0) _cycleUs[ch] += esp_timer_get_time() - _startUs[ch];
+}
+
+void Energy::add(EnergyChannel ch, uint32_t us) {
+    _cycleUs[ch] += us;
+}
+
+uint64_t Energy::elapsed(EnergyChannel ch, uint64_t now) {
+    return _cycleUs[ch] + (_depth[ch] ? now - _startUs[ch] : 0);
+}
+
+void Energy::endCycle(uint32_t sleepS) {
+    uint64_t now = esp_timer_get_time();
+    uint64_t charge = 0;
+    uint64_t cycleMs = 0;
+
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        EnergyChannel ch = (EnergyChannel)i;
+        uint32_t ms = (ch == ENERGY_SLEEP) ? sleepS * 1000UL : (uint32_t)(elapsed(ch, now) / 1000);
+        if (ch == ENERGY_CPU || ch == ENERGY_SLEEP) cycleMs += ms;
+
+        charge += (uint64_t)ms * s_model[i];
+        s_totals.channelMs[i] += ms;
+        s_totals.lastMs[i] = ms;
+
+        // Running channels carry over into the next cycle
+        _cycleUs[i] = 0;
+        if (_depth[i]) _startUs[i] = now;
+    }
+
+    s_totals.cycles++;
+    s_totals.elapsedMs += cycleMs;
+    s_totals.chargeNAs += charge;
+    s_totals.lastNAs = charge;
+}
+
+bool Energy::setCurrent(const char* channel, uint32_t microamps) {
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        if (strcmp(channel, CHANNEL_NAMES[i]) != 0) continue;
+        s_model[i] = microamps;
+        Preferences prefs;
+        prefs.begin("dls-energy", false);
+        prefs.putUInt(CHANNEL_NAMES[i], microamps);
+        prefs.end();
+        return true;
+    }
+    return false;
+}
+
+void Energy::setBattery(uint32_t mAh) {
+    s_batteryMah = mAh;
+    Preferences prefs;
+    prefs.begin("dls-energy", false);
+    prefs.putUInt("battery", mAh);
+    prefs.end();
+}
+
+void Energy::reset() {
+    memset(&s_totals, 0, sizeof(s_totals));
+    s_totals.magic = ENERGY_MAGIC;
+}
+
+// mAh per day from everything accounted so far; 0 until a cycle has closed
+static float mahPerDay() {
+    if (s_totals.elapsedMs == 0) return 0;
+    return toMah(s_totals.chargeNAs) * 86400000.0f / s_totals.elapsedMs;
+}
+
+void Energy::printReport(Print &out) {
+    float perDay = mahPerDay();
+    out.printf("Energy: %lu cycles, %.3f mAh total, %.3f mAh/cycle avg\n",
+               (unsigned long)s_totals.cycles, toMah(s_totals.chargeNAs),
+               s_totals.cycles ? toMah(s_totals.chargeNAs) / s_totals.cycles : 0.0f);
+    if (perDay > 0) {
+        out.printf("  %.2f mAh/day -> %.0f days on %lu mAh\n",
+                   perDay, s_batteryMah / perDay, (unsigned long)s_batteryMah);
+    } else {
+        out.println("  No cycle completed yet");
+    }
+
+    uint64_t now = esp_timer_get_time();
+    out.println("  channel     uA  current ms     last ms   last mAh");
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        EnergyChannel ch = (EnergyChannel)i;
+        out.printf("  %-8s %6lu  %10lu  %10lu  %9.4f\n", CHANNEL_NAMES[i],
+                   (unsigned long)s_model[i],
+                   (unsigned long)(ch == ENERGY_SLEEP ? 0 : elapsed(ch, now) / 1000),
+                   (unsigned long)s_totals.lastMs[i],
+                   toMah((uint64_t)s_totals.lastMs[i] * s_model[i]));
+    }
+    out.printf("  Last cycle: %.4f mAh\n", toMah(s_totals.lastNAs));
+}
+
+void Energy::writeJson(Print &out) {
+    float perDay = mahPerDay();
+    out.printf("{\"cycles\":%lu,\"mAhTotal\":%.4f,\"mAhPerCycle\":%.4f,\"mAhPerDay\":%.3f,",
+               (unsigned long)s_totals.cycles, toMah(s_totals.chargeNAs),
+               s_totals.cycles ? toMah(s_totals.chargeNAs) / s_totals.cycles : 0.0f, perDay);
+    out.printf("\"batteryMah\":%lu,\"batteryDays\":%.1f,\"lastCycle\":{\"mAh\":%.4f,\"ms\":{",
+               (unsigned long)s_batteryMah, perDay > 0 ? s_batteryMah / perDay : 0.0f,
+               toMah(s_totals.lastNAs));
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        out.printf("%s\"%s\":%lu", i ? "," : "", CHANNEL_NAMES[i], (unsigned long)s_totals.lastMs[i]);
+    }
+    out.print("}},\"totalMs\":{");
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        out.printf("%s\"%s\":%llu", i ? "," : "", CHANNEL_NAMES[i],
+                   (unsigned long long)s_totals.channelMs[i]);
+    }
+    out.print("},\"model\":{");
+    for (uint8_t i = 0; i < ENERGY_CHANNELS; i++) {
+        out.printf("%s\"%s\":%lu", i ? "," : "", CHANNEL_NAMES[i], (unsigned long)s_model[i]);
+    }
+    out.println("}}");
+}
+
+#endif
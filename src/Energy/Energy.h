@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Features.h"
+
+// Per-cycle energy accounting.
+// Each wake/upload cycle accumulates how long every consumer was active;
+// multiplied by a per-channel current model this gives the charge per
+// cycle and, together with the time spent in deep sleep, mAh per day and
+// an estimated battery life. Totals live in RTC memory, so they keep
+// adding up across deep sleep (a power cycle starts them over).
+//
+// The model is additive: CPU and RADIO are the base draw while awake /
+// while Wi-Fi is on, the other channels are extra current on top of that
+// (e.g. TX bursts during HTTP, the BME680 heater). Values are in uA and can
+// be changed with "energy set <channel> <uA>" (stored in NVS).
+
+enum EnergyChannel : uint8_t {
+    ENERGY_CPU,          // Awake (set automatically)
+    ENERGY_RADIO,        // Wi-Fi on
+    ENERGY_BOOT_DELAY,   // Sensor/serial settle delay in setup()
+    ENERGY_WIFI_CONNECT, // Scan + association
+    ENERGY_NTP,
+    ENERGY_SENSOR,       // Conversions
+    ENERGY_HEATER,       // BME680 gas heater pulses
+    ENERGY_DISPLAY,      // OLED powered
+    ENERGY_HTTP,         // Upload request
+    ENERGY_SLEEP,        // Deep sleep
+    ENERGY_CHANNELS
+};
+
+#if DLS_FEATURE_ENERGY
+
+class Energy {
+public:
+    // Validates the RTC totals and loads the current model from NVS
+    static void begin();
+
+    // Channel on/off (nested calls for the same channel are not counted twice)
+    static void start(EnergyChannel ch);
+    static void stop(EnergyChannel ch);
+    static void add(EnergyChannel ch, uint32_t us); // Known durations (heater pulse)
+
+    // Close the current cycle: before deep sleep (sleepS > 0, the sleep is
+    // booked with the cycle it follows) or after an upload attempt on
+    // always-on nodes (sleepS = 0).
+    static void endCycle(uint32_t sleepS);
+
+    static bool setCurrent(const char* channel, uint32_t microamps);
+    static void setBattery(uint32_t mAh);
+    static void reset();
+
+    static void printReport(Print &out);
+    static void writeJson(Print &out);
+
+private:
+    static uint64_t _startUs[ENERGY_CHANNELS]; // 0 = not running
+    static uint64_t _cycleUs[ENERGY_CHANNELS];
+    static uint8_t _depth[ENERGY_CHANNELS];
+
+    static uint64_t elapsed(EnergyChannel ch, uint64_t now);
+    static void loadModel();
+};
+
+class EnergyScope {
+public:
+    explicit EnergyScope(EnergyChannel ch) : _ch(ch) { Energy::start(ch); }
+    ~EnergyScope() { Energy::stop(_ch); }
+
+private:
+    EnergyChannel _ch;
+};
+
+#define DLS_ENERGY_CONCAT_(a, b) a##b
+#define DLS_ENERGY_CONCAT(a, b) DLS_ENERGY_CONCAT_(a, b)
+#define DLS_ENERGY_SCOPE(ch) EnergyScope DLS_ENERGY_CONCAT(_energyScope, __LINE__)(ch)
+
+#else
+
+#define DLS_ENERGY_SCOPE(ch) do {} while (0)
+
+#endif
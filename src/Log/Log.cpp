@@ -0,0 +1,134 @@
+#include "Log.h"
+
+#include <atomic>
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static_assert((DLS_LOG_BUFFER & (DLS_LOG_BUFFER - 1)) == 0, "DLS_LOG_BUFFER must be a power of two");
+static_assert(LOG_LINE_MAX + 4 <= DLS_LOG_BUFFER / 2, "DLS_LOG_BUFFER too small for LOG_LINE_MAX");
+
+// Ring layout: records of [uint16 header][text], padded to an even length so
+// every header is 2-byte aligned. The header carries the text length and a
+// COMMIT bit that the writer sets last; a record that would cross the end of
+// the ring is preceded by a PAD record filling the remainder.
+//
+// Writers claim space by advancing _reserve with a CAS, so concurrent tasks
+// never share bytes and nobody takes a lock. The single reader (the drain
+// task, or flush() before begin()) stops at the first uncommitted header,
+// zeroes what it consumed and then advances _tail, which is what frees the
+// space for writers.
+
+#define LOG_MASK       (DLS_LOG_BUFFER - 1)
+#define LOG_HDR_COMMIT 0x8000
+#define LOG_HDR_PAD    0x4000
+#define LOG_HDR_LEN    0x3FFF
+
+alignas(4) static uint8_t s_ring[DLS_LOG_BUFFER];
+static std::atomic<uint32_t> s_reserve(0); // Total bytes ever claimed
+static std::atomic<uint32_t> s_tail(0);    // Total bytes ever drained
+static std::atomic<uint32_t> s_dropped(0);
+static TaskHandle_t s_task = nullptr;
+
+static inline uint16_t* header(uint32_t pos) {
+    return reinterpret_cast<uint16_t*>(&s_ring[pos & LOG_MASK]);
+}
+
+static inline uint32_t recordSize(uint32_t len) {
+    return (2 + len + 1) & ~1u;
+}
+
+void Log::write(const char* tag, const char* fmt, ...) {
+    char line[LOG_LINE_MAX + 2];
+    size_t n = 0;
+    if (tag) {
+        int t = snprintf(line, LOG_LINE_MAX, "[%s] ", tag);
+        n = t > 0 ? ((size_t)t < LOG_LINE_MAX ? t : LOG_LINE_MAX - 1) : 0;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int m = vsnprintf(line + n, LOG_LINE_MAX - n, fmt, args);
+    va_end(args);
+    if (m > 0) n += ((size_t)m < LOG_LINE_MAX - n) ? m : LOG_LINE_MAX - n - 1;
+    line[n++] = '\r';
+    line[n++] = '\n';
+
+    // Claim space: the record, plus a pad to the end of the ring if the
+    // record would not fit contiguously
+    uint32_t need = recordSize(n);
+    uint32_t head = s_reserve.load(std::memory_order_relaxed);
+    uint32_t room, total;
+    do {
+        room = DLS_LOG_BUFFER - (head & LOG_MASK);
+        total = need <= room ? need : room + need;
+        if (head + total - s_tail.load(std::memory_order_acquire) > DLS_LOG_BUFFER) {
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } while (!s_reserve.compare_exchange_weak(head, head + total,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+
+    if (need > room) {
+        __atomic_store_n(header(head), (uint16_t)(LOG_HDR_COMMIT | LOG_HDR_PAD | (room - 2)), __ATOMIC_RELEASE);
+        head += room;
+    }
+    memcpy(&s_ring[(head & LOG_MASK) + 2], line, n);
+    __atomic_store_n(header(head), (uint16_t)(LOG_HDR_COMMIT | n), __ATOMIC_RELEASE);
+
+    if (s_task) xTaskNotifyGive(s_task);
+}
+
+void Log::drain() {
+    uint32_t tail = s_tail.load(std::memory_order_relaxed);
+    while (tail != s_reserve.load(std::memory_order_acquire)) {
+        uint16_t hdr = __atomic_load_n(header(tail), __ATOMIC_ACQUIRE);
+        if (!(hdr & LOG_HDR_COMMIT)) break; // Writer still copying; next round
+
+        uint32_t len = hdr & LOG_HDR_LEN;
+        uint32_t pos = tail & LOG_MASK;
+        if (!(hdr & LOG_HDR_PAD)) Serial.write(&s_ring[pos + 2], len);
+
+        // Stale bytes could read as a committed header once reused
+        uint32_t size = recordSize(len);
+        memset(&s_ring[pos], 0, size);
+        tail += size;
+        s_tail.store(tail, std::memory_order_release);
+    }
+}
+
+void Log::task(void*) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(50));
+        drain();
+    }
+}
+
+void Log::begin() {
+    if (s_task) return;
+    xTaskCreate(task, "log", 2048, nullptr, 1, &s_task);
+}
+
+void Log::flush(uint32_t timeoutMs) {
+    if (!s_task) {
+        drain();
+        return;
+    }
+    xTaskNotifyGive(s_task);
+    unsigned long start = millis();
+    while (s_tail.load(std::memory_order_acquire) != s_reserve.load(std::memory_order_acquire) &&
+           millis() - start < timeoutMs) {
+        delay(1);
+    }
+    Serial.flush();
+}
+
+uint32_t Log::dropped() {
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+void Log::printStatus(Print &out) {
+    uint32_t used = s_reserve.load(std::memory_order_relaxed) - s_tail.load(std::memory_order_relaxed);
+    out.printf("Log: level %d, %lu/%u bytes queued, %lu dropped\n",
+               DLS_LOG_LEVEL, (unsigned long)used, (unsigned)DLS_LOG_BUFFER, (unsigned long)dropped());
+}
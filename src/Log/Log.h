@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Features.h"
+
+// Asynchronous diagnostic log.
+// LOG_I("Tag", "fmt", ...) formats one line on the caller's stack and copies
+// it into a lock-free byte ring; a low-priority task drains the ring to
+// Serial. The caller never waits for the UART or USB-CDC: when the ring is
+// full the line is dropped and counted instead.
+//
+// Levels above DLS_LOG_LEVEL compile out: the call stays in an `if (0)` so
+// its format string is still checked, but no code or string is emitted and
+// the arguments are never evaluated.
+//
+// Protocol and command output (CONFIG_SAVED, GET_CONFIG, status, trace, ...)
+// keeps writing to Serial directly, so it is not subject to dropping. Not for
+// use from an ISR.
+
+#define DLS_LOG_NONE  0
+#define DLS_LOG_ERROR 1
+#define DLS_LOG_WARN  2
+#define DLS_LOG_INFO  3
+#define DLS_LOG_DEBUG 4
+
+#ifndef DLS_LOG_BUFFER
+#define DLS_LOG_BUFFER 2048 // Ring size in bytes; must be a power of two
+#endif
+
+#define LOG_LINE_MAX 160 // Longer lines are truncated
+
+class Log {
+public:
+    // Starts the drain task; lines logged before this are held in the ring
+    static void begin();
+
+    // Appends "[tag] message\r\n"; tag may be nullptr for an untagged line
+    static void write(const char* tag, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    // Waits until everything logged so far has reached Serial. Call before
+    // deep sleep or a restart, which would otherwise lose the tail.
+    static void flush(uint32_t timeoutMs = 500);
+
+    static uint32_t dropped();
+    static void printStatus(Print &out);
+
+private:
+    static void drain();
+    static void task(void*);
+};
+
+#define DLS_LOG_AT_(level, tag, ...) \
+    do { if (DLS_LOG_LEVEL >= (level)) Log::write(tag, __VA_ARGS__); } while (0)
+
+#define LOG_E(tag, ...) DLS_LOG_AT_(DLS_LOG_ERROR, tag, __VA_ARGS__)
+#define LOG_W(tag, ...) DLS_LOG_AT_(DLS_LOG_WARN, tag, __VA_ARGS__)
+#define LOG_I(tag, ...) DLS_LOG_AT_(DLS_LOG_INFO, tag, __VA_ARGS__)
+#define LOG_D(tag, ...) DLS_LOG_AT_(DLS_LOG_DEBUG, tag, __VA_ARGS__)
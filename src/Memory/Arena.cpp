@@ -0,0 +1,99 @@
+#include "Arena.h"
+#include "Log/Log.h"
+
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+
+#define PSRAM_CAPS (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define INTERNAL_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+
+Arena* Arena::_first = nullptr;
+
+Arena::Arena(const char* name, size_t capacity) : _name(name), _capacity(capacity), _next(_first) {
+    // Arenas are globals; _first is zero-initialized before any of them run
+    _first = this;
+}
+
+bool Arena::psramFound() {
+    return heap_caps_get_total_size(PSRAM_CAPS) > 0;
+}
+
+void* Arena::alloc(size_t size, size_t align) {
+    if (!_reserved) {
+        _reserved = true;
+        if (psramFound()) _base = static_cast<uint8_t*>(heap_caps_malloc(_capacity, PSRAM_CAPS));
+        if (_base) memset(_base, 0, _capacity);
+        else if (psramFound()) LOG_W("Mem", "%s: %u B PSRAM ayrilamadi", _name, (unsigned)_capacity);
+    }
+
+    if (_base) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(_base);
+        size_t offset = ((start + _used + align - 1) & ~(uintptr_t)(align - 1)) - start;
+        if (offset + size <= _capacity) {
+            _used = offset + size;
+            return _base + offset;
+        }
+        LOG_W("Mem", "%s dolu (%u/%u B), %u B dahili RAM'e", _name, (unsigned)_used, (unsigned)_capacity,
+              (unsigned)size);
+    }
+
+    void* p = heap_caps_calloc(1, size, INTERNAL_CAPS);
+    if (p) {
+        _fallback += size;
+    } else {
+        _failed++;
+        LOG_E("Mem", "%s: %u B ayrilamadi", _name, (unsigned)size);
+    }
+    return p;
+}
+
+void Arena::printStatus(Print &out) {
+    size_t total = heap_caps_get_total_size(PSRAM_CAPS);
+    if (total) {
+        out.printf("PSRAM: %u free / %u B\n", (unsigned)heap_caps_get_free_size(PSRAM_CAPS), (unsigned)total);
+    } else {
+        out.println("PSRAM: yok, arenalar dahili RAM'de");
+    }
+    for (const Arena* a = _first; a; a = a->_next) {
+        out.printf("  arena %-8s %5u/%u B %s", a->_name, (unsigned)a->_used, (unsigned)a->_capacity,
+                   a->_base ? "PSRAM" : "-");
+        if (a->_fallback) out.printf(", %u B internal", (unsigned)a->_fallback);
+        if (a->_failed) out.printf(", %u failed", a->_failed);
+        out.println();
+    }
+    out.printf("  json     %5u B live, %u B peak\n", (unsigned)JsonAllocator::instance.live(),
+               (unsigned)JsonAllocator::instance.peak());
+}
+
+// --- JsonAllocator ---
+
+JsonAllocator JsonAllocator::instance;
+
+// Documents are also parsed in the OTA task
+static portMUX_TYPE s_jsonMux = portMUX_INITIALIZER_UNLOCKED;
+
+void JsonAllocator::track(size_t freed, size_t added) {
+    portENTER_CRITICAL(&s_jsonMux);
+    _live = _live - freed + added;
+    if (_live > _peak) _peak = _live;
+    portEXIT_CRITICAL(&s_jsonMux);
+}
+
+void* JsonAllocator::allocate(size_t size) {
+    void* p = heap_caps_malloc_prefer(size, 2, PSRAM_CAPS, INTERNAL_CAPS);
+    if (p) track(0, heap_caps_get_allocated_size(p));
+    return p;
+}
+
+void JsonAllocator::deallocate(void* ptr) {
+    if (!ptr) return;
+    track(heap_caps_get_allocated_size(ptr), 0);
+    heap_caps_free(ptr);
+}
+
+void* JsonAllocator::reallocate(void* ptr, size_t newSize) {
+    size_t before = ptr ? heap_caps_get_allocated_size(ptr) : 0;
+    void* p = heap_caps_realloc_prefer(ptr, newSize, 2, PSRAM_CAPS, INTERNAL_CAPS);
+    if (p) track(before, heap_caps_get_allocated_size(p));
+    return p;
+}
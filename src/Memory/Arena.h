@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Memory placement for large buffers.
+// Big, cold buffers that are read sequentially (page layer caches, outboxes,
+// JSON documents) go to PSRAM where the board has it; the small internal
+// heap is left to what is latency-critical (log and trace rings, the I2C
+// framebuffer, Wi-Fi and ESP-NOW callbacks, task stacks).
+//
+// An Arena reserves one PSRAM block of its capacity on the first alloc() and
+// hands out pieces of it that are never freed, so it is meant for buffers
+// that live as long as the firmware, allocated from setup()/begin(). Without
+// PSRAM, or once the block is used up, each alloc() falls back to the
+// internal heap instead of failing; the fallback is counted so `status`
+// shows which buffers did not get PSRAM. Not thread-safe.
+//
+// The arena's name must be a string literal; every arena lists itself in
+// Arena::printStatus().
+
+class Arena {
+public:
+    Arena(const char* name, size_t capacity);
+
+    // Zeroed, aligned memory; nullptr only if the internal heap is exhausted
+    void* alloc(size_t size, size_t align = 4);
+    template <typename T> T* alloc(size_t count) { return static_cast<T*>(alloc(count * sizeof(T), alignof(T))); }
+
+    bool inPsram() const { return _base != nullptr; }
+    size_t used() const { return _used; }
+    size_t fallbackBytes() const { return _fallback; }
+
+    static bool psramFound();
+    static void printStatus(Print &out); // PSRAM totals, every arena and JSON documents
+
+private:
+    const char* _name;
+    size_t _capacity;
+    uint8_t* _base = nullptr; // PSRAM block, reserved on the first alloc()
+    bool _reserved = false;
+    size_t _used = 0;
+    size_t _fallback = 0; // Bytes that went to the internal heap instead
+    uint16_t _failed = 0;
+
+    Arena* _next;
+    static Arena* _first;
+};
+
+// ArduinoJson allocator that prefers PSRAM and falls back to the internal
+// heap. Documents freed right after a request (API responses, the OTA
+// manifest) use it: JsonDocument doc(&JsonAllocator::instance);
+class JsonAllocator : public ArduinoJson::Allocator {
+public:
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    size_t live() const { return _live; }
+    size_t peak() const { return _peak; }
+
+    static JsonAllocator instance;
+
+private:
+    void track(size_t freed, size_t added);
+
+    size_t _live = 0;
+    size_t _peak = 0;
+};
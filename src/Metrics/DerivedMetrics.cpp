@@ -0,0 +1,252 @@
+#include "DerivedMetrics.h"
+#include <math.h>
+
+// --- Common ---
+#define MAGNUS_B 17.62F
+#define MAGNUS_C 243.12F
+
+// Valid input range of both implementations
+#define T_MIN_C -40
+#define T_MAX_C 60
+
+void DerivedMetrics::update(const AirData &air) {
+#if DLS_METRICS_FIXED_POINT
+    computeFixed(air, _altitude, _data);
+#else
+    computeFloat(air, _altitude, _data);
+#endif
+}
+
+static bool hasTemp(const AirData &air) {
+    return air.valid && air.temperature != -999.0 &&
+           air.temperature >= T_MIN_C && air.temperature <= T_MAX_C;
+}
+
+static bool hasHum(const AirData &air) {
+    return air.valid && air.humidity != -999.0 && air.humidity > 0 && air.humidity <= 100;
+}
+
+static bool hasPres(const AirData &air) {
+    return air.valid && air.pressure != -999.0 && air.pressure > 0;
+}
+
+// --- Float Path ---
+
+// NOAA heat index (Rothfusz regression with adjustments), Fahrenheit in/out
+static float heatIndexF(float t, float rh) {
+    float hi = 0.5F * (t + 61.0F + (t - 68.0F) * 1.2F + rh * 0.094F);
+    if ((hi + t) / 2.0F < 80.0F) return hi;
+
+    hi = -42.379F + 2.04901523F * t + 10.14333127F * rh
+         - 0.22475541F * t * rh - 0.00683783F * t * t
+         - 0.05481717F * rh * rh + 0.00122874F * t * t * rh
+         + 0.00085282F * t * rh * rh - 0.00000199F * t * t * rh * rh;
+
+    if (rh < 13.0F && t > 80.0F && t < 112.0F) {
+        hi -= ((13.0F - rh) / 4.0F) * sqrtf((17.0F - fabsf(t - 95.0F)) / 17.0F);
+    } else if (rh > 85.0F && t > 80.0F && t < 87.0F) {
+        hi += ((rh - 85.0F) / 10.0F) * ((87.0F - t) / 5.0F);
+    }
+    return hi;
+}
+
+void DerivedMetrics::computeFloat(const AirData &air, float altitude, DerivedData &out) {
+    out = DerivedData();
+
+    if (hasTemp(air) && hasHum(air)) {
+        float t = air.temperature;
+        float rh = air.humidity;
+
+        float gamma = logf(rh / 100.0F) + MAGNUS_B * t / (MAGNUS_C + t);
+        float td = MAGNUS_C * gamma / (MAGNUS_B - gamma);
+        if (td >= T_MIN_C) out.dewPoint = td; // Same range as the fixed-point table
+
+        float es = 611.2F * expf(MAGNUS_B * t / (MAGNUS_C + t)); // Pa
+        float e = es * rh / 100.0F;
+        out.absHumidity = 2.1674F * e / (t + 273.15F);
+
+        float tf = t * 1.8F + 32.0F;
+        out.heatIndex = (heatIndexF(tf, rh) - 32.0F) / 1.8F;
+        out.valid = true;
+    }
+
+    if (hasTemp(air) && hasPres(air)) {
+        // Barometric formula (ICAO lapse rate), station -> sea level
+        float t = air.temperature;
+        float ratio = 1.0F - (0.0065F * altitude) / (t + 0.0065F * altitude + 273.15F);
+        out.seaLevelPressure = air.pressure * powf(ratio, -5.257F);
+        out.valid = true;
+    }
+}
+
+// --- Fixed-Point Path ---
+// Units: temperature in 0.01 C, humidity in 0.01 %RH, pressure in Pa,
+// vapour pressure in 0.1 Pa.
+
+// Saturation vapour pressure over water (Magnus), 0.1 Pa, -40..60 C in 1 C steps
+static const uint32_t ES_TABLE[T_MAX_C - T_MIN_C + 1] = {
+    190, 211, 234, 259, 286, 316, 348, 384, 423, 465,
+    512, 562, 617, 676, 741, 811, 887, 970, 1059, 1155,
+    1260, 1372, 1494, 1625, 1766, 1919, 2083, 2259, 2448, 2652,
+    2870, 3105, 3356, 3625, 3913, 4222, 4552, 4904, 5281, 5683,
+    6112, 6569, 7057, 7576, 8129, 8717, 9343, 10008, 10714, 11464,
+    12260, 13105, 14000, 14948, 15953, 17017, 18142, 19333, 20591, 21921,
+    23326, 24809, 26374, 28025, 29766, 31601, 33533, 35569, 37711, 39966,
+    42337, 44830, 47450, 50203, 53094, 56128, 59313, 62653, 66156, 69827,
+    73675, 77704, 81924, 86341, 90963, 95797, 100852, 106137, 111659, 117427,
+    123452, 129741, 136304, 143152, 150294, 157742, 165504, 173593, 182020, 190796,
+    199933,
+};
+
+static int32_t esFixed(int32_t tc) { // tc in 0.01 C -> 0.1 Pa
+    int32_t rel = tc - T_MIN_C * 100;
+    if (rel < 0) rel = 0;
+    int32_t idx = rel / 100;
+    if (idx >= T_MAX_C - T_MIN_C) return ES_TABLE[T_MAX_C - T_MIN_C];
+    int32_t frac = rel % 100;
+    int32_t lo = ES_TABLE[idx];
+    int32_t hi = ES_TABLE[idx + 1];
+    return lo + ((hi - lo) * frac) / 100;
+}
+
+// 0.1 Pa -> 0.01 C (inverse lookup); false below the table (dew point < -40 C)
+static bool dewPointFixed(int32_t e, int32_t &td) {
+    const int32_t last = T_MAX_C - T_MIN_C;
+    if (e < (int32_t)ES_TABLE[0]) return false;
+    if (e >= (int32_t)ES_TABLE[last]) { td = T_MAX_C * 100; return true; }
+
+    int32_t lo = 0, hi = last;
+    while (hi - lo > 1) {
+        int32_t mid = (lo + hi) / 2;
+        if ((int32_t)ES_TABLE[mid] <= e) lo = mid;
+        else hi = mid;
+    }
+    int32_t span = ES_TABLE[hi] - ES_TABLE[lo];
+    td = (T_MIN_C + lo) * 100 + ((e - (int32_t)ES_TABLE[lo]) * 100) / span;
+    return true;
+}
+
+static uint32_t isqrt(uint32_t v) {
+    uint32_t r = 0, bit = 1UL << 30;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) { v -= r + bit; r = (r >> 1) + bit; }
+        else r >>= 1;
+        bit >>= 2;
+    }
+    return r;
+}
+
+// NOAA heat index with t/rh in 0.01 F / 0.01 %RH, result in 0.01 F.
+// Regression coefficients are scaled by 1e8; each term is reduced by
+// 100^(order - 1) so the sum stays in 0.01 F * 1e8.
+static int32_t heatIndexFixed(int32_t t, int32_t rh) {
+    int32_t hi = (t + 6100 + ((t - 6800) * 12) / 10 + (rh * 94) / 1000) / 2;
+    if ((hi + t) / 2 < 8000) return hi;
+
+    const int64_t T = t, R = rh;
+    int64_t acc = -4237900000LL * 100;
+    acc += 204901523LL * T;
+    acc += 1014333127LL * R;
+    acc -= (22475541LL * T * R) / 100;
+    acc -= (683783LL * T * T) / 100;
+    acc -= (5481717LL * R * R) / 100;
+    acc += (122874LL * T * T / 100 * R) / 100;
+    acc += (85282LL * T * R / 100 * R) / 100;
+    acc -= (199LL * T * T / 100 * R / 100 * R) / 100;
+    hi = (int32_t)(acc / 100000000LL);
+
+    if (rh < 1300 && t > 8000 && t < 11200) {
+        int32_t d = t - 9500;
+        if (d < 0) d = -d;
+        // sqrt((17 - |t-95|) / 17) in 1/1000
+        uint32_t s = isqrt((uint32_t)((1700 - d) * 10000LL / 17));
+        hi -= (int32_t)(((1300 - rh) / 4) * (int32_t)s / 1000);
+    } else if (rh > 8500 && t > 8000 && t < 8700) {
+        hi += (int32_t)(((int64_t)(rh - 8500) * (8700 - t)) / 5000);
+    }
+    return hi;
+}
+
+// exp(x) for x in Q24, |x| < ~0.5 (5th order series, error < 3e-5)
+static int64_t expQ24(int64_t x) {
+    const int64_t one = 1LL << 24;
+    int64_t term = one, sum = one;
+    for (int n = 1; n <= 5; n++) {
+        term = (term * x >> 24) / n;
+        sum += term;
+    }
+    return sum;
+}
+
+void DerivedMetrics::computeFixed(const AirData &air, float altitude, DerivedData &out) {
+    out = DerivedData();
+    if (!hasTemp(air)) return;
+
+    // Single float -> integer conversion per input
+    int32_t tc = (int32_t)lroundf(air.temperature * 100.0F);
+
+    if (hasHum(air)) {
+        int32_t rh = (int32_t)lroundf(air.humidity * 100.0F);
+        int32_t e = (int32_t)(((int64_t)esFixed(tc) * rh) / 10000); // 0.1 Pa
+
+        int32_t td;
+        if (dewPointFixed(e, td)) out.dewPoint = td * 0.01F;
+        // g/m3 = 2.1674 * e[Pa] / T[K]  ->  0.01 g/m3 = 2167.4 * e[0.1 Pa] / T[0.01 K]
+        out.absHumidity = (int32_t)(((int64_t)e * 21674) / ((tc + 27315) * 10)) * 0.01F;
+
+        int32_t tf = tc * 9 / 5 + 3200;
+        out.heatIndex = ((heatIndexFixed(tf, rh) - 3200) * 5 / 9) * 0.01F;
+        out.valid = true;
+    }
+
+    if (hasPres(air)) {
+        // Hypsometric form: P0 = P * exp(g*h / (Rd * Tm)), Tm = mean column temperature
+        int32_t h = (int32_t)lroundf(altitude);
+        int32_t pPa = (int32_t)lroundf(air.pressure * 100.0F);
+        int64_t tm = tc + 27315 + (h * 13) / 40; // 0.01 K, T + 0.00325 * h
+        // g/Rd = 0.034163 K/m  ->  x = 34163 * h / (1e4 * tm[0.01 K])
+        int64_t x = (((int64_t)34163 * h) << 24) / (10000 * tm);
+        int64_t p0 = ((int64_t)pPa * expQ24(x)) >> 24;
+        out.seaLevelPressure = (int32_t)p0 * 0.01F;
+        out.valid = true;
+    }
+}
+
+// --- Accuracy Check ---
+// Values right at the -40 C table edge may be available in only one path
+static float metricError(float ref, float fixed) {
+    if (ref == -999.0 || fixed == -999.0) return 0;
+    return fabsf(ref - fixed);
+}
+
+bool DerivedMetrics::checkAccuracy(Print &out) {
+    // Tolerances: what the display/API can resolve
+    const float TOL_DEW = 0.2F, TOL_HI = 0.3F, TOL_SLP = 0.5F, TOL_AH = 0.1F;
+    float errDew = 0, errHi = 0, errSlp = 0, errAh = 0;
+
+    for (int t = -20; t <= 45; t += 5) {
+        for (int rh = 10; rh <= 100; rh += 10) {
+            for (int alt = 0; alt <= 2000; alt += 500) {
+                AirData air;
+                air.temperature = t + 0.37F;
+                air.humidity = rh - 0.4F;
+                air.pressure = 1013.25F * powf(1.0F - 2.25577e-5F * alt, 5.25588F);
+                air.valid = true;
+
+                DerivedData f, x;
+                computeFloat(air, alt, f);
+                computeFixed(air, alt, x);
+                errDew = max(errDew, metricError(f.dewPoint, x.dewPoint));
+                errHi = max(errHi, metricError(f.heatIndex, x.heatIndex));
+                errSlp = max(errSlp, metricError(f.seaLevelPressure, x.seaLevelPressure));
+                errAh = max(errAh, metricError(f.absHumidity, x.absHumidity));
+            }
+        }
+    }
+
+    bool pass = errDew <= TOL_DEW && errHi <= TOL_HI && errSlp <= TOL_SLP && errAh <= TOL_AH;
+    out.printf("[Metrics] Fixed vs float max error: dew %.3f C, heat %.3f C, slp %.3f hPa, abs %.3f g/m3 -> %s\n",
+               errDew, errHi, errSlp, errAh, pass ? "OK" : "FAIL");
+    return pass;
+}
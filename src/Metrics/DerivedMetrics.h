@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Features.h"
+#include "Sensor/Sensor.h"
+
+// Derived weather values, computed once per sample and shared by the API,
+// display and serial log. -999.0 means "not available" (same sentinel as
+// AirData).
+struct DerivedData {
+    float dewPoint = -999.0;         // C
+    float heatIndex = -999.0;        // C
+    float seaLevelPressure = -999.0; // hPa
+    float absHumidity = -999.0;      // g/m3
+    bool valid = false;
+};
+
+// Two implementations with identical outputs:
+// - float: Magnus/NOAA/barometric formulas with logf/expf/powf
+// - fixed: integer-only, saturation vapour pressure from a 1 C lookup
+//   table and a short exp() series; selected by DLS_METRICS_FIXED_POINT
+//   for targets without an FPU (ESP32-C3).
+class DerivedMetrics {
+public:
+    void setAltitude(float meters) { _altitude = meters; }
+
+    // Recompute from a fresh sample; cheap to call when nothing is valid.
+    void update(const AirData &air);
+    const DerivedData &get() const { return _data; }
+
+    static void computeFloat(const AirData &air, float altitude, DerivedData &out);
+    static void computeFixed(const AirData &air, float altitude, DerivedData &out);
+
+    // Compares the fixed-point path against the float reference over the
+    // operating range; prints the worst error per metric.
+    static bool checkAccuracy(Print &out);
+
+private:
+    float _altitude = 0.0;
+    DerivedData _data;
+};
@@ -0,0 +1,136 @@
+#include "EventTrigger.h"
+
+// Index matches EventTrigger::_windows.
+static const EventRule RULES[] = {
+    {"temp_crash",     EVT_TEMPERATURE, -1, 3.0,  900, 1800}, // -3 C in 15 min (gust front)
+    {"humidity_jump",  EVT_HUMIDITY,    +1, 15.0, 900, 1800}, // +15 %RH in 15 min
+    {"pressure_drop",  EVT_PRESSURE,    -1, 1.0, 1800, 3600}, // -1 hPa in 30 min (squall)
+#if DLS_SENSOR_RAIN
+    {"rain_onset",     EVT_RAIN_RATE,   +1, 0.1,  300, 3600}, // Dry -> raining
+#endif
+};
+#define RULE_COUNT (sizeof(RULES) / sizeof(RULES[0]))
+static_assert(RULE_COUNT == EVENT_RULE_COUNT, "EVENT_RULE_COUNT out of sync with RULES");
+
+EventTrigger::EventTrigger() {
+    _tokens = EVENT_TOKENS_MAX;
+    for (uint8_t i = 0; i < RULE_COUNT; i++) {
+        reset(_windows[i], 0);
+        _windows[i].fired = false;
+    }
+}
+
+void EventTrigger::reset(Window &w, uint32_t nowMs) {
+    w.head = 0;
+    w.count = 0;
+    w.bucketStart = nowMs;
+    w.histMin = INFINITY;
+    w.histMax = -INFINITY;
+}
+
+const EventRule* EventTrigger::update(uint32_t nowMs, const AirData &air, float rainRate) {
+    float values[EVT_CHANNEL_COUNT];
+    values[EVT_TEMPERATURE] = air.valid ? air.temperature : -999.0;
+    values[EVT_HUMIDITY] = air.valid ? air.humidity : -999.0;
+    values[EVT_PRESSURE] = air.valid ? air.pressure : -999.0;
+#if DLS_SENSOR_RAIN
+    values[EVT_RAIN_RATE] = rainRate >= 0 ? rainRate : -999.0;
+#else
+    (void)rainRate;
+#endif
+
+    const EventRule* fired = nullptr;
+    for (uint8_t i = 0; i < RULE_COUNT; i++) {
+        float v = values[RULES[i].channel];
+        if (v == -999.0 || isnan(v)) continue;
+        if (feed(RULES[i], _windows[i], nowMs, v) && !fired) fired = &RULES[i];
+    }
+    return fired;
+}
+
+bool EventTrigger::feed(const EventRule &rule, Window &w, uint32_t nowMs, float value) {
+    uint32_t bucketMs = rule.windowS * 1000UL / EVENT_BUCKETS;
+
+    if (w.fired) {
+        if (nowMs - w.lastFire < rule.cooldownS * 1000UL) return false;
+        w.fired = false;
+        reset(w, nowMs);
+    }
+
+    // --- Advance buckets ---
+    if (w.count == 0) {
+        w.bucketStart = nowMs;
+    } else if (nowMs - w.bucketStart >= bucketMs) {
+        uint32_t steps = (nowMs - w.bucketStart) / bucketMs;
+        if (steps >= EVENT_BUCKETS) {
+            reset(w, nowMs); // Gap longer than the window (e.g. sensor outage)
+        } else {
+            w.bucketStart += steps * bucketMs;
+            while (steps--) {
+                w.head = (w.head + 1) % EVENT_BUCKETS;
+                if (w.count < EVENT_BUCKETS) w.count++;
+                w.bucketMin[w.head] = INFINITY; // Skipped buckets stay empty
+                w.bucketMax[w.head] = -INFINITY;
+            }
+            // Cache extremes of the completed buckets once per rollover
+            w.histMin = INFINITY;
+            w.histMax = -INFINITY;
+            for (uint8_t i = 1; i < w.count; i++) {
+                uint8_t b = (w.head + EVENT_BUCKETS - i) % EVENT_BUCKETS;
+                if (w.bucketMin[b] < w.histMin) w.histMin = w.bucketMin[b];
+                if (w.bucketMax[b] > w.histMax) w.histMax = w.bucketMax[b];
+            }
+        }
+    }
+    if (w.count == 0) {
+        w.count = 1;
+        w.bucketMin[w.head] = INFINITY;
+        w.bucketMax[w.head] = -INFINITY;
+    }
+
+    // --- Update the head bucket ---
+    if (value < w.bucketMin[w.head]) w.bucketMin[w.head] = value;
+    if (value > w.bucketMax[w.head]) w.bucketMax[w.head] = value;
+
+    // --- Evaluate against the window extremes ---
+    float windowMin = min(w.histMin, w.bucketMin[w.head]);
+    float windowMax = max(w.histMax, w.bucketMax[w.head]);
+    bool hit = (rule.direction <= 0 && value <= windowMax - rule.delta) ||
+               (rule.direction >= 0 && value >= windowMin + rule.delta);
+    if (!hit) return false;
+
+    w.fired = true;
+    w.lastFire = nowMs;
+    return true;
+}
+
+bool EventTrigger::takeToken(uint32_t nowMs) {
+    const uint32_t refillMs = EVENT_TOKEN_REFILL_S * 1000UL;
+    uint32_t earned = (nowMs - _lastRefill) / refillMs;
+    if (earned) {
+        _tokens += earned;
+        _lastRefill += earned * refillMs;
+    }
+    if (_tokens >= EVENT_TOKENS_MAX) {
+        _tokens = EVENT_TOKENS_MAX;
+        _lastRefill = nowMs; // Full bucket: the next token starts from now
+    }
+    if (_tokens < 1.0F) return false;
+    _tokens -= 1.0F;
+    return true;
+}
+
+void EventTrigger::printStatus(Print &out) {
+    out.printf("Event tokens: %.0f/%d\n", _tokens, EVENT_TOKENS_MAX);
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < RULE_COUNT; i++) {
+        const Window &w = _windows[i];
+        float lo = min(w.histMin, w.count ? w.bucketMin[w.head] : INFINITY);
+        float hi = max(w.histMax, w.count ? w.bucketMax[w.head] : -INFINITY);
+        out.printf("  %-14s %c%.1f/%lus ", RULES[i].name, RULES[i].direction < 0 ? '-' : '+',
+                   RULES[i].delta, (unsigned long)RULES[i].windowS);
+        if (w.fired) out.printf("cooldown %lus\n", (unsigned long)((RULES[i].cooldownS * 1000UL - (now - w.lastFire)) / 1000));
+        else if (w.count) out.printf("range %.2f..%.2f\n", lo, hi);
+        else out.println("no data");
+    }
+}
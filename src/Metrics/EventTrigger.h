@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Features.h"
+#include "Sensor/Sensor.h"
+
+// Rapid-change detection for out-of-band uploads.
+// Each rule watches one channel for a change of at least `delta` within
+// `windowS` seconds. The window is kept as EVENT_BUCKETS min/max buckets,
+// so a sample costs O(1) and the history is a fixed few hundred bytes
+// regardless of the sampling rate. A fired rule clears its window and
+// stays quiet for its cooldown.
+//
+// Extra uploads are paid from a token bucket (EVENT_TOKENS_MAX, one token
+// per EVENT_TOKEN_REFILL_S), so bursts of events cannot eat the API quota.
+
+#define EVENT_BUCKETS 16
+#define EVENT_RULE_COUNT (3 + DLS_SENSOR_RAIN)
+#define EVENT_TOKENS_MAX 2
+#define EVENT_TOKEN_REFILL_S 3600UL
+
+enum EventChannel : uint8_t {
+    EVT_TEMPERATURE,
+    EVT_HUMIDITY,
+    EVT_PRESSURE,
+#if DLS_SENSOR_RAIN
+    EVT_RAIN_RATE,
+#endif
+    EVT_CHANNEL_COUNT
+};
+
+struct EventRule {
+    const char* name;
+    EventChannel channel;
+    int8_t direction;   // -1 drop, +1 rise, 0 either
+    float delta;        // Channel units (C, %, hPa, mm/h)
+    uint32_t windowS;
+    uint32_t cooldownS;
+};
+
+class EventTrigger {
+public:
+    EventTrigger();
+
+    // Feed one sample (-999.0 / -1.0 placeholders and NaN are ignored).
+    // Returns the rule that fired, or nullptr.
+    const EventRule* update(uint32_t nowMs, const AirData &air, float rainRate);
+
+    // Takes one upload token if available.
+    bool takeToken(uint32_t nowMs);
+
+    void printStatus(Print &out);
+
+private:
+    struct Window {
+        float bucketMin[EVENT_BUCKETS];
+        float bucketMax[EVENT_BUCKETS];
+        uint8_t head;        // Bucket being filled
+        uint8_t count;       // Buckets holding data (including head)
+        uint32_t bucketStart;
+        float histMin;       // Over completed buckets, cached at rollover
+        float histMax;
+        uint32_t lastFire;
+        bool fired;
+    };
+
+    Window _windows[EVENT_RULE_COUNT];
+    float _tokens;
+    uint32_t _lastRefill = 0;
+
+    void reset(Window &w, uint32_t nowMs);
+    bool feed(const EventRule &rule, Window &w, uint32_t nowMs, float value);
+};
@@ -0,0 +1,333 @@
+#include "MqttClient.h"
+#include "Trace/Trace.h"
+#include "Log/Log.h"
+#include "Memory/Arena.h"
+
+// Packet types (upper nibble of the fixed header)
+#define MQTT_CONNECT  0x10
+#define MQTT_CONNACK  0x20
+#define MQTT_PUBLISH  0x30
+#define MQTT_PUBACK   0x40
+#define MQTT_PINGREQ  0xC0
+#define MQTT_PINGRESP 0xD0
+#define MQTT_DISCONNECT 0xE0
+
+#define MQTT_BODY 5 // Room in _buf for the fixed header
+
+static size_t putU16(uint8_t* p, uint16_t v) {
+    p[0] = v >> 8;
+    p[1] = v & 0xFF;
+    return 2;
+}
+
+static size_t putStr(uint8_t* p, const String &s) {
+    putU16(p, s.length());
+    memcpy(p + 2, s.c_str(), s.length());
+    return 2 + s.length();
+}
+
+void MqttClient::begin(const String &host, uint16_t port, const String &clientId,
+                       const String &user, const String &pass) {
+    _host = host;
+    _port = port;
+    _clientId = clientId;
+    _user = user;
+    _pass = pass;
+    if (!_outbox) {
+        // ~3.4 KB that is only touched when a message is queued or resent
+        static Arena arena("mqtt", MQTT_OUTBOX * sizeof(Message));
+        _outbox = arena.alloc<Message>(MQTT_OUTBOX);
+    }
+}
+
+void MqttClient::setWill(const String &topic, const String &payload) {
+    _willTopic = topic;
+    _willPayload = payload;
+}
+
+void MqttClient::setBirth(const String &topic, const String &payload) {
+    _birthTopic = topic;
+    _birthPayload = payload;
+}
+
+uint16_t MqttClient::publish(const char* topic, const char* payload, bool retain) {
+    size_t topicLen = strlen(topic);
+    size_t len = strlen(payload);
+    if (!_outbox || _count == MQTT_OUTBOX || topicLen >= MQTT_MAX_TOPIC || len > MQTT_MAX_PAYLOAD) {
+        _rejected++;
+        return 0;
+    }
+    Message &m = at(_count);
+    memcpy(m.topic, topic, topicLen + 1);
+    memcpy(m.payload, payload, len);
+    m.len = len;
+    m.id = _nextId++;
+    if (_nextId == 0) _nextId = 1; // 0 is not a valid packet id
+    m.retain = retain;
+    m.sent = false;
+    m.acked = false;
+    _count++;
+    return m.id;
+}
+
+// --- Wire ---
+bool MqttClient::writePacket(uint8_t header, size_t bodyLen) {
+    uint8_t fixed[5];
+    size_t n = 0;
+    fixed[n++] = header;
+    size_t rem = bodyLen;
+    do {
+        uint8_t b = rem % 128;
+        rem /= 128;
+        if (rem) b |= 0x80;
+        fixed[n++] = b;
+    } while (rem);
+    // Header right in front of the body: one write, one segment
+    uint8_t* start = _buf + MQTT_BODY - n;
+    memcpy(start, fixed, n);
+    size_t total = n + bodyLen;
+    if (_client.write(start, total) != total) return false;
+    _lastTx = millis();
+    return true;
+}
+
+int MqttClient::readByte() {
+    unsigned long start = millis();
+    while (!_client.available()) {
+        if (!_client.connected() || millis() - start > 1000) return -1;
+        delay(1);
+    }
+    return _client.read();
+}
+
+bool MqttClient::sendPublish(Message &m, bool dup) {
+    uint8_t* p = _buf + MQTT_BODY;
+    size_t topicLen = strlen(m.topic);
+    size_t n = putU16(p, topicLen);
+    memcpy(p + n, m.topic, topicLen);
+    n += topicLen;
+    n += putU16(p + n, m.id);
+    memcpy(p + n, m.payload, m.len);
+    n += m.len;
+
+    uint8_t header = MQTT_PUBLISH | 0x02; // QoS 1
+    if (dup) header |= 0x08;
+    if (m.retain) header |= 0x01;
+    if (!writePacket(header, n)) return false;
+    m.sent = true;
+    m.sentMs = millis();
+    return true;
+}
+
+bool MqttClient::connect() {
+    DLS_TRACE_SCOPE("mqtt.connect");
+    size_t need = 10 + 2 + _clientId.length() + 4 + _willTopic.length() + _willPayload.length() +
+                  4 + _user.length() + _pass.length();
+    if (need > sizeof(_buf) - MQTT_BODY) return false;
+    if (!_client.connect(_host.c_str(), _port, MQTT_CONNECT_TIMEOUT_MS)) return false;
+    _client.setNoDelay(true);
+
+    uint8_t flags = 0; // Clean session off: the broker keeps our QoS 1 state
+    uint8_t* p = _buf + MQTT_BODY;
+    size_t n = putStr(p, "MQTT");
+    p[n++] = 4; // Protocol level 3.1.1
+    size_t flagsAt = n++;
+    n += putU16(p + n, MQTT_KEEPALIVE_S);
+    n += putStr(p + n, _clientId);
+    if (_willTopic.length()) {
+        flags |= 0x04 | 0x08 | 0x20; // Will, QoS 1, retained
+        n += putStr(p + n, _willTopic);
+        n += putStr(p + n, _willPayload);
+    }
+    if (_user.length()) {
+        flags |= 0x80;
+        n += putStr(p + n, _user);
+        if (_pass.length()) {
+            flags |= 0x40;
+            n += putStr(p + n, _pass);
+        }
+    }
+    p[flagsAt] = flags;
+    if (!writePacket(MQTT_CONNECT, n)) {
+        _client.stop();
+        return false;
+    }
+
+    // CONNACK: 20 02 <session present> <return code>
+    uint8_t ack[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        int b = readByte();
+        if (b < 0) {
+            _client.stop();
+            return false;
+        }
+        ack[i] = b;
+    }
+    if (ack[0] != MQTT_CONNACK || ack[3] != 0) {
+        LOG_W("MQTT", "Baglanti reddedildi (kod %u)", ack[3]);
+        _client.stop();
+        return false;
+    }
+    _sessionPresent = ack[2] & 0x01;
+    _connected = true;
+    _pingSent = 0;
+    _connects++;
+
+    // Anything that was on the wire when the last connection died
+    for (uint8_t i = 0; i < _count; i++) {
+        Message &m = at(i);
+        if (m.sent && !m.acked) {
+            if (!sendPublish(m, true)) {
+                disconnect();
+                return false;
+            }
+            _resent++;
+        }
+    }
+    if (_birthTopic.length()) publish(_birthTopic.c_str(), _birthPayload.c_str(), true);
+    return true;
+}
+
+void MqttClient::disconnect() {
+    _client.stop();
+    _connected = false;
+    _pingSent = 0;
+}
+
+void MqttClient::handleAck(uint16_t id) {
+    for (uint8_t i = 0; i < _count; i++) {
+        Message &m = at(i);
+        if (m.sent && !m.acked && m.id == id) {
+            m.acked = true;
+            _published++;
+            break;
+        }
+    }
+    // Acks normally arrive in order; the outbox only frees from the front
+    while (_count && at(0).acked) {
+        if (_ackFn) _ackFn(_ackCtx, at(0).id);
+        _head = (_head + 1) % MQTT_OUTBOX;
+        _count--;
+    }
+}
+
+void MqttClient::readPackets() {
+    while (_connected && _client.available()) {
+        int header = readByte();
+        uint32_t len = 0;
+        uint8_t shift = 0;
+        int b;
+        do {
+            b = readByte();
+            if (b < 0) {
+                disconnect();
+                return;
+            }
+            len |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+        } while ((b & 0x80) && shift < 28);
+
+        // Only PUBACK carries a body we use; skip anything else
+        uint8_t body[2] = {};
+        for (uint32_t i = 0; i < len; i++) {
+            int c = readByte();
+            if (c < 0) {
+                disconnect();
+                return;
+            }
+            if (i < sizeof(body)) body[i] = c;
+        }
+
+        switch (header & 0xF0) {
+            case MQTT_PUBACK:
+                if (len >= 2) handleAck(((uint16_t)body[0] << 8) | body[1]);
+                break;
+            case MQTT_PINGRESP:
+                _pingSent = 0;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// --- Loop ---
+void MqttClient::loop(bool networkUp) {
+    if (_host.isEmpty()) return;
+    if (!networkUp) {
+        if (_connected) disconnect();
+        return;
+    }
+
+    if (!connected()) {
+        if (_connected) {
+            LOG_W("MQTT", "Baglanti koptu");
+            disconnect();
+        }
+        if (_retryAt && (long)(millis() - _retryAt) < 0) return;
+        if (!connect()) {
+            // Exponential backoff: 5 s, 10 s, ... 5 min
+            unsigned long wait = MQTT_BACKOFF_BASE_MS << (_fails < 6 ? _fails : 6);
+            if (wait > MQTT_BACKOFF_MAX_MS) wait = MQTT_BACKOFF_MAX_MS;
+            if (_fails < 255) _fails++;
+            _retryAt = millis() + wait;
+            LOG_W("MQTT", "%s:%u baglanilamadi, %lu sn sonra tekrar", _host.c_str(), _port, wait / 1000);
+            return;
+        }
+        _fails = 0;
+        _retryAt = 0;
+        LOG_I("MQTT", "Baglandi %s:%u (session %s)", _host.c_str(), _port, _sessionPresent ? "devam" : "yeni");
+    }
+
+    readPackets();
+    if (!_connected) return;
+
+    // Fill the in-flight window in outbox order
+    unsigned long now = millis();
+    uint8_t inflight = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        Message &m = at(i);
+        if (m.acked) continue;
+        if (m.sent) {
+            if (now - m.sentMs > MQTT_ACK_TIMEOUT_MS) {
+                // 3.1.1 only resends on a new connection
+                LOG_W("MQTT", "PUBACK gelmedi, yeniden baglaniliyor");
+                disconnect();
+                return;
+            }
+            inflight++;
+            continue;
+        }
+        if (inflight >= MQTT_INFLIGHT) break;
+        if (!sendPublish(m, false)) {
+            disconnect();
+            return;
+        }
+        inflight++;
+    }
+
+    // Keepalive
+    if (_pingSent) {
+        if (now - _pingSent > MQTT_ACK_TIMEOUT_MS) disconnect();
+    } else if (now - _lastTx > MQTT_KEEPALIVE_S * 1000UL / 2) {
+        if (writePacket(MQTT_PINGREQ, 0)) _pingSent = now;
+        else disconnect();
+    }
+}
+
+bool MqttClient::flush(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (_count && millis() - start < timeoutMs) {
+        loop(true);
+        if (!_connected && _retryAt) break; // Broker unreachable; do not wait out the backoff
+        delay(5);
+    }
+    return _count == 0;
+}
+
+void MqttClient::printStatus(Print &out) {
+    out.printf("MQTT: %s:%u %s, %u queued, %lu acked, %lu resent, %lu rejected, %lu connects\n",
+               _host.c_str(), _port, connected() ? "connected" : "offline", _count,
+               (unsigned long)_published, (unsigned long)_resent, (unsigned long)_rejected,
+               (unsigned long)_connects);
+}
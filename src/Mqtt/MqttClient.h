@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Minimal MQTT 3.1.1 publisher: QoS 1 only, no subscriptions.
+// The session is persistent (clean session off, stable client id), so
+// messages that were sent but not acknowledged are sent again with DUP
+// after a reconnect instead of being lost. Messages wait in a fixed
+// outbox; at most MQTT_INFLIGHT of them are on the wire unacknowledged at
+// once. The TCP connection stays open between uploads and is kept alive
+// with PINGREQ.
+//
+// connect() blocks for at most MQTT_CONNECT_TIMEOUT_MS; a broker that is
+// down is retried with an exponential backoff, like the Wi-Fi roaming.
+
+#define MQTT_KEEPALIVE_S 60
+#define MQTT_OUTBOX 4
+#define MQTT_INFLIGHT 2
+#define MQTT_MAX_TOPIC 64
+#define MQTT_MAX_PAYLOAD 768 // A full batch of samples
+#define MQTT_CONNECT_TIMEOUT_MS 2000
+#define MQTT_ACK_TIMEOUT_MS 10000   // No PUBACK: reconnect and resend
+#define MQTT_BACKOFF_BASE_MS 5000UL
+#define MQTT_BACKOFF_MAX_MS 300000UL
+
+class MqttClient {
+public:
+    typedef void (*AckFn)(void* ctx, uint16_t id);
+
+    void begin(const String &host, uint16_t port, const String &clientId,
+               const String &user, const String &pass);
+    // Retained QoS 1 will, sent by the broker when the node drops off, and
+    // the retained message queued on every connect to replace it
+    void setWill(const String &topic, const String &payload);
+    void setBirth(const String &topic, const String &payload);
+
+    // Queues a QoS 1 message and returns its packet id; 0 if the outbox is
+    // full or the message is too long
+    uint16_t publish(const char* topic, const char* payload, bool retain = false);
+
+    // Called with each packet id once its PUBACK arrived, in publish order
+    void onAck(AckFn fn, void* ctx) { _ackFn = fn; _ackCtx = ctx; }
+
+    void loop(bool networkUp); // Connects, reads acks, sends, pings; call every loop
+    bool flush(uint32_t timeoutMs); // Until every queued message is acknowledged
+    bool connected() { return _connected && _client.connected(); }
+    uint8_t pending() const { return _count; }
+    void printStatus(Print &out);
+
+private:
+    struct Message {
+        char topic[MQTT_MAX_TOPIC];
+        char payload[MQTT_MAX_PAYLOAD];
+        uint16_t len;
+        uint16_t id;
+        bool retain;
+        bool sent;  // On the wire, waiting for PUBACK
+        bool acked;
+        uint32_t sentMs;
+    };
+
+    bool connect();
+    void disconnect();
+    bool sendPublish(Message &m, bool dup);
+    void readPackets();
+    void handleAck(uint16_t id);
+    bool writePacket(uint8_t header, size_t bodyLen); // Body already at _buf + 5
+    int readByte();
+    Message &at(uint8_t i) { return _outbox[(_head + i) % MQTT_OUTBOX]; }
+
+    WiFiClient _client;
+    String _host;
+    uint16_t _port = 1883;
+    String _clientId;
+    String _user;
+    String _pass;
+    String _willTopic;
+    String _willPayload;
+    String _birthTopic;
+    String _birthPayload;
+
+    uint8_t _buf[5 + 2 + MQTT_MAX_TOPIC + 2 + MQTT_MAX_PAYLOAD]; // One packet
+    Message* _outbox = nullptr; // MQTT_OUTBOX entries from the "mqtt" arena
+    uint8_t _head = 0;
+    uint8_t _count = 0;
+    uint16_t _nextId = 1;
+    AckFn _ackFn = nullptr;
+    void* _ackCtx = nullptr;
+
+    bool _connected = false;
+    bool _sessionPresent = false;
+    unsigned long _lastTx = 0;
+    unsigned long _pingSent = 0;
+    unsigned long _retryAt = 0;
+    uint8_t _fails = 0;
+
+    uint32_t _published = 0;
+    uint32_t _resent = 0;
+    uint32_t _rejected = 0; // Outbox full
+    uint32_t _connects = 0;
+};
@@ -0,0 +1,184 @@
+#include "MqttPublisher.h"
+#include "Log/Log.h"
+#include <stdarg.h>
+
+struct MqttSample {
+    uint32_t ts;
+    float temp;
+    float hum;
+    float pres;
+    float dew;
+    float iaq;
+    float uv;
+};
+
+#define MQTT_BATCH_MAGIC 0x4D514232 // "MQB2"
+
+// Samples stay here until the broker acknowledged the message carrying
+// them; the leading `queued` ones are in the RAM outbox, split into the
+// messages listed in `msgs` (outbox order).
+struct MqttBatch {
+    uint32_t magic;
+    uint8_t count;
+    uint8_t queued;
+    uint8_t msgCount;
+    struct {
+        uint16_t id;
+        uint8_t samples;
+    } msgs[MQTT_OUTBOX];
+    MqttSample samples[MQTT_RTC_SAMPLES];
+};
+
+RTC_DATA_ATTR static MqttBatch s_batch;
+
+static void removeSamples(uint8_t first, uint8_t n) {
+    memmove(&s_batch.samples[first], &s_batch.samples[first + n],
+            (s_batch.count - first - n) * sizeof(MqttSample));
+    s_batch.count -= n;
+}
+
+// PUBACKs come in outbox order; ids that are not at the front (birth
+// message, a message whose samples were already dropped) are ignored
+static void onAck(void*, uint16_t id) {
+    if (!s_batch.msgCount || s_batch.msgs[0].id != id) return;
+    uint8_t n = s_batch.msgs[0].samples;
+    removeSamples(0, n);
+    s_batch.queued -= n;
+    s_batch.msgCount--;
+    memmove(&s_batch.msgs[0], &s_batch.msgs[1], s_batch.msgCount * sizeof(s_batch.msgs[0]));
+}
+
+void MqttPublisher::begin(const Config &config) {
+    if (config.getMqttHost().isEmpty()) return;
+    _enabled = true;
+    _batchSize = constrain(config.getMqttBatch(), 1, MQTT_BATCH_MAX);
+
+    String base = "dls/" + config.getStationID();
+    _sampleTopic = base + "/sample";
+    _batchTopic = base + "/batch";
+    _client.begin(config.getMqttHost(), config.getMqttPort(), "dls-" + config.getStationID(),
+                  config.getMqttUser(), config.getMqttPass());
+    _client.setWill(base + "/status", "offline");
+    _client.setBirth(base + "/status", "online");
+    _client.onAck(onAck, nullptr);
+
+    if (s_batch.magic != MQTT_BATCH_MAGIC) {
+        s_batch.magic = MQTT_BATCH_MAGIC;
+        s_batch.count = 0;
+    }
+    // The outbox did not survive the reset: unacked samples go out again
+    s_batch.queued = 0;
+    s_batch.msgCount = 0;
+}
+
+void MqttPublisher::loop(bool networkUp) {
+    if (!_enabled) return;
+    _client.loop(networkUp);
+    queueReady(); // Outbox slots freed by acks
+}
+
+void MqttPublisher::addSample(unsigned long epoch, const AirData &air, const LightData &light,
+                              const DerivedData &derived) {
+    if (!_enabled) return;
+    if (s_batch.count == MQTT_RTC_SAMPLES) {
+        // Broker out of reach for a long time: keep the newest samples. The
+        // oldest may already be in a message; that one is sent short.
+        removeSamples(0, 1);
+        if (s_batch.queued) {
+            s_batch.queued--;
+            if (--s_batch.msgs[0].samples == 0) {
+                s_batch.msgCount--;
+                memmove(&s_batch.msgs[0], &s_batch.msgs[1], s_batch.msgCount * sizeof(s_batch.msgs[0]));
+            }
+        }
+    }
+    MqttSample &s = s_batch.samples[s_batch.count++];
+    s.ts = epoch;
+    s.temp = air.valid ? air.temperature : -999.0;
+    s.hum = air.valid ? air.humidity : -999.0;
+    s.pres = air.valid ? air.pressure : -999.0;
+    s.dew = derived.dewPoint;
+    s.iaq = air.valid ? air.iaq : -999.0;
+    s.uv = light.valid ? light.uvIndex : -1.0;
+
+    queueReady();
+}
+
+void MqttPublisher::queueReady() {
+    // Oldest first; a batch goes out only once it is full. One outbox slot
+    // is left for the birth message queued on every connect.
+    while (s_batch.count - s_batch.queued >= _batchSize && s_batch.msgCount < MQTT_OUTBOX - 1) {
+        uint16_t id;
+        if (!publish(s_batch.queued, _batchSize, id)) break; // Outbox full
+        if (!id) {
+            removeSamples(s_batch.queued, _batchSize);
+            continue;
+        }
+        s_batch.msgs[s_batch.msgCount].id = id;
+        s_batch.msgs[s_batch.msgCount].samples = _batchSize;
+        s_batch.msgCount++;
+        s_batch.queued += _batchSize;
+    }
+}
+
+// Bounded writer: once the buffer is full further writes are dropped and
+// overflow stays set
+struct PayloadWriter {
+    char* buf;
+    size_t size;
+    size_t n;
+    bool overflow;
+
+    void add(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (overflow) return;
+        va_list args;
+        va_start(args, fmt);
+        int w = vsnprintf(buf + n, size - n, fmt, args);
+        va_end(args);
+        if (w < 0 || (size_t)w >= size - n) overflow = true;
+        else n += w;
+    }
+
+    void field(const char* key, float v, bool ok, int dec) {
+        if (ok) add(",\"%s\":%.*f", key, dec, v);
+    }
+
+    void sample(const MqttSample &s) {
+        add("{\"ts\":%lu", (unsigned long)s.ts);
+        field("t", s.temp, s.temp != -999.0, 2);
+        field("h", s.hum, s.hum != -999.0, 1);
+        field("p", s.pres, s.pres != -999.0, 2);
+        field("dp", s.dew, s.dew != -999.0, 1);
+        field("iaq", s.iaq, s.iaq != -999.0, 0);
+        field("uv", s.uv, s.uv != -1.0, 1);
+        add("}");
+    }
+};
+
+bool MqttPublisher::publish(uint8_t first, uint8_t n, uint16_t &id) {
+    char payload[MQTT_MAX_PAYLOAD + 1];
+    PayloadWriter out = {payload, sizeof(payload), 0, false};
+    if (_batchSize == 1) {
+        out.sample(s_batch.samples[first]);
+    } else {
+        out.add("[");
+        for (uint8_t i = 0; i < n; i++) {
+            if (i) out.add(",");
+            out.sample(s_batch.samples[first + i]);
+        }
+        out.add("]");
+    }
+    if (out.overflow) {
+        LOG_E("MQTT", "Paket %u bayti asiyor, atlandi", (unsigned)MQTT_MAX_PAYLOAD);
+        id = 0; // Would never fit; do not retry it forever
+        return true;
+    }
+    id = _client.publish(_batchSize == 1 ? _sampleTopic.c_str() : _batchTopic.c_str(), payload);
+    return id != 0;
+}
+
+void MqttPublisher::printStatus(Print &out) {
+    if (!_enabled) return;
+    _client.printStatus(out);
+    out.printf("  %u samples held, %u waiting for PUBACK, batch %u\n", s_batch.count, s_batch.queued, _batchSize);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Arduino.h>
+#include "MqttClient.h"
+#include "Config/Config.h"
+#include "Sensor/Sensor.h"
+#include "Metrics/DerivedMetrics.h"
+
+// MQTT output next to the DLSWeather uploader, enabled by "mqttHost".
+// Topics derive from the station ID:
+//   dls/<station>/sample  one sample per message ("mqttBatch": 1)
+//   dls/<station>/batch   JSON array of "mqttBatch" samples
+//   dls/<station>/status  retained "online", will "offline"
+// Samples are compact JSON with short keys; absent values are left out:
+//   {"ts":1718000000,"t":21.37,"h":55.2,"p":1013.25,"dp":11.8,"iaq":42,"uv":1.2}
+// Samples are kept in RTC memory until the broker acknowledged the message
+// carrying them, so a deep sleep node fills one batch over several
+// wake-ups, and samples taken while the broker is unreachable (or whose
+// PUBACK never came before sleep) go out on a later wake-up.
+
+#define MQTT_BATCH_MAX 8
+#define MQTT_RTC_SAMPLES 16 // Held until acked; the oldest is dropped when full
+#define MQTT_FLUSH_MS 3000 // Wait for PUBACKs before deep sleep
+
+class MqttPublisher {
+public:
+    void begin(const Config &config); // Does nothing without "mqttHost"
+    bool enabled() const { return _enabled; }
+    void loop(bool networkUp);
+
+    // Adds one sample; publishes when the batch is full
+    void addSample(unsigned long epoch, const AirData &air, const LightData &light, const DerivedData &derived);
+    bool flush(uint32_t timeoutMs = MQTT_FLUSH_MS) { return !_enabled || _client.flush(timeoutMs); }
+    void printStatus(Print &out);
+
+private:
+    void queueReady(); // Hands full batches to the outbox
+    // One message from samples[first..first+n); false if the outbox is full,
+    // id 0 if the message can never fit
+    bool publish(uint8_t first, uint8_t n, uint16_t &id);
+
+    MqttClient _client;
+    bool _enabled = false;
+    uint8_t _batchSize = 1;
+    String _sampleTopic;
+    String _batchTopic;
+};
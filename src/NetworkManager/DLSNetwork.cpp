@@ -1,14 +1,54 @@
 #include "DLSNetwork.h"
+#include "Trace/Trace.h"
+#include "Energy/Energy.h"
+#include "Trace/BootTimeline.h"
+#include "Log/Log.h"
+
+#define NET_LAST_AP_MAGIC 0x4C415031 // "LAP1"
+
+// AP of the last good connection; survives deep sleep, not power loss
+struct LastAp {
+    uint32_t magic;
+    uint32_t ssidHash; // Still a configured network?
+    uint8_t bssid[6];
+    uint8_t channel;
+};
+
+RTC_DATA_ATTR static LastAp s_lastAp;
+
+// FNV-1a
+static uint32_t ssidHash(const String &ssid) {
+    uint32_t h = 2166136261UL;
+    for (size_t i = 0; i < ssid.length(); i++) h = (h ^ (uint8_t)ssid[i]) * 16777619UL;
+    return h;
+}
 
 DLSNetwork::DLSNetwork() {
     _timeClient = new NTPClient(_ntpUDP, "pool.ntp.org", 0, 60000);
-    _lastReconnectAttempt = 0;
     _ledPin = -1;
+    memset(_backoff, 0, sizeof(_backoff));
+    memset(_blindBackoff, 0, sizeof(_blindBackoff));
+}
+
+bool DLSNetwork::addNetwork(const String &ssid, const String &pass) {
+    if (ssid.isEmpty() || _netCount >= NET_MAX_NETWORKS) return false;
+    for (uint8_t i = 0; i < _netCount; i++) {
+        if (_nets[i].ssid == ssid) return false;
+    }
+    _nets[_netCount].ssid = ssid;
+    _nets[_netCount].pass = pass;
+    _netCount++;
+    return true;
 }
 
 void DLSNetwork::begin(String ssid, String pass, int ledPin) {
-    _ssid = ssid;
-    _pass = pass;
+    // Primary network goes first so it wins RSSI ties
+    if (_netCount < NET_MAX_NETWORKS) {
+        for (uint8_t i = _netCount; i > 0; i--) _nets[i] = _nets[i - 1];
+        _netCount++;
+        _nets[0].ssid = ssid;
+        _nets[0].pass = pass;
+    }
     _ledPin = ledPin;
 
     if (_ledPin != -1) {
@@ -16,47 +56,276 @@ void DLSNetwork::begin(String ssid, String pass, int ledPin) {
         digitalWrite(_ledPin, LOW);
     }
 
-    Serial.print("Wi-Fi Baglaniyor...");
+    LOG_I("WiFi", "Baglaniyor (arka planda)...");
     WiFi.mode(WIFI_STA);
-    WiFi.begin(_ssid.c_str(), _pass.c_str());
-
-    int attempt = 0;
-    while (WiFi.status() != WL_CONNECTED && attempt < 20) {
-        if (_ledPin != -1) {
-            digitalWrite(_ledPin, HIGH);
-            delay(250);
-            digitalWrite(_ledPin, LOW);
-            delay(250);
-        } else {
-            delay(500);
+#if DLS_FEATURE_ENERGY
+    Energy::start(ENERGY_RADIO); // Stays on until deep sleep
+#endif
+    WiFi.setAutoReconnect(false); // Reconnects are chosen by the roaming logic
+
+    // After deep sleep go straight back to the last AP; otherwise scan first
+    // so the first connect goes to the best AP. Returns right away: scan,
+    // association and DHCP run while setup() probes the rest, and update()
+    // in the loop moves the state machine on.
+    if (!connectCached()) startScan(false);
+}
+
+bool DLSNetwork::connectCached() {
+    if (s_lastAp.magic != NET_LAST_AP_MAGIC || s_lastAp.channel == 0) return false;
+    uint8_t net = 0;
+    while (net < _netCount && ssidHash(_nets[net].ssid) != s_lastAp.ssidHash) net++;
+    if (net == _netCount) return false; // Config changed while asleep
+
+    Candidate &c = _candidates[0];
+    memcpy(c.bssid, s_lastAp.bssid, 6);
+    c.channel = s_lastAp.channel;
+    c.net = net;
+    c.rssi = 0; // Not scanned
+    _candidateCount = 1;
+    _nextCandidate = 0;
+    LOG_I("WiFi", "Son AP: %s ch%u, tarama yok", _nets[net].ssid.c_str(), c.channel);
+    _cachedTry = connectNext();
+    return _cachedTry;
+}
+
+void DLSNetwork::rememberAp() {
+    const uint8_t* bssid = WiFi.BSSID();
+    if (_currentNet < 0 || !bssid) return;
+    s_lastAp.magic = NET_LAST_AP_MAGIC;
+    s_lastAp.ssidHash = ssidHash(_nets[_currentNet].ssid);
+    memcpy(s_lastAp.bssid, bssid, 6); // Also right after a blind connect
+    s_lastAp.channel = WiFi.channel();
+}
+
+void DLSNetwork::setState(State state) {
+#if DLS_FEATURE_ENERGY
+    // Scans and association attempts count as connect time
+    bool wasBusy = _state == NET_SCANNING || _state == NET_CONNECTING;
+    bool busy = state == NET_SCANNING || state == NET_CONNECTING;
+    if (busy && !wasBusy) Energy::start(ENERGY_WIFI_CONNECT);
+    else if (!busy && wasBusy) Energy::stop(ENERGY_WIFI_CONNECT);
+#endif
+    _state = state;
+    _stateSince = millis();
+}
+
+DLSNetwork::Backoff* DLSNetwork::backoffFor(const Candidate &c, bool create) {
+    // Channel 0 is a blind connect to a hidden SSID: one slot per network
+    if (c.channel == 0) return &_blindBackoff[c.net];
+
+    Backoff* oldest = &_backoff[0];
+    for (Backoff &b : _backoff) {
+        if (b.fails && memcmp(b.bssid, c.bssid, 6) == 0) return &b;
+        if ((long)(b.until - oldest->until) < 0) oldest = &b;
+    }
+    if (!create) return nullptr;
+    memcpy(oldest->bssid, c.bssid, 6);
+    oldest->fails = 0;
+    oldest->until = 0;
+    return oldest;
+}
+
+bool DLSNetwork::backingOff(const Candidate &c) {
+    Backoff* b = backoffFor(c, false);
+    return b && b->fails && (long)(millis() - b->until) < 0;
+}
+
+void DLSNetwork::startScan(bool roam) {
+    _roamScan = roam;
+    _lastScan = millis();
+    WiFi.scanNetworks(true); // Async; collected in update()
+    setState(NET_SCANNING);
+}
+
+void DLSNetwork::collectScan() {
+    int16_t found = WiFi.scanComplete();
+    if (found == WIFI_SCAN_RUNNING) return;
+
+    // --- Rank known APs by RSSI ---
+    _candidateCount = 0;
+    for (int16_t i = 0; i < found; i++) {
+        String ssid = WiFi.SSID(i);
+        uint8_t net = 0;
+        while (net < _netCount && _nets[net].ssid != ssid) net++;
+        if (net == _netCount) continue;
+
+        Candidate c;
+        memcpy(c.bssid, WiFi.BSSID(i), 6);
+        c.channel = WiFi.channel(i);
+        c.net = net;
+        c.rssi = WiFi.RSSI(i);
+
+        // Insertion by RSSI, strongest first; weakest falls off a full list
+        uint8_t pos = _candidateCount;
+        while (pos > 0 && _candidates[pos - 1].rssi < c.rssi) pos--;
+        if (pos >= NET_MAX_CANDIDATES) continue;
+        uint8_t last = _candidateCount < NET_MAX_CANDIDATES ? _candidateCount : NET_MAX_CANDIDATES - 1;
+        for (uint8_t j = last; j > pos; j--) _candidates[j] = _candidates[j - 1];
+        _candidates[pos] = c;
+        if (_candidateCount < NET_MAX_CANDIDATES) _candidateCount++;
+    }
+    WiFi.scanDelete();
+    _nextCandidate = 0;
+
+    if (_roamScan) {
+        _roamScan = false;
+        setState(NET_ONLINE);
+        if (WiFi.status() != WL_CONNECTED) return; // Dropped meanwhile; update() handles it
+
+        // Roam only to a clearly stronger AP, never to the one in use
+        int32_t rssi = WiFi.RSSI();
+        const uint8_t* bssid = WiFi.BSSID();
+        for (uint8_t i = 0; i < _candidateCount; i++) {
+            const Candidate &c = _candidates[i];
+            if (bssid && memcmp(c.bssid, bssid, 6) == 0) continue;
+            if (backingOff(c)) continue;
+            if (c.rssi < rssi + NET_ROAM_HYSTERESIS) break; // Sorted: none better
+            LOG_I("WiFi", "Roaming: %d dBm -> %s %d dBm", (int)rssi, _nets[c.net].ssid.c_str(), (int)c.rssi);
+            _roams++;
+            _nextCandidate = i;
+            WiFi.disconnect();
+            connectNext();
+            return;
+        }
+        return;
+    }
+
+    // Nothing known in range: hidden SSIDs never show up in a scan, so fall
+    // back to a blind connect, one network per round, skipping networks
+    // that are backing off
+    if (_candidateCount == 0 && _netCount > 0) {
+        Candidate &c = _candidates[0];
+        memset(c.bssid, 0, sizeof(c.bssid));
+        c.channel = 0;
+        c.rssi = -127;
+        for (uint8_t n = 0; n < _netCount; n++) {
+            c.net = _blindNet++ % _netCount;
+            if (!backingOff(c)) break;
         }
-        Serial.print(".");
-        attempt++;
+        _candidateCount = 1;
+    }
+
+    if (!connectNext()) setState(NET_IDLE);
+}
+
+bool DLSNetwork::connectNext() {
+    while (_nextCandidate < _candidateCount) {
+        uint8_t i = _nextCandidate++;
+        Candidate &c = _candidates[i];
+        if (backingOff(c)) continue;
+
+        DLS_TRACE_SCOPE("wifi.reconnect");
+        _current = i;
+        _currentNet = c.net; // Survives the candidate list being rescanned
+        WiFi.begin(_nets[c.net].ssid.c_str(), _nets[c.net].pass.c_str(), c.channel,
+                   c.channel ? c.bssid : nullptr); // Channel 0: blind connect
+        setState(NET_CONNECTING);
+        return true;
     }
+    return false;
+}
 
-    if (WiFi.status() == WL_CONNECTED) {
-        if (_ledPin != -1) digitalWrite(_ledPin, HIGH); 
-        Serial.println("\nWi-Fi Baglandi!");
+void DLSNetwork::onConnected() {
+    BootTimeline::mark("wifi.up");
+    setState(NET_ONLINE);
+    _cachedTry = false;
+    _weakChecks = 0;
+    rememberAp();
+    if (_ledPin != -1) digitalWrite(_ledPin, HIGH);
+    if (_current >= 0) {
+        Backoff* b = backoffFor(_candidates[_current], false);
+        if (b) {
+            b->fails = 0;
+            b->until = 0;
+        }
+        LOG_I("WiFi", "%s (%d dBm)", _nets[_candidates[_current].net].ssid.c_str(), (int)WiFi.RSSI());
+    }
+    if (!_timeStarted) {
         _timeClient->begin();
-    } else {
-        if (_ledPin != -1) digitalWrite(_ledPin, LOW);
-        Serial.println("\nWi-Fi Basarisiz. Loop'ta tekrar denenecek.");
+        _timeStarted = true;
+    }
+#if DLS_FEATURE_MDNS
+    if (!_mdnsHost.isEmpty() && !_mdnsStarted) {
+        _mdnsStarted = true;
+        if (MDNS.begin(_mdnsHost.c_str())) {
+            LOG_I("mDNS", "baslatildi: %s.local", _mdnsHost.c_str());
+            // Add service to MDNS-SD
+            MDNS.addService("http", "tcp", 80);
+            // Custom service for DLS Weather discovery
+            MDNS.addService("dls_weather", "udp", 12345);
+        } else {
+            LOG_E("mDNS", "Hata: baslatilamadi!");
+        }
+    }
+#endif
+}
+
+void DLSNetwork::checkRoam() {
+    if (millis() - _lastRssiCheck < NET_RSSI_CHECK_MS) return;
+    _lastRssiCheck = millis();
+
+    if (WiFi.RSSI() >= NET_ROAM_RSSI) {
+        _weakChecks = 0;
+        return;
     }
+    if (++_weakChecks < NET_ROAM_CHECKS || millis() - _lastScan < NET_ROAM_SCAN_MS) return;
+    _weakChecks = 0;
+    startScan(true);
 }
 
 void DLSNetwork::update() {
-    // Wi-Fi Reconnect Logic
-    if (WiFi.status() != WL_CONNECTED) {
-        if (_ledPin != -1) digitalWrite(_ledPin, LOW);
-        
-        if (millis() - _lastReconnectAttempt > 15000) {
-            Serial.println("Wi-Fi Kopuk. Tekrar baglaniyor...");
-            WiFi.begin(_ssid.c_str(), _pass.c_str());
-            _lastReconnectAttempt = millis();
-        }
-    } else {
-         if (_ledPin != -1) digitalWrite(_ledPin, HIGH);
-         _timeClient->update();
+    // Blink while offline, solid once connected
+    if (_ledPin != -1 && _state != NET_ONLINE && !isConnected()) digitalWrite(_ledPin, (millis() / 250) & 1);
+
+    switch (_state) {
+        case NET_ONLINE:
+            if (WiFi.status() != WL_CONNECTED) {
+                if (_ledPin != -1) digitalWrite(_ledPin, LOW);
+                LOG_W("WiFi", "Kopuk. Tekrar baglaniyor...");
+                // Try the rest of the last ranking before paying for a scan
+                if (!connectNext()) setState(NET_IDLE);
+                break;
+            }
+            {
+                DLS_TRACE_SCOPE("ntp.update");
+                DLS_ENERGY_SCOPE(ENERGY_NTP);
+                if (_timeClient->update()) BootTimeline::mark("ntp.sync");
+            }
+            checkRoam();
+            break;
+
+        case NET_SCANNING:
+            collectScan();
+            break;
+
+        case NET_CONNECTING:
+            if (WiFi.status() == WL_CONNECTED) {
+                onConnected();
+            } else if (_cachedTry && millis() - _stateSince > NET_CACHED_TIMEOUT_MS) {
+                // Remembered AP gone or moved: forget it and rank a fresh scan
+                LOG_W("WiFi", "Son AP yanit vermedi, taraniyor");
+                _cachedTry = false;
+                s_lastAp.magic = 0;
+                WiFi.disconnect();
+                startScan(false);
+            } else if (millis() - _stateSince > NET_CONNECT_TIMEOUT_MS) {
+                // --- Per-AP exponential backoff ---
+                Candidate &c = _candidates[_current];
+                Backoff* b = backoffFor(c, true);
+                if (b->fails < 8) b->fails++;
+                unsigned long wait = NET_BACKOFF_BASE_MS << (b->fails - 1);
+                if (wait > NET_BACKOFF_MAX_MS) wait = NET_BACKOFF_MAX_MS;
+                b->until = millis() + wait;
+                LOG_W("WiFi", "%s yanit yok, %lu sn beklemede", _nets[c.net].ssid.c_str(), wait / 1000);
+                WiFi.disconnect();
+                if (!connectNext()) setState(NET_IDLE);
+            }
+            break;
+
+        case NET_IDLE:
+        default:
+            if (millis() - _lastScan >= NET_RESCAN_MS) startScan(false);
+            break;
     }
 }
 
@@ -64,6 +333,33 @@ bool DLSNetwork::isConnected() {
     return WiFi.status() == WL_CONNECTED;
 }
 
+bool DLSNetwork::isTimeSynced() {
+    return _timeStarted && _timeClient->isTimeSet();
+}
+
+const String &DLSNetwork::getSSID() const {
+    static const String none;
+    if (_currentNet >= 0) return _nets[_currentNet].ssid;
+    return _netCount ? _nets[0].ssid : none;
+}
+
+void DLSNetwork::printStatus(Print &out) {
+    static const char* const names[] = {"idle", "scanning", "connecting", "online"};
+    out.printf("WiFi: %s", names[_state]);
+    if (WiFi.status() == WL_CONNECTED) out.printf(", %s %d dBm", WiFi.SSID().c_str(), (int)WiFi.RSSI());
+    out.printf(", %lu roam\n", (unsigned long)_roams);
+    for (uint8_t i = 0; i < _candidateCount; i++) {
+        const Candidate &c = _candidates[i];
+        Backoff* b = backoffFor(c, false);
+        long wait = b && b->fails ? (long)(b->until - millis()) : 0;
+        out.printf("  %-16s %02x:%02x:%02x:%02x:%02x:%02x ch%u %d dBm", _nets[c.net].ssid.c_str(),
+                   c.bssid[0], c.bssid[1], c.bssid[2], c.bssid[3], c.bssid[4], c.bssid[5],
+                   c.channel, (int)c.rssi);
+        if (wait > 0) out.printf(" (backoff %ld s)", wait / 1000);
+        out.println();
+    }
+}
+
 unsigned long DLSNetwork::getEpochTime() {
     return _timeClient->getEpochTime();
 }
@@ -76,14 +372,8 @@ int DLSNetwork::getSeconds() {
     return _timeClient->getSeconds();
 }
 
+#if DLS_FEATURE_MDNS
 void DLSNetwork::startMDNS(const char* hostname) {
-    if (MDNS.begin(hostname)) {
-        Serial.printf("mDNS baslatildi: %s.local\n", hostname);
-        // Add service to MDNS-SD
-        MDNS.addService("http", "tcp", 80);
-        // Custom service for DLS Weather discovery
-        MDNS.addService("dls_weather", "udp", 12345); 
-    } else {
-        Serial.println("Hata: mDNS baslatilamadi!");
-    }
+    _mdnsHost = hostname; // Announced once the link is up
 }
+#endif
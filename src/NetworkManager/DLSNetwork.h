@@ -4,17 +4,48 @@
 #include <WiFi.h>
 #include <WiFiUdp.h>
 #include <NTPClient.h>
+#include "Config/Features.h"
+#if DLS_FEATURE_MDNS
 #include <ESPmDNS.h>
+#endif
+
+// --- Roaming ---
+// Known networks are matched against one scan and ranked by RSSI; each AP
+// (BSSID) that fails to connect is skipped for an exponentially growing
+// backoff. While connected, a weak link (below NET_ROAM_RSSI for
+// NET_ROAM_CHECKS checks in a row) triggers a background scan, and the
+// node moves when another known AP is NET_ROAM_HYSTERESIS dB stronger.
+// The AP in use is kept in RTC memory; after deep sleep the node connects
+// straight to it and only scans when that fails.
+#define NET_MAX_NETWORKS 4
+#define NET_MAX_CANDIDATES 8
+#define NET_CONNECT_TIMEOUT_MS 10000
+#define NET_CACHED_TIMEOUT_MS 4000 // Connect to the remembered AP, else scan
+#define NET_BACKOFF_BASE_MS 15000UL
+#define NET_BACKOFF_MAX_MS 300000UL
+#define NET_RESCAN_MS 15000UL      // Minimum gap between scans while offline
+#define NET_ROAM_RSSI -75          // dBm
+#define NET_ROAM_HYSTERESIS 8      // dB
+#define NET_ROAM_CHECKS 3
+#define NET_RSSI_CHECK_MS 10000UL
+#define NET_ROAM_SCAN_MS 120000UL  // Minimum gap between roam scans
 
 class DLSNetwork {
 public:
     DLSNetwork();
-    void begin(String ssid, String pass, int ledPin = -1);
+    // Register additional networks before begin(); begin() adds its own first
+    bool addNetwork(const String &ssid, const String &pass);
+    void begin(String ssid, String pass, int ledPin = -1); // Non-blocking
     void update();
-    void startMDNS(const char* hostname);
+#if DLS_FEATURE_MDNS
+    void startMDNS(const char* hostname); // Deferred until connected
+#endif
     
     // Status
     bool isConnected();
+    bool isTimeSynced(); // NTP answered at least once
+    const String &getSSID() const; // Network in use (or being tried)
+    void printStatus(Print &out);
     
     // Time
     unsigned long getEpochTime();
@@ -22,12 +53,68 @@ public:
     int getSeconds();
 
 private:
+    enum State {
+        NET_IDLE,       // Offline, waiting for the next scan slot
+        NET_SCANNING,   // Async scan running (offline or roam check)
+        NET_CONNECTING,
+        NET_ONLINE
+    };
+
+    struct Credential {
+        String ssid;
+        String pass;
+    };
+
+    struct Candidate {
+        uint8_t bssid[6];
+        uint8_t channel;
+        uint8_t net; // Index into _nets
+        int32_t rssi;
+    };
+
+    struct Backoff {
+        uint8_t bssid[6];
+        uint8_t fails;
+        unsigned long until;
+    };
+
     WiFiUDP _ntpUDP;
     NTPClient* _timeClient;
     
-    String _ssid;
-    String _pass;
+    Credential _nets[NET_MAX_NETWORKS];
+    uint8_t _netCount = 0;
     int _ledPin;
 
-    unsigned long _lastReconnectAttempt;
+    State _state = NET_IDLE;
+    Candidate _candidates[NET_MAX_CANDIDATES];
+    uint8_t _candidateCount = 0;
+    uint8_t _nextCandidate = 0;
+    int8_t _current = -1; // Candidate being tried / in use
+    int8_t _currentNet = -1;
+    Backoff _backoff[NET_MAX_CANDIDATES];
+    Backoff _blindBackoff[NET_MAX_NETWORKS]; // Hidden SSIDs have no BSSID; keyed by network
+    unsigned long _stateSince = 0;
+    unsigned long _lastScan = 0;
+    unsigned long _lastRssiCheck = 0;
+    uint8_t _weakChecks = 0;
+    uint8_t _blindNet = 0;
+    bool _roamScan = false;
+    bool _cachedTry = false; // Connecting to the AP remembered across sleep
+    bool _timeStarted = false;
+#if DLS_FEATURE_MDNS
+    String _mdnsHost;
+    bool _mdnsStarted = false;
+#endif
+    uint32_t _roams = 0;
+
+    bool connectCached();
+    void rememberAp();
+    void startScan(bool roam);
+    void collectScan();
+    bool connectNext();
+    void onConnected();
+    void checkRoam();
+    Backoff* backoffFor(const Candidate &c, bool create);
+    bool backingOff(const Candidate &c);
+    void setState(State state);
 };
@@ -0,0 +1,154 @@
+#include "OtaStream.h"
+#include <esp_rom_crc.h>
+
+// ROM inflater; the header lives in a per-target folder
+#if CONFIG_IDF_TARGET_ESP32C3
+#include <esp32c3/rom/miniz.h>
+#elif CONFIG_IDF_TARGET_ESP32S3
+#include <esp32s3/rom/miniz.h>
+#else
+#include <esp32/rom/miniz.h>
+#endif
+
+bool OtaInput::fill() {
+    if (pos < len) return true;
+    pos = len = 0;
+    if (broken) return false;
+    int n = source.read(buf, sizeof(buf));
+    if (n <= 0) {
+        broken = n < 0;
+        return false;
+    }
+    len = n;
+    total += n;
+    return true;
+}
+
+bool OtaInput::peek(size_t n) {
+    if (len - pos >= n) return true;
+    memmove(buf, buf + pos, len - pos);
+    len -= pos;
+    pos = 0;
+    while (len < n && !broken) {
+        int got = source.read(buf + len, sizeof(buf) - len);
+        if (got <= 0) {
+            broken = got < 0;
+            break;
+        }
+        len += got;
+        total += got;
+    }
+    return len >= n;
+}
+
+bool OtaStream::isGzip(OtaInput &in) {
+    return in.peek(2) && in.buf[in.pos] == 0x1f && in.buf[in.pos + 1] == 0x8b;
+}
+
+bool OtaStream::copyRaw(OtaInput &in, OtaSink &out, const char* &error) {
+    while (in.fill()) {
+        if (!out.write(in.buf + in.pos, in.len - in.pos)) {
+            error = out.error();
+            return false;
+        }
+        in.pos = in.len;
+    }
+    if (in.broken) {
+        error = "truncated";
+        return false;
+    }
+    return true;
+}
+
+// Skips a zero-terminated header field; false if the input ends first
+static bool skipString(OtaInput &in) {
+    int c;
+    while ((c = in.get()) > 0) {}
+    return c == 0;
+}
+
+bool OtaStream::inflateGzip(OtaInput &in, OtaSink &out, const char* &error) {
+    // --- Header (RFC 1952) ---
+    error = "gzip header";
+    uint8_t hdr[10];
+    for (int i = 0; i < 10; i++) {
+        int c = in.get();
+        if (c < 0) return false;
+        hdr[i] = c;
+    }
+    if (hdr[0] != 0x1f || hdr[1] != 0x8b) return false;
+    if (hdr[2] != 8) { error = "gzip method"; return false; } // Deflate only
+    uint8_t flags = hdr[3];
+    if (flags & 0x04) { // FEXTRA
+        int lo = in.get(), hi = in.get();
+        if (lo < 0 || hi < 0) return false;
+        for (int n = lo | (hi << 8); n > 0; n--) {
+            if (in.get() < 0) return false;
+        }
+    }
+    if ((flags & 0x08) && !skipString(in)) return false; // FNAME
+    if ((flags & 0x10) && !skipString(in)) return false; // FCOMMENT
+    if ((flags & 0x02) && (in.get() < 0 || in.get() < 0)) return false; // FHCRC
+
+    // --- Body: raw deflate into a wrapping 32 KB window ---
+    tinfl_decompressor* inflator = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+    uint8_t* window = (uint8_t*)malloc(TINFL_LZ_DICT_SIZE);
+    if (!inflator || !window) {
+        free(inflator);
+        free(window);
+        error = "no memory";
+        return false;
+    }
+    tinfl_init(inflator);
+
+    size_t windowOfs = 0;
+    uint32_t crc = 0;
+    uint32_t outTotal = 0;
+    bool ok = true;
+    for (;;) {
+        bool more = in.fill();
+        size_t inBytes = more ? in.len - in.pos : 0;
+        size_t outBytes = TINFL_LZ_DICT_SIZE - windowOfs;
+        tinfl_status status = tinfl_decompress(inflator, in.buf + in.pos, &inBytes,
+                                               window, window + windowOfs, &outBytes,
+                                               more ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+        in.pos += inBytes;
+
+        if (outBytes) {
+            if (!out.write(window + windowOfs, outBytes)) {
+                error = out.error();
+                ok = false;
+                break;
+            }
+            crc = esp_rom_crc32_le(crc, window + windowOfs, outBytes);
+            outTotal += outBytes;
+            windowOfs = (windowOfs + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+
+        if (status == TINFL_STATUS_DONE) break;
+        if (status < 0) {
+            error = more ? "inflate" : "truncated";
+            ok = false;
+            break;
+        }
+    }
+    free(inflator);
+    free(window);
+    if (!ok) return false;
+
+    // --- Trailer: CRC32 + ISIZE, little endian ---
+    uint32_t trailer[2] = {0, 0};
+    for (int i = 0; i < 8; i++) {
+        int c = in.get();
+        if (c < 0) {
+            error = "gzip trailer";
+            return false;
+        }
+        trailer[i / 4] |= (uint32_t)c << (8 * (i % 4));
+    }
+    if (trailer[0] != crc || trailer[1] != outTotal) {
+        error = "gzip crc";
+        return false;
+    }
+    return true;
+}
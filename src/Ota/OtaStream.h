@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Image framing for OTA (see OtaUpdater.h), kept apart from HTTP and Update
+// so it can be fed from memory on the host: raw .bin copy, and gzip
+// (RFC 1952) inflate with the header, CRC32 and ISIZE checks.
+
+#define OTA_IN_CHUNK 1024
+
+// Where the image bytes come from (the HTTP body on the device)
+class OtaSource {
+public:
+    virtual ~OtaSource() {}
+
+    // Up to len bytes into buf; 0 at the end of the body, -1 if the body
+    // broke off early or timed out
+    virtual int read(uint8_t* buf, size_t len) = 0;
+};
+
+// Where the decoded image goes (the inactive app partition on the device)
+class OtaSink {
+public:
+    virtual ~OtaSink() {}
+
+    virtual bool write(const uint8_t* data, size_t len) = 0;
+    virtual const char* error() const { return "write"; }
+};
+
+// Buffered reader over a source
+struct OtaInput {
+    OtaSource &source;
+    uint8_t buf[OTA_IN_CHUNK];
+    size_t pos = 0;
+    size_t len = 0;
+    uint32_t total = 0;   // Bytes received
+    bool broken = false;  // The source reported a cut-off body
+
+    explicit OtaInput(OtaSource &s) : source(s) {}
+
+    // Refill once the buffer is drained; false at the end of the body
+    bool fill();
+
+    // Buffer at least n (<= OTA_IN_CHUNK) bytes; false if the body is shorter
+    bool peek(size_t n);
+
+    int get() {
+        if (pos >= len && !fill()) return -1;
+        return buf[pos++];
+    }
+};
+
+namespace OtaStream {
+// Gzip magic at the start of the input; nothing is consumed. A body may
+// arrive one byte at a time, so this reads ahead as needed.
+bool isGzip(OtaInput &in);
+
+// Copies the body as is. On failure error names the cause.
+bool copyRaw(OtaInput &in, OtaSink &out, const char* &error);
+
+// Inflates one gzip member and checks its CRC32 and ISIZE trailer; bytes
+// reach the sink before the trailer is checked, so a failure must discard
+// what was written. On failure error names the cause.
+bool inflateGzip(OtaInput &in, OtaSink &out, const char* &error);
+}
@@ -0,0 +1,279 @@
+#include "OtaUpdater.h"
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <Update.h>
+#include <ArduinoJson.h>
+#include <esp_ota_ops.h>
+#include <esp_system.h>
+#include "Config/Version.h"
+#include "Log/Log.h"
+#include "Memory/Arena.h"
+#include "OtaStream.h"
+
+// HTTP body as an OTA source. remaining < 0 means "until the server
+// closes" (HTTP/1.0 without Content-Length).
+class OtaUpdater::HttpSource : public OtaSource {
+public:
+    HttpSource(WiFiClient &client, int32_t length) : _client(client), _remaining(length) {}
+
+    int read(uint8_t* buf, size_t len) override {
+        if (_remaining == 0) return 0;
+
+        unsigned long start = millis();
+        while (millis() - start < OTA_IO_TIMEOUT_MS) {
+            int avail = _client.available();
+            if (avail > 0) {
+                size_t want = len;
+                if (_remaining > 0 && want > (size_t)_remaining) want = _remaining;
+                if (want > (size_t)avail) want = avail;
+                int n = _client.read(buf, want);
+                if (n > 0) {
+                    if (_remaining > 0) _remaining -= n;
+                    return n;
+                }
+            } else if (!_client.connected()) {
+                return _remaining > 0 ? -1 : 0; // Closed before Content-Length: cut off
+            }
+            delay(1); // Yield to the sampling loop while the radio catches up
+        }
+        return -1;
+    }
+
+private:
+    WiFiClient &_client;
+    int32_t _remaining;
+};
+
+// Writes into the inactive app partition and keeps the progress counters
+class OtaUpdater::UpdateSink : public OtaSink {
+public:
+    UpdateSink(OtaUpdater &ota, const OtaInput &in) : _ota(ota), _in(in) {}
+
+    bool write(const uint8_t* data, size_t len) override {
+        if (Update.write(const_cast<uint8_t*>(data), len) != len) return false;
+        _ota._bytesIn = _in.total;
+        _ota._bytesOut = _ota._bytesOut + len;
+        return true;
+    }
+    const char* error() const override { return Update.errorString(); }
+
+private:
+    OtaUpdater &_ota;
+    const OtaInput &_in;
+};
+
+// "1.0.10" > "1.0.9"; missing components count as 0
+static int compareVersions(const char* a, const char* b) {
+    while (*a || *b) {
+        unsigned long va = strtoul(a, (char**)&a, 10);
+        unsigned long vb = strtoul(b, (char**)&b, 10);
+        if (va != vb) return va < vb ? -1 : 1;
+        if (*a == '.') a++;
+        if (*b == '.') b++;
+        if ((*a && !isdigit((unsigned char)*a)) || (*b && !isdigit((unsigned char)*b))) break;
+    }
+    return 0;
+}
+
+void OtaUpdater::begin(const String &baseUrl) {
+    _baseUrl = baseUrl;
+    while (_baseUrl.endsWith("/")) _baseUrl.remove(_baseUrl.length() - 1);
+
+    _prefs.begin("dls-ota", false);
+    if (!_prefs.getBool("pending", false)) return;
+
+    // A new image is on trial. Deep sleep wake-ups are normal operation and
+    // do not count; crashes, watchdog resets and power cycles do.
+    uint8_t boots = _prefs.getUChar("boots", 0);
+    if (esp_reset_reason() != ESP_RST_DEEPSLEEP) boots++;
+    _prefs.putUChar("boots", boots);
+    _pendingVerify = true;
+
+    LOG_I("OTA", "Yeni imaj deneniyor (%u/%u)", boots, OTA_MAX_TRIAL_BOOTS);
+    if (boots > OTA_MAX_TRIAL_BOOTS) {
+        _prefs.putBool("pending", false);
+        if (Update.canRollBack() && Update.rollBack()) {
+            LOG_E("OTA", "Imaj dogrulanamadi, onceki surume donuluyor...");
+            Log::flush();
+            ESP.restart();
+        }
+        LOG_E("OTA", "Geri donus yapilamadi, mevcut imaj ile devam.");
+        _pendingVerify = false;
+    }
+}
+
+void OtaUpdater::markValid() {
+    if (!_pendingVerify) return;
+    _pendingVerify = false;
+    _prefs.putBool("pending", false);
+    _prefs.putUChar("boots", 0);
+    esp_ota_mark_app_valid_cancel_rollback(); // Also confirms bootloader-level rollback if enabled
+    LOG_I("OTA", "Imaj dogrulandi (" DLS_FW_VERSION ")");
+}
+
+void OtaUpdater::update(bool networkUp) {
+    if (_baseUrl.isEmpty() || !networkUp || isBusy()) return;
+    if (_checkedOnce && millis() - _lastCheck < OTA_CHECK_INTERVAL_MS) return;
+    checkNow();
+}
+
+bool OtaUpdater::checkNow() {
+    if (isBusy() || _baseUrl.isEmpty()) return false;
+    _checkedOnce = true;
+    _lastCheck = millis();
+    _imageUrl = "";
+    _imageMd5 = "";
+    _state = OTA_CHECKING;
+    if (xTaskCreate(taskEntry, "ota", OTA_TASK_STACK, this, 1, nullptr) != pdPASS) {
+        fail("task");
+        return false;
+    }
+    return true;
+}
+
+bool OtaUpdater::startImage(const String &url, const String &md5) {
+    if (isBusy()) return false;
+    _imageUrl = url;
+    _imageMd5 = md5;
+    _state = OTA_DOWNLOADING;
+    if (xTaskCreate(taskEntry, "ota", OTA_TASK_STACK, this, 1, nullptr) != pdPASS) {
+        fail("task");
+        return false;
+    }
+    return true;
+}
+
+// Low priority so sampling, the web server and uploads preempt the download
+void OtaUpdater::taskEntry(void* arg) {
+    OtaUpdater* self = static_cast<OtaUpdater*>(arg);
+    if (self->_state == OTA_CHECKING) self->runCheck();
+    if (self->_state == OTA_DOWNLOADING) self->runDownload();
+    vTaskDelete(nullptr);
+}
+
+void OtaUpdater::runCheck() {
+    if (!fetchManifest()) return;
+    if (_imageUrl.isEmpty()) {
+        _state = OTA_IDLE; // Already up to date
+        return;
+    }
+    _state = OTA_DOWNLOADING;
+}
+
+bool OtaUpdater::fetchManifest() {
+    HTTPClient http;
+    http.setTimeout(OTA_IO_TIMEOUT_MS);
+    if (!http.begin(_baseUrl + "/manifest_update.json")) {
+        fail("manifest url");
+        return false;
+    }
+    int code = http.GET();
+    if (code != HTTP_CODE_OK) {
+        http.end();
+        fail("manifest http");
+        return false;
+    }
+
+    JsonDocument doc(&JsonAllocator::instance);
+    DeserializationError err = deserializeJson(doc, http.getString());
+    http.end();
+    if (err) {
+        fail("manifest json");
+        return false;
+    }
+
+    const char* version = doc["version"] | "";
+    if (compareVersions(version, DLS_FW_VERSION) <= 0) {
+        LOG_I("OTA", "Guncel (%s)", DLS_FW_VERSION);
+        return true;
+    }
+
+    // Prefer the compressed image; older manifests only list the installer parts
+    const char* path = doc["ota"]["path"] | "";
+    if (!*path) path = doc["builds"][0]["parts"][0]["path"] | "";
+    if (!*path) {
+        fail("manifest path");
+        return false;
+    }
+
+    _imageUrl = _baseUrl + "/" + path;
+    _imageMd5 = doc["ota"]["md5"] | "";
+    LOG_I("OTA", "Yeni surum %s -> %s", DLS_FW_VERSION, version);
+    return true;
+}
+
+void OtaUpdater::runDownload() {
+    _bytesIn = 0;
+    _bytesOut = 0;
+    _error[0] = '\0';
+    LOG_I("OTA", "Indiriliyor: %s", _imageUrl.c_str());
+
+    HTTPClient http;
+    http.useHTTP10(true); // No chunked encoding: the body is the raw image
+    http.setTimeout(OTA_IO_TIMEOUT_MS);
+    if (!http.begin(_imageUrl)) {
+        fail("image url");
+        return;
+    }
+    int code = http.GET();
+    if (code != HTTP_CODE_OK) {
+        http.end();
+        fail("image http");
+        return;
+    }
+
+    if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
+        http.end();
+        fail(Update.errorString());
+        return;
+    }
+    if (_imageMd5.length() == 32) Update.setMD5(_imageMd5.c_str());
+
+    HttpSource source(*http.getStreamPtr(), http.getSize());
+    OtaInput* in = new OtaInput(source); // Off the task stack
+    UpdateSink sink(*this, *in);
+    const char* error = "empty body";
+    bool ok = in->fill();
+    if (ok) {
+        ok = OtaStream::isGzip(*in) ? OtaStream::inflateGzip(*in, sink, error)
+                                    : OtaStream::copyRaw(*in, sink, error);
+    }
+    if (!ok) fail(error);
+    delete in;
+    http.end();
+
+    if (!ok) {
+        Update.abort();
+        return;
+    }
+    if (!Update.end(true)) { // Checks MD5 and the app image header
+        fail(Update.errorString());
+        return;
+    }
+
+    // Boot the new image on trial; begin() rolls it back if it never validates
+    _prefs.putBool("pending", true);
+    _prefs.putUChar("boots", 0);
+    _state = OTA_DONE;
+    LOG_I("OTA", "Tamamlandi: %u -> %u bayt, yeniden baslatiliyor...",
+          (unsigned)_bytesIn, (unsigned)_bytesOut);
+    Log::flush();
+    ESP.restart();
+}
+
+void OtaUpdater::fail(const char* msg) {
+    strncpy(_error, msg, sizeof(_error) - 1);
+    _error[sizeof(_error) - 1] = '\0';
+    _state = OTA_FAILED;
+    LOG_E("OTA", "Hata: %s", _error);
+}
+
+void OtaUpdater::printStatus(Print &out) const {
+    static const char* const names[] = {"idle", "checking", "downloading", "done", "failed"};
+    out.printf("OTA: %s, fw %s%s\n", names[_state], DLS_FW_VERSION, _pendingVerify ? " (deneme)" : "");
+    if (_state == OTA_DOWNLOADING || _state == OTA_DONE) {
+        out.printf("OTA: %u bayt alindi, %u bayt yazildi\n", (unsigned)_bytesIn, (unsigned)_bytesOut);
+    }
+    if (_state == OTA_FAILED) out.printf("OTA: hata %s\n", _error);
+    if (_baseUrl.length()) out.println("OTA URL: " + _baseUrl);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// Streaming OTA updates over plain HTTP.
+// The image is pulled in a background task and written straight into the
+// inactive app partition; gzip images (firmware.bin.gz from
+// copy_firmware.py) are inflated on the fly with the ROM inflater, so the
+// radio only carries the compressed size. Sampling and HTTP serving in
+// loop() keep running while the download is in progress.
+//
+// Verification: gzip CRC32 and ISIZE (see OtaStream.h), optional MD5 of the decompressed image and the
+// app image check done by Update.end(). Rollback: a freshly flashed image
+// boots "pending"; it must call markValid() (first successful upload)
+// within OTA_MAX_TRIAL_BOOTS boots, otherwise the previous slot is restored.
+
+#define OTA_MAX_TRIAL_BOOTS 3
+#define OTA_CHECK_INTERVAL_MS (6UL * 3600UL * 1000UL)
+#define OTA_TASK_STACK 6144
+#define OTA_IO_TIMEOUT_MS 15000
+
+enum OtaState {
+    OTA_IDLE,
+    OTA_CHECKING,
+    OTA_DOWNLOADING,
+    OTA_DONE,      // Image written, restarting
+    OTA_FAILED
+};
+
+class OtaUpdater {
+public:
+    // Handles the pending/rollback bookkeeping; call early in setup().
+    void begin(const String &baseUrl);
+
+    // Periodic manifest check (no-op without a base URL or while busy).
+    void update(bool networkUp);
+
+    // Compare <baseUrl>/manifest_update.json with DLS_FW_VERSION and
+    // download the advertised image if it is newer.
+    bool checkNow();
+
+    // Flash a specific image URL (.bin or .bin.gz); md5 may be empty.
+    bool startImage(const String &url, const String &md5);
+
+    // Confirm the running image after it proved itself (e.g. one upload).
+    void markValid();
+
+    OtaState getState() const { return _state; }
+    bool isBusy() const { return _state == OTA_CHECKING || _state == OTA_DOWNLOADING; }
+    void printStatus(Print &out) const;
+
+private:
+    Preferences _prefs;
+    String _baseUrl;
+    String _imageUrl;
+    String _imageMd5;
+    bool _pendingVerify = false;
+
+    volatile OtaState _state = OTA_IDLE;
+    volatile uint32_t _bytesIn = 0;  // Compressed bytes received
+    volatile uint32_t _bytesOut = 0; // Image bytes written
+    char _error[48] = "";
+    unsigned long _lastCheck = 0;
+    bool _checkedOnce = false;
+
+    static void taskEntry(void* arg);
+    void runCheck();
+    void runDownload();
+    bool fetchManifest();
+    class HttpSource;
+    class UpdateSink;
+    void fail(const char* msg);
+};
@@ -0,0 +1,67 @@
+#include "EspNowLink.h"
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include "Energy/Energy.h"
+
+static volatile int8_t s_sendStatus = -1; // -1 pending, else esp_now_send_status_t
+static RelayLink::ReceiveFn s_recvFn = nullptr;
+static void* s_recvCtx = nullptr;
+
+static void onSent(const uint8_t*, esp_now_send_status_t status) {
+    s_sendStatus = (int8_t)status;
+}
+
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+static void onRecv(const esp_now_recv_info_t* info, const uint8_t* data, int len) {
+    if (s_recvFn && len > 0) s_recvFn(s_recvCtx, info->src_addr, data, (size_t)len);
+}
+#else
+static void onRecv(const uint8_t* mac, const uint8_t* data, int len) {
+    if (s_recvFn && len > 0) s_recvFn(s_recvCtx, mac, data, (size_t)len);
+}
+#endif
+
+bool EspNowLink::begin() {
+    if (_started) return true;
+    if (WiFi.getMode() == WIFI_OFF) {
+        // Relay node: the radio is up for ESP-NOW only, never associates
+        WiFi.mode(WIFI_STA);
+#if DLS_FEATURE_ENERGY
+        Energy::start(ENERGY_RADIO); // Stays on until deep sleep
+#endif
+    }
+    if (esp_now_init() != ESP_OK) return false;
+    esp_now_register_send_cb(onSent);
+    esp_now_register_recv_cb(onRecv);
+    _started = true;
+    return true;
+}
+
+bool EspNowLink::setChannel(uint8_t channel) {
+    return esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE) == ESP_OK;
+}
+
+bool EspNowLink::addPeer(const uint8_t mac[6]) {
+    if (esp_now_is_peer_exist(mac)) return true;
+    esp_now_peer_info_t peer = {};
+    memcpy(peer.peer_addr, mac, 6);
+    peer.channel = 0; // Whatever channel the radio is on
+    peer.ifidx = WIFI_IF_STA;
+    peer.encrypt = false;
+    return esp_now_add_peer(&peer) == ESP_OK;
+}
+
+bool EspNowLink::send(const uint8_t mac[6], const uint8_t* data, size_t len) {
+    if (!_started || !addPeer(mac)) return false;
+    s_sendStatus = -1;
+    if (esp_now_send(mac, data, len) != ESP_OK) return false;
+    unsigned long start = millis();
+    while (s_sendStatus < 0 && millis() - start < ESPNOW_ACK_TIMEOUT_MS) delay(1);
+    return s_sendStatus == ESP_NOW_SEND_SUCCESS;
+}
+
+void EspNowLink::onReceive(ReceiveFn fn, void* ctx) {
+    s_recvCtx = ctx;
+    s_recvFn = fn;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "RelayLink.h"
+
+#define ESPNOW_ACK_TIMEOUT_MS 20 // Acks normally arrive within ~2 ms
+
+// ESP-NOW on the station interface. A gateway uses the channel of the AP it
+// is associated with; a node that never associates picks one with
+// setChannel(). Only one instance may exist (the IDF callbacks are global).
+class EspNowLink : public RelayLink {
+public:
+    bool begin() override;
+    bool setChannel(uint8_t channel) override;
+    bool send(const uint8_t mac[6], const uint8_t* data, size_t len) override;
+    void onReceive(ReceiveFn fn, void* ctx) override;
+
+private:
+    bool addPeer(const uint8_t mac[6]);
+
+    bool _started = false;
+};
@@ -0,0 +1,272 @@
+#include "Relay.h"
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+#include "Log/Log.h"
+
+static_assert(sizeof(RelayFrame) == 60, "RelayFrame layout changed; bump RELAY_VERSION");
+
+// ============================================================================
+// FRAME
+// ============================================================================
+
+static uint32_t clampScaled(float v, float scale, uint32_t max) {
+    float s = v * scale + 0.5f;
+    if (s <= 0) return 0;
+    return s >= (float)max ? max : (uint32_t)s;
+}
+
+void RelayFrame::encode(const char* stationId, float latitude, float longitude,
+                        const AirData &air, const LightData &light) {
+    memset(this, 0, sizeof(*this));
+    magic = RELAY_MAGIC;
+    version = RELAY_VERSION;
+    strncpy(station, stationId, RELAY_STATION_LEN - 1);
+    lat = latitude;
+    lon = longitude;
+
+    if (air.valid) {
+        if (air.temperature != -999.0 && air.temperature > -327 && air.temperature < 327) {
+            temperature = (int16_t)lroundf(air.temperature * 100);
+            flags |= RELAY_HAS_TEMP;
+        }
+        if (air.humidity != -999.0) {
+            humidity = clampScaled(air.humidity, 100, 10000);
+            flags |= RELAY_HAS_HUM;
+        }
+        if (air.pressure != -999.0) {
+            pressure = clampScaled(air.pressure, 100, 0xFFFFFFFF);
+            flags |= RELAY_HAS_PRES;
+        }
+        if (air.iaq != -999.0) {
+            iaq = clampScaled(air.iaq, 1, 500);
+            iaqAccuracy = air.iaqAccuracy;
+            flags |= RELAY_HAS_IAQ;
+        }
+    }
+    if (light.valid && light.uvIndex != -1.0) {
+        uvIndex = clampScaled(light.uvIndex, 100, 0xFFFF);
+        flags |= RELAY_HAS_UV;
+    }
+}
+
+bool RelayFrame::check(size_t len) const {
+    return len == sizeof(RelayFrame) && magic == RELAY_MAGIC && version == RELAY_VERSION &&
+           memchr(station, '\0', RELAY_STATION_LEN) != nullptr;
+}
+
+// ============================================================================
+// NODE
+// ============================================================================
+
+#define RELAY_STATE_MAGIC 0x52454C31 // "REL1"
+
+struct RelayNodeState {
+    uint32_t magic;
+    uint16_t boot;
+    uint16_t seq;
+    uint8_t channel; // Last channel the gateway acked on
+};
+
+RTC_DATA_ATTR static RelayNodeState s_node;
+
+// "AA:BB:CC:DD:EE:FF", followed by the end of the string or a separator
+static bool parseMac(const char* s, uint8_t mac[6]) {
+    unsigned int m[6];
+    int n = 0;
+    if (sscanf(s, "%2x:%2x:%2x:%2x:%2x:%2x%n", &m[0], &m[1], &m[2], &m[3], &m[4], &m[5], &n) != 6 || n != 17) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 6; i++) mac[i] = (uint8_t)m[i];
+    return true;
+}
+
+bool RelayNode::begin(RelayLink &link, const char* gatewayMac) {
+    if (!parseMac(gatewayMac, _gateway) || gatewayMac[17] != '\0') {
+        LOG_E("Relay", "Gecersiz gateway MAC: %s", gatewayMac);
+        return false;
+    }
+    _link = &link;
+    if (s_node.magic != RELAY_STATE_MAGIC) {
+        s_node.magic = RELAY_STATE_MAGIC;
+        s_node.boot = (uint16_t)esp_random();
+        s_node.seq = 0;
+        s_node.channel = 1;
+    }
+    return _link->begin();
+}
+
+bool RelayNode::trySend(uint8_t channel, const RelayFrame &frame) {
+    if (!_link->setChannel(channel)) return false;
+    return _link->send(_gateway, reinterpret_cast<const uint8_t*>(&frame), sizeof(frame));
+}
+
+bool RelayNode::send(RelayFrame &frame) {
+    if (!_link) return false;
+    frame.boot = s_node.boot;
+    frame.seq = ++s_node.seq;
+
+    bool ok = trySend(s_node.channel, frame);
+    for (uint8_t ch = 1; !ok && ch <= RELAY_MAX_CHANNEL; ch++) {
+        if (ch == s_node.channel) continue;
+        if (trySend(ch, frame)) {
+            LOG_I("Relay", "Gateway kanal %u -> %u", s_node.channel, ch);
+            s_node.channel = ch;
+            ok = true;
+        }
+    }
+    if (ok) _sent++;
+    else _failed++;
+    return ok;
+}
+
+void RelayNode::printStatus(Print &out) const {
+    out.printf("Relay: node -> %02x:%02x:%02x:%02x:%02x:%02x ch%u, seq %u, %lu sent, %lu failed\n",
+               _gateway[0], _gateway[1], _gateway[2], _gateway[3], _gateway[4], _gateway[5],
+               s_node.channel, s_node.seq, (unsigned long)_sent, (unsigned long)_failed);
+}
+
+// ============================================================================
+// GATEWAY
+// ============================================================================
+
+static portMUX_TYPE s_rxMux = portMUX_INITIALIZER_UNLOCKED;
+
+void RelayGateway::begin(RelayLink &link, const char* peers) {
+    parsePeers(peers);
+    if (_allowedCount == 0) LOG_W("Relay", "relayPeers bos, tum frameler reddedilecek!");
+    link.onReceive(onFrame, this);
+    if (!link.begin()) LOG_E("Relay", "ESP-NOW baslatilamadi!");
+}
+
+void RelayGateway::parsePeers(const char* list) {
+    _allowedCount = 0;
+    for (const char* p = list; p && *p;) {
+        while (*p == ' ') p++;
+        const char* end = strchr(p, ',');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        const char* eq = static_cast<const char*>(memchr(p, '=', len));
+        size_t stationLen = eq ? len - (eq - p) - 1 : 0;
+
+        if (_allowedCount < RELAY_MAX_PEERS && eq == p + 17 && stationLen > 0 &&
+            stationLen < RELAY_STATION_LEN && parseMac(p, _allowed[_allowedCount].mac)) {
+            Allowed &a = _allowed[_allowedCount++];
+            memcpy(a.station, eq + 1, stationLen);
+            a.station[stationLen] = '\0';
+        } else if (len > 0) {
+            LOG_W("Relay", "relayPeers girdisi yok sayildi: %.*s", (int)len, p);
+        }
+        p = end ? end + 1 : nullptr;
+    }
+}
+
+// Runs in the receive callback: a linear scan over at most RELAY_MAX_PEERS
+bool RelayGateway::isAllowed(const uint8_t mac[6], const RelayFrame &frame) const {
+    for (uint8_t i = 0; i < _allowedCount; i++) {
+        const Allowed &a = _allowed[i];
+        if (memcmp(a.mac, mac, 6) == 0) return strncmp(a.station, frame.station, RELAY_STATION_LEN) == 0;
+    }
+    return false;
+}
+
+void RelayGateway::onFrame(void* ctx, const uint8_t mac[6], const uint8_t* data, size_t len) {
+    RelayGateway* self = static_cast<RelayGateway*>(ctx);
+    const RelayFrame* frame = reinterpret_cast<const RelayFrame*>(data);
+    if (len != sizeof(RelayFrame) || !frame->check(len)) {
+        self->_invalid++;
+        return;
+    }
+    if (!self->isAllowed(mac, *frame)) {
+        self->_rejected++;
+        return;
+    }
+    portENTER_CRITICAL(&s_rxMux);
+    uint8_t next = (self->_rxHead + 1) % RELAY_RX_QUEUE;
+    if (next == self->_rxTail) {
+        self->_dropped++;
+    } else {
+        Entry &e = self->_rx[self->_rxHead];
+        memcpy(&e.frame, data, sizeof(RelayFrame));
+        memcpy(e.mac, mac, 6);
+        e.atMs = millis();
+        self->_rxHead = next;
+        self->_received++;
+    }
+    portEXIT_CRITICAL(&s_rxMux);
+}
+
+bool RelayGateway::isDuplicate(const Entry &e) {
+    Peer* peer = nullptr;
+    for (uint8_t i = 0; i < _peerCount; i++) {
+        if (memcmp(_peers[i].mac, e.mac, 6) == 0) peer = &_peers[i];
+    }
+    if (!peer) {
+        // New sender; only allowed MACs get here, so there is always room
+        peer = &_peers[_peerCount++];
+        memcpy(peer->mac, e.mac, 6);
+    } else if (peer->boot == e.frame.boot && (int16_t)(e.frame.seq - peer->seq) <= 0) {
+        return true; // Same boot, not newer
+    }
+    peer->boot = e.frame.boot;
+    peer->seq = e.frame.seq;
+    peer->lastMs = e.atMs;
+    return false;
+}
+
+void RelayGateway::update(bool uplinkReady, unsigned long epoch, RelayForwardFn forward) {
+    // Drain the receive queue into the batch
+    while (_rxTail != _rxHead) {
+        Entry e = _rx[_rxTail];
+        portENTER_CRITICAL(&s_rxMux);
+        _rxTail = (_rxTail + 1) % RELAY_RX_QUEUE;
+        portEXIT_CRITICAL(&s_rxMux);
+
+        if (isDuplicate(e)) {
+            _duplicates++;
+            continue;
+        }
+        if (_batchCount == RELAY_BATCH_SIZE) {
+            // Offline for long: keep the newest frames
+            memmove(&_batch[0], &_batch[1], (RELAY_BATCH_SIZE - 1) * sizeof(Entry));
+            _batchCount--;
+            _dropped++;
+        }
+        _batch[_batchCount++] = e;
+    }
+
+    if (_batchCount == 0 || !uplinkReady || !forward) return;
+    unsigned long now = millis();
+    if (_retryAt && (long)(now - _retryAt) < 0) return;
+    bool due = _flushNow || _batchCount == RELAY_BATCH_SIZE || now - _batch[0].atMs >= RELAY_BATCH_MS;
+    if (!due) return;
+
+    uint8_t done = 0;
+    while (done < _batchCount && done < RELAY_FORWARD_PER_UPDATE) {
+        const Entry &e = _batch[done];
+        unsigned long age = (now - e.atMs) / 1000;
+        if (!forward(e.frame, epoch - age)) break;
+        done++;
+    }
+    _forwarded += done;
+    _retryAt = 0;
+    if (done < _batchCount && done < RELAY_FORWARD_PER_UPDATE) {
+        LOG_W("Relay", "Aktarim basarisiz, %lu sn sonra tekrar", RELAY_RETRY_MS / 1000);
+        _retryAt = now + RELAY_RETRY_MS;
+    }
+    memmove(&_batch[0], &_batch[done], (_batchCount - done) * sizeof(Entry));
+    _batchCount -= done;
+    // The rest of a due batch goes out on the next calls
+    _flushNow = _batchCount > 0;
+}
+
+void RelayGateway::printStatus(Print &out) const {
+    out.printf("Relay: gateway, %u allowed, %lu rx, %lu dup, %lu invalid, %lu rejected, %lu forwarded, "
+               "%lu dropped, %u waiting\n",
+               _allowedCount, (unsigned long)_received, (unsigned long)_duplicates, (unsigned long)_invalid,
+               (unsigned long)_rejected, (unsigned long)_forwarded, (unsigned long)_dropped, _batchCount);
+    for (uint8_t i = 0; i < _peerCount; i++) {
+        const Peer &p = _peers[i];
+        out.printf("  %02x:%02x:%02x:%02x:%02x:%02x boot %04x seq %u, %lu s ago\n",
+                   p.mac[0], p.mac[1], p.mac[2], p.mac[3], p.mac[4], p.mac[5],
+                   p.boot, p.seq, (unsigned long)((millis() - p.lastMs) / 1000));
+    }
+}
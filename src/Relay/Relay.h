@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Features.h"
+#include "Sensor/Sensor.h"
+#include "RelayLink.h"
+
+// --- ESP-NOW Relay ---
+// A node out of Wi-Fi range ("relay": "node") sends each sample as one
+// RelayFrame to a Wi-Fi connected gateway ("relay": "gateway"), which
+// uploads it under the node's station ID. The node never associates or
+// asks for DHCP, so a wake-up costs the sensor read plus a few ms of radio.
+//
+// Frames carry a random per-boot id and a sequence number kept across deep
+// sleep; the gateway drops anything it has already seen from that sender,
+// e.g. a frame whose ack was lost and that the node sent again.
+//
+// The gateway only accepts frames from the nodes listed in "relayPeers"
+// ("AA:BB:CC:DD:EE:FF=ST-001,..."), and only under the station ID listed
+// for that MAC, so a stray node cannot upload under another station.
+
+#define RELAY_MAGIC 0xD5
+#define RELAY_VERSION 1
+#define RELAY_STATION_LEN 32
+#define RELAY_MAX_CHANNEL 13
+#define RELAY_RX_QUEUE 8            // Frames between the Wi-Fi task and loop()
+#define RELAY_BATCH_SIZE 16         // Frames waiting for upload at the gateway
+#define RELAY_BATCH_MS 30000UL      // A frame waits at most this long for company
+#define RELAY_FORWARD_PER_UPDATE 4  // Uploads per update() call, bounds the loop stall
+#define RELAY_RETRY_MS 60000UL      // After a failed upload
+#define RELAY_MAX_PEERS 8           // Allowed senders, tracked for de-duplication
+
+#define RELAY_HAS_TEMP  0x01
+#define RELAY_HAS_HUM   0x02
+#define RELAY_HAS_PRES  0x04
+#define RELAY_HAS_IAQ   0x08
+#define RELAY_HAS_UV    0x10
+
+// 60 bytes on air; fixed-point fields, absent values flagged off
+struct __attribute__((packed)) RelayFrame {
+    uint8_t magic;
+    uint8_t version;
+    uint16_t boot;       // Random per cold boot of the sender
+    uint16_t seq;        // Per frame, survives deep sleep
+    uint8_t flags;       // RELAY_HAS_*
+    uint8_t iaqAccuracy;
+    char station[RELAY_STATION_LEN]; // NUL-padded
+    float lat;
+    float lon;
+    int16_t temperature; // 0.01 C
+    uint16_t humidity;   // 0.01 %
+    uint32_t pressure;   // 0.01 hPa
+    uint16_t iaq;
+    uint16_t uvIndex;    // 0.01
+
+    void encode(const char* stationId, float latitude, float longitude,
+                const AirData &air, const LightData &light);
+    bool check(size_t len) const;
+
+    // Decoded values, with the repo's sentinels for absent fields
+    float temperatureC() const { return (flags & RELAY_HAS_TEMP) ? temperature / 100.0f : -999.0f; }
+    float humidityPct() const { return (flags & RELAY_HAS_HUM) ? humidity / 100.0f : -999.0f; }
+    float pressureHpa() const { return (flags & RELAY_HAS_PRES) ? pressure / 100.0f : -999.0f; }
+    float iaqIndex() const { return (flags & RELAY_HAS_IAQ) ? (float)iaq : -999.0f; }
+    float uvIdx() const { return (flags & RELAY_HAS_UV) ? uvIndex / 100.0f : -1.0f; }
+};
+
+// Sender side. The working channel is cached in RTC memory; when the
+// gateway stops answering on it (its AP moved), channels 1..13 are swept.
+class RelayNode {
+public:
+    bool begin(RelayLink &link, const char* gatewayMac); // "AA:BB:CC:DD:EE:FF"
+    bool send(RelayFrame &frame); // Stamps boot/seq; true once acked
+    void printStatus(Print &out) const;
+
+private:
+    bool trySend(uint8_t channel, const RelayFrame &frame);
+
+    RelayLink* _link = nullptr;
+    uint8_t _gateway[6] = {};
+    uint32_t _sent = 0;
+    uint32_t _failed = 0;
+};
+
+// Receiver side. Frames are queued by the link callback, de-duplicated in
+// update() and held in a batch that is uploaded once it is full, once its
+// oldest frame is RELAY_BATCH_MS old, or on flush().
+typedef bool (*RelayForwardFn)(const RelayFrame &frame, unsigned long epoch);
+
+class RelayGateway {
+public:
+    // peers: "MAC=station" entries separated by commas; frames from any
+    // other MAC, or under another station ID, are rejected
+    void begin(RelayLink &link, const char* peers);
+    // uplinkReady: connected and NTP synced; epoch stamps the frames
+    void update(bool uplinkReady, unsigned long epoch, RelayForwardFn forward);
+    void flush() { _flushNow = true; } // Upload on the next update()
+    void printStatus(Print &out) const;
+
+private:
+    struct Entry {
+        RelayFrame frame;
+        uint8_t mac[6];
+        uint32_t atMs;
+    };
+
+    struct Peer {
+        uint8_t mac[6];
+        uint16_t boot;
+        uint16_t seq;
+        uint32_t lastMs;
+    };
+
+    struct Allowed {
+        uint8_t mac[6];
+        char station[RELAY_STATION_LEN];
+    };
+
+    static void onFrame(void* ctx, const uint8_t mac[6], const uint8_t* data, size_t len);
+    void parsePeers(const char* list);
+    bool isAllowed(const uint8_t mac[6], const RelayFrame &frame) const;
+    bool isDuplicate(const Entry &e);
+
+    Entry _rx[RELAY_RX_QUEUE];
+    volatile uint8_t _rxHead = 0;
+    volatile uint8_t _rxTail = 0;
+    Entry _batch[RELAY_BATCH_SIZE];
+    uint8_t _batchCount = 0;
+    Peer _peers[RELAY_MAX_PEERS];
+    uint8_t _peerCount = 0;
+    Allowed _allowed[RELAY_MAX_PEERS];
+    uint8_t _allowedCount = 0;
+    bool _flushNow = false;
+    unsigned long _retryAt = 0;
+
+    uint32_t _received = 0;
+    uint32_t _invalid = 0;    // Wrong size, magic or version
+    uint32_t _rejected = 0;   // Not in relayPeers, or under another station
+    uint32_t _duplicates = 0;
+    uint32_t _forwarded = 0;
+    uint32_t _dropped = 0;    // Queue or batch overflow
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Transport used by the relay (see Relay.h). EspNowLink is the only real
+// implementation; the relay logic talks to this interface alone, so it can
+// be driven by a fake link that delivers, drops or duplicates frames.
+class RelayLink {
+public:
+    // Runs in the link's receive context (the Wi-Fi task for ESP-NOW):
+    // copy the frame and return, no blocking work
+    typedef void (*ReceiveFn)(void* ctx, const uint8_t mac[6], const uint8_t* data, size_t len);
+
+    virtual ~RelayLink() {}
+
+    virtual bool begin() = 0;
+    virtual bool setChannel(uint8_t channel) = 0;
+    // Unicast; true once the peer's radio acknowledged the frame
+    virtual bool send(const uint8_t mac[6], const uint8_t* data, size_t len) = 0;
+    virtual void onReceive(ReceiveFn fn, void* ctx) = 0;
+};
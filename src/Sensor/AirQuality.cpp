@@ -0,0 +1,103 @@
+#include "AirQuality.h"
+#include "Log/Log.h"
+
+#define IAQ_STATE_MAGIC 0x49415131 // "IAQ1"
+
+struct IaqState {
+    uint32_t magic;
+    float baseline; // Ohm
+    uint32_t ageS;  // Observed time behind the baseline
+    uint32_t savedAgeS; // ageS at the last NVS write
+};
+
+// Survives deep sleep; validated by magic after a cold boot
+RTC_DATA_ATTR static IaqState s_state;
+static IaqState s_liveState; // Parked here while a replay runs
+
+void AirQuality::begin() {
+    _prefs.begin("dls-iaq", false);
+
+    if (s_state.magic != IAQ_STATE_MAGIC) {
+        IaqState stored;
+        if (_prefs.getBytes("state", &stored, sizeof(stored)) == sizeof(stored) &&
+            stored.magic == IAQ_STATE_MAGIC) {
+            s_state = stored;
+            LOG_I("IAQ", "Baseline yuklendi: %.0f Ohm (%lu h)",
+                  s_state.baseline, (unsigned long)(s_state.ageS / 3600));
+        } else {
+            s_state.magic = IAQ_STATE_MAGIC;
+            s_state.baseline = 0;
+            s_state.ageS = 0;
+        }
+        s_state.savedAgeS = s_state.ageS;
+    }
+}
+
+void AirQuality::update(float gasOhm, float humidity, uint32_t dtSeconds) {
+    if (gasOhm <= 0) return;
+
+    // --- Baseline ---
+    if (s_state.baseline <= 0) {
+        s_state.baseline = gasOhm;
+    } else if (gasOhm > s_state.baseline) {
+        s_state.baseline += (gasOhm - s_state.baseline) * IAQ_BASELINE_RISE;
+    } else {
+        float k = dtSeconds / IAQ_BASELINE_TAU_S;
+        if (k > 1.0F) k = 1.0F;
+        s_state.baseline += (gasOhm - s_state.baseline) * k;
+    }
+    s_state.ageS += dtSeconds;
+
+    // --- Score (100 = best) ---
+    float humScore = IAQ_HUM_WEIGHT * 100.0F;
+    if (humidity != -999.0) {
+        float offset = humidity - IAQ_HUM_REFERENCE;
+        if (offset > 0) humScore *= (100.0F - IAQ_HUM_REFERENCE - offset) / (100.0F - IAQ_HUM_REFERENCE);
+        else humScore *= (IAQ_HUM_REFERENCE + offset) / IAQ_HUM_REFERENCE;
+        if (humScore < 0) humScore = 0;
+    }
+
+    float gasRatio = gasOhm / s_state.baseline;
+    if (gasRatio > 1.0F) gasRatio = 1.0F;
+    float gasScore = gasRatio * (100.0F - IAQ_HUM_WEIGHT * 100.0F);
+
+    _iaq = (100.0F - (humScore + gasScore)) * 5.0F;
+
+    persist(false);
+}
+
+void AirQuality::persist(bool force) {
+    if (_replay) return;
+    if (s_state.magic != IAQ_STATE_MAGIC || s_state.baseline <= 0) return;
+    if (s_state.ageS == s_state.savedAgeS) return; // Nothing learned since the last write
+    if (!force && s_state.ageS - s_state.savedAgeS < IAQ_SAVE_INTERVAL_S) return;
+    s_state.savedAgeS = s_state.ageS;
+    _prefs.putBytes("state", &s_state, sizeof(s_state));
+}
+
+uint8_t AirQuality::getAccuracy() const {
+    if (_iaq == -999.0) return 0;
+    if (s_state.ageS < 3600) return 1;
+    if (s_state.ageS < 86400) return 2;
+    return 3;
+}
+
+float AirQuality::getBaseline() const {
+    return s_state.baseline;
+}
+
+void AirQuality::setReplay(bool on) {
+    if (on == _replay) return;
+    _replay = on;
+    if (on) {
+        s_liveState = s_state;
+        _liveIaq = _iaq;
+        s_state.baseline = 0;
+        s_state.ageS = 0;
+        s_state.savedAgeS = 0;
+        _iaq = -999.0;
+    } else {
+        s_state = s_liveState;
+        _iaq = _liveIaq;
+    }
+}
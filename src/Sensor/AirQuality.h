@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// Incremental indoor-air-quality estimator for the BME680 gas channel.
+// Keeps a running clean-air baseline of the gas resistance: it follows
+// higher readings quickly and decays towards lower ones with a time
+// constant of days, so it adapts to sensor ageing but not to pollution.
+// The index combines gas (75%) and humidity (25%) deviation on the usual
+// 0 (excellent) .. 500 (hazardous) scale.
+//
+// The baseline survives deep sleep in RTC memory and power loss in NVS
+// (written every IAQ_SAVE_INTERVAL_S of observed time while awake, and once
+// before each deep sleep).
+
+#define IAQ_HUM_REFERENCE 40.0F        // %RH considered ideal
+#define IAQ_HUM_WEIGHT 0.25F           // Share of humidity in the score
+#define IAQ_BASELINE_RISE 0.2F         // Step towards a higher (cleaner) reading
+#define IAQ_BASELINE_TAU_S 604800.0F   // Downward drift time constant (7 days)
+#define IAQ_SAVE_INTERVAL_S 21600UL    // NVS write interval (6 h)
+
+class AirQuality {
+public:
+    void begin();
+
+    // Feed one gas reading (Ohm) taken dtSeconds after the previous one.
+    void update(float gasOhm, float humidity, uint32_t dtSeconds);
+
+    // Write the baseline to NVS if it changed; unless forced, only once per
+    // IAQ_SAVE_INTERVAL_S of observed time (flash wear).
+    void persist(bool force = false);
+
+    float getIAQ() const { return _iaq; }   // -999.0 until the first reading
+    uint8_t getAccuracy() const;            // 0 none, 1 <1 h, 2 <24 h, 3 stable
+    float getBaseline() const;
+
+    // Replay runs from a cold baseline on a scratch copy of the state, so
+    // results are repeatable and the learned baseline is neither changed
+    // nor written to NVS; leaving replay restores it.
+    void setReplay(bool on);
+
+private:
+    Preferences _prefs;
+    float _iaq = -999.0;
+    float _liveIaq = -999.0;
+    bool _replay = false;
+};
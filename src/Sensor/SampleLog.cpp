@@ -0,0 +1,126 @@
+#include "SampleLog.h"
+#include "Log/Log.h"
+
+bool SampleLog::mount() {
+    if (!_mounted) _mounted = LittleFS.begin(true); // Format on first use
+    if (!_mounted) LOG_E("Rec", "LittleFS baslatilamadi!");
+    return _mounted;
+}
+
+bool SampleLog::startRecording() {
+    if (_replaying || !mount()) return false;
+    stopRecording();
+
+    _out = LittleFS.open(SAMPLELOG_PATH, "w");
+    if (!_out) return false;
+    Header hdr = {SAMPLELOG_MAGIC, SAMPLELOG_VERSION, sizeof(SampleRecord)};
+    _out.write((const uint8_t*)&hdr, sizeof(hdr));
+    _written = 0;
+    _recording = true;
+    LOG_I("Rec", "Kayit basladi: " SAMPLELOG_PATH);
+    return true;
+}
+
+void SampleLog::stopRecording() {
+    if (!_recording) return;
+    _recording = false;
+    _out.close();
+    LOG_I("Rec", "Kayit durdu: %lu kayit", (unsigned long)_written);
+}
+
+void SampleLog::record(const SampleRecord &rec) {
+    if (!_recording) return;
+    if (sizeof(Header) + (_written + 1) * sizeof(SampleRecord) > SAMPLELOG_MAX_BYTES) {
+        LOG_W("Rec", "Dosya dolu");
+        stopRecording();
+        return;
+    }
+    _out.write((const uint8_t*)&rec, sizeof(rec));
+    _written++;
+    if ((_written & 31) == 0) _out.flush(); // Bound the loss on power cut
+}
+
+bool SampleLog::openForRead(File &f) {
+    f = LittleFS.open(SAMPLELOG_PATH, "r");
+    if (!f) return false;
+    Header hdr;
+    if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) || hdr.magic != SAMPLELOG_MAGIC ||
+        hdr.version != SAMPLELOG_VERSION || hdr.recordSize != sizeof(SampleRecord)) {
+        f.close();
+        return false;
+    }
+    return true;
+}
+
+bool SampleLog::startReplay(bool loop) {
+    if (!mount()) return false;
+    stopRecording();
+    stopReplay();
+    if (!openForRead(_airIn) || !openForRead(_lightIn)) {
+        _airIn.close();
+        LOG_W("Rec", "Gecerli kayit yok");
+        return false;
+    }
+    _loop = loop;
+    _replaying = true;
+    LOG_I("Rec", "Replay basladi (%lu kayit%s)", (unsigned long)recordCount(), loop ? ", dongu" : "");
+    return true;
+}
+
+void SampleLog::stopReplay() {
+    if (!_replaying) return;
+    _replaying = false;
+    _airIn.close();
+    _lightIn.close();
+    LOG_I("Rec", "Replay bitti");
+}
+
+bool SampleLog::next(SampleKind kind, SampleRecord &rec) {
+    if (!_replaying) return false;
+    File &in = (kind == SAMPLE_AIR) ? _airIn : _lightIn;
+
+    bool wrapped = false;
+    for (;;) {
+        if (in.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+            if (rec.kind == kind) return true;
+            continue; // Other stream's record
+        }
+        // End of file: a capture without this kind must not spin forever
+        if (!_loop || wrapped) break;
+        in.seek(sizeof(Header));
+        wrapped = true;
+    }
+    if (!_loop) stopReplay();
+    return false;
+}
+
+uint32_t SampleLog::recordCount() {
+    if (_recording) return _written;
+    if (!mount() || !LittleFS.exists(SAMPLELOG_PATH)) return 0;
+    File f = LittleFS.open(SAMPLELOG_PATH, "r");
+    size_t size = f ? f.size() : 0;
+    f.close();
+    return size > sizeof(Header) ? (size - sizeof(Header)) / sizeof(SampleRecord) : 0;
+}
+
+void SampleLog::dumpCsv(Print &out) {
+    File f;
+    if (_recording || !mount() || !openForRead(f)) {
+        out.println("REC_EMPTY");
+        return;
+    }
+    out.println("ms,kind,driver,ok,v0,v1,v2,v3");
+    SampleRecord rec;
+    while (f.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+        out.printf("%lu,%s,%u,%u,%.3f,%.3f,%.3f,%.3f\n", (unsigned long)rec.ms,
+                   rec.kind == SAMPLE_AIR ? "air" : "light", rec.driver, rec.ok,
+                   rec.v[0], rec.v[1], rec.v[2], rec.v[3]);
+    }
+    f.close();
+    out.println("REC_END");
+}
+
+void SampleLog::printStatus(Print &out) {
+    const char* state = _recording ? "kayit" : (_replaying ? "replay" : "bosta");
+    out.printf("Rec: %s, %lu kayit\n", state, (unsigned long)recordCount());
+}
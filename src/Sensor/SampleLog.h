@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+// Record / replay of raw sensor driver output.
+// While recording, every driver read is appended to LittleFS exactly as the
+// driver returned it (NaNs included), before any conversion or validation.
+// While replaying, Sensor takes its readings from the file instead of the
+// hardware and runs them through the same processing, so a captured storm
+// or a glitching sensor can be fed through metrics, display and upload code
+// as often as needed.
+
+#define SAMPLELOG_PATH "/samples.bin"
+#define SAMPLELOG_MAX_BYTES (256UL * 1024UL) // ~10k records
+#define SAMPLELOG_MAGIC 0x52534C44 // "DLSR"
+#define SAMPLELOG_VERSION 1
+
+enum SampleKind : uint8_t {
+    SAMPLE_AIR,
+    SAMPLE_LIGHT
+};
+
+// One driver read. v[] layout per kind:
+//   air:   temperature C, humidity %, pressure Pa, gas Ohm
+//   light: UVA, UVB, UV index, unused
+// Channels the driver does not provide hold -999.0.
+struct SampleRecord {
+    uint32_t ms;      // millis() at the read
+    uint8_t kind;     // SampleKind
+    uint8_t driver;   // SensorTypeAir / SensorTypeLight
+    uint8_t ok;       // Driver call reported success
+    uint8_t reserved;
+    float v[4];
+};
+
+class SampleLog {
+public:
+    bool startRecording();
+    void stopRecording();
+    bool isRecording() const { return _recording; }
+
+    // loop: start over at the end instead of stopping
+    bool startReplay(bool loop);
+    void stopReplay();
+    bool isReplaying() const { return _replaying; }
+
+    // Sensor hooks
+    void record(const SampleRecord &rec);
+    bool next(SampleKind kind, SampleRecord &rec);
+
+    uint32_t recordCount();
+    void dumpCsv(Print &out); // For pulling a capture over serial
+    void printStatus(Print &out);
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t recordSize;
+    };
+
+    File _out;
+    File _airIn;   // Separate cursors so air and light streams
+    File _lightIn; // replay independently
+    bool _mounted = false;
+    bool _recording = false;
+    bool _replaying = false;
+    bool _loop = false;
+    uint32_t _written = 0;
+
+    bool mount();
+    bool openForRead(File &f);
+};
@@ -1,124 +1,522 @@
 #include "Sensor.h"
+#include "Trace/Trace.h"
+#include "Energy/Energy.h"
+#include "Bus/I2CBus.h"
+#include "Log/Log.h"
+
+// --- Driver Power-Up Timing ---
+// bootMs: from rail on until the part answers on I2C.
+// readyMs: from re-configuration until the first conversion is readable
+// (0 for parts that convert on demand inside the read call).
+struct DriverTiming {
+    uint16_t bootMs;
+    uint16_t readyMs;
+};
+
+static DriverTiming airTiming(SensorTypeAir type) {
+    switch (type) {
+        case AIR_BME680: return {10, 0};   // Forced mode, converts in performReading()
+        case AIR_BME280: return {5, 100};  // Normal mode, x16 oversampling on all channels
+        case AIR_BMP280: return {5, 50};   // Normal mode, x16 T/P
+        case AIR_SHTC3:  return {1, 0};    // Single shot on demand
+        case AIR_SHT3X:  return {2, 0};    // Single shot on demand
+        default:         return {0, 0};
+    }
+}
+
+static DriverTiming lightTiming(SensorTypeLight type) {
+    switch (type) {
+        case LIGHT_VEML6075: return {5, 110}; // One 100 ms integration
+        default:             return {0, 0};
+    }
+}
+
+static I2CDevice airDevice(SensorTypeAir type) {
+    switch (type) {
+        case AIR_BME680: return I2C_DEV_BME680;
+        case AIR_BME280: return I2C_DEV_BME280;
+        case AIR_BMP280: return I2C_DEV_BMP280;
+        case AIR_SHTC3:  return I2C_DEV_SHTC3;
+        case AIR_SHT3X:  return I2C_DEV_SHT3X;
+        default:         return I2C_DEV_DEFAULT;
+    }
+}
 
 Sensor::Sensor() {}
 
+void Sensor::setPowerPin(int8_t pin) {
+    _powerPin = pin;
+    if (pin < 0) return;
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, HIGH);
+    _railOn = true;
+    _railOnMs = millis();
+}
+
 void Sensor::begin(TwoWire *wire) {
     _i2c = wire;
-    Serial.println("\n[Sensor] Taramasi Baslatiliyor...");
+
+    // Nothing is detected yet: wait for the slowest driver that may be fitted
+    // (normally long over, the rail went up at the start of setup())
+    uint16_t bootMs = lightTiming(LIGHT_VEML6075).bootMs;
+    for (uint8_t t = AIR_BME680; t <= AIR_SHT3X; t++) {
+        bootMs = max(bootMs, airTiming((SensorTypeAir)t).bootMs);
+    }
+    while (millis() - _railOnMs < bootMs) delay(1);
+
+    LOG_I("Sensor", "Taramasi Baslatiliyor...");
+    DLS_I2C_SCOPE(I2C_DEV_DEFAULT); // Unknown parts are probed at the slow clock
 
     // --- AIR SENSORS ---
-    if (_bme680.begin(0x76)) { // Try 0x76 first
-         _foundAirSensor = AIR_BME680;
-        Serial.println("[Sensor] BME680 (0x76) Tespit Edildi!");
-        _bme680.setTemperatureOversampling(BME680_OS_8X);
-        _bme680.setHumidityOversampling(BME680_OS_2X);
-        _bme680.setPressureOversampling(BME680_OS_4X);
-        _bme680.setIIRFilterSize(BME680_FILTER_SIZE_3);
-        _bme680.setGasHeater(320, 150);
-    } 
-    else if (_bme680.begin(0x77)) { // Try 0x77
+    // Probe order is fixed; drivers disabled in Features.h are skipped entirely.
+#if DLS_SENSOR_BME680
+    if (_foundAirSensor == AIR_NONE && _bme680.begin(0x76)) { // Try 0x76 first
         _foundAirSensor = AIR_BME680;
-        Serial.println("[Sensor] BME680 (0x77) Tespit Edildi!");
-        // Settings...
-         _bme680.setTemperatureOversampling(BME680_OS_8X);
-        _bme680.setHumidityOversampling(BME680_OS_2X);
-        _bme680.setPressureOversampling(BME680_OS_4X);
-        _bme680.setIIRFilterSize(BME680_FILTER_SIZE_3);
-        _bme680.setGasHeater(320, 150);
-    }
-    else if (_sht31.begin(0x44)) {
+        _airAddr = 0x76;
+        LOG_I("Sensor", "BME680 (0x76) Tespit Edildi!");
+        configureBME680();
+        _airQuality.begin();
+    }
+    if (_foundAirSensor == AIR_NONE && _bme680.begin(0x77)) { // Try 0x77
+        _foundAirSensor = AIR_BME680;
+        _airAddr = 0x77;
+        LOG_I("Sensor", "BME680 (0x77) Tespit Edildi!");
+        configureBME680();
+        _airQuality.begin();
+    }
+#endif
+#if DLS_SENSOR_SHT3X
+    if (_foundAirSensor == AIR_NONE && _sht31.begin(0x44)) {
         _foundAirSensor = AIR_SHT3X;
-        Serial.println("[Sensor] SHT3x Tespit Edildi!");
+        LOG_I("Sensor", "SHT3x Tespit Edildi!");
     }
-    else if (_shtc3.begin()) {
+#endif
+#if DLS_SENSOR_SHTC3
+    if (_foundAirSensor == AIR_NONE && _shtc3.begin()) {
         _foundAirSensor = AIR_SHTC3;
-        Serial.println("[Sensor] SHTC3 Tespit Edildi!");
+        LOG_I("Sensor", "SHTC3 Tespit Edildi!");
     }
-    else if (_bme280.begin(0x76)) {
+#endif
+#if DLS_SENSOR_BME280
+    if (_foundAirSensor == AIR_NONE && _bme280.begin(0x76)) {
         _foundAirSensor = AIR_BME280;
-        Serial.println("[Sensor] BME280 Tespit Edildi!");
+        LOG_I("Sensor", "BME280 Tespit Edildi!");
     }
-    else if (_bmp280.begin(0x76)) {
+#endif
+#if DLS_SENSOR_BMP280
+    if (_foundAirSensor == AIR_NONE && _bmp280.begin(0x76)) {
         _foundAirSensor = AIR_BMP280;
-        Serial.println("[Sensor] BMP280 Tespit Edildi!");
+        LOG_I("Sensor", "BMP280 Tespit Edildi!");
     }
-    else {
-        Serial.println("[Sensor] HICBIR HAVA SENSORU BULUNAMADI!");
+#endif
+    if (_foundAirSensor == AIR_NONE) {
+        LOG_E("Sensor", "HICBIR HAVA SENSORU BULUNAMADI!");
     }
 
     // --- LIGHT SENSORS ---
+#if DLS_SENSOR_VEML6075
     if (_veml6075.begin()) {
         _foundLightSensor = LIGHT_VEML6075;
-         Serial.println("[Sensor] VEML6075 (UV) Tespit Edildi!");
-    } else {
-        Serial.println("[Sensor] UV sensoru bulunamadi.");
+        LOG_I("Sensor", "VEML6075 (UV) Tespit Edildi!");
     }
+#endif
+    if (_foundLightSensor == LIGHT_NONE) {
+        LOG_W("Sensor", "UV sensoru bulunamadi.");
+    }
+}
+
+// --- Power Gating ---
+void Sensor::setPowerGating(bool enabled) {
+    _gating = enabled && _powerPin >= 0;
+    if (!_gating) powerUp(); // Leave the rail on and configured
+}
+
+void Sensor::setRail(bool on) {
+    if (_powerPin < 0 || on == _railOn) return;
+    digitalWrite(_powerPin, on ? HIGH : LOW);
+    _railOn = on;
+    if (!on) _needsReinit = true;
+}
+
+void Sensor::powerUp() {
+    if (_railOn && !_needsReinit) return;
+    DLS_TRACE_SCOPE("sensor.power");
+
+    DriverTiming air = airTiming(_foundAirSensor);
+    DriverTiming light = lightTiming(_foundLightSensor);
+    setRail(true);
+    delay(max(air.bootMs, light.bootMs));
+    I2CBus::checkLines(); // Cut mid-transfer last time: a part may hold SDA
+    reinitDrivers();
+    delay(max(air.readyMs, light.readyMs));
+    _needsReinit = false;
+}
+
+// --- Bus Faults ---
+// A degraded part gets a full begin() when its re-probe is due (calibration
+// is read again too: the part may have been power-cycled by a brown-out).
+bool Sensor::reprobeAir() {
+    switch (_foundAirSensor) {
+#if DLS_SENSOR_BME680
+        case AIR_BME680:
+            return _bme680.begin(_airAddr) && configureBME680();
+#endif
+#if DLS_SENSOR_SHT3X
+        case AIR_SHT3X:
+            return _sht31.begin(0x44);
+#endif
+#if DLS_SENSOR_SHTC3
+        case AIR_SHTC3:
+            return _shtc3.begin();
+#endif
+#if DLS_SENSOR_BME280
+        case AIR_BME280:
+            return _bme280.begin(0x76);
+#endif
+#if DLS_SENSOR_BMP280
+        case AIR_BMP280:
+            return _bmp280.begin(0x76);
+#endif
+        default:
+            return false;
+    }
+}
+
+bool Sensor::reprobeLight() {
+#if DLS_SENSOR_VEML6075
+    if (_foundLightSensor == LIGHT_VEML6075) return _veml6075.begin();
+#endif
+    return false;
+}
+
+// Calibration data stays in the driver objects; only the registers lost
+// with the rail are written again.
+void Sensor::reinitDrivers() {
+    // Degraded parts are skipped; the read path re-probes them when due
+    I2CDevice airDev = airDevice(_foundAirSensor);
+    if (!I2CBus::degraded(airDev)) {
+        DLS_I2C_SCOPE(airDev); // Air and light sensor each at their own clock
+        switch (_foundAirSensor) {
+#if DLS_SENSOR_BME680
+            case AIR_BME680:
+                if (!configureBME680()) I2CBus::report(I2C_DEV_BME680, false);
+                break;
+#endif
+#if DLS_SENSOR_BME280
+            case AIR_BME280:
+                _bme280.setSampling(); // Same defaults as begin()
+                break;
+#endif
+#if DLS_SENSOR_BMP280
+            case AIR_BMP280:
+                _bmp280.setSampling();
+                break;
+#endif
+            default:
+                break; // SHTC3/SHT3x keep no configuration
+        }
+    }
+
+#if DLS_SENSOR_VEML6075
+    if (_foundLightSensor == LIGHT_VEML6075 && !I2CBus::degraded(I2C_DEV_VEML6075)) {
+        DLS_I2C_SCOPE(I2C_DEV_VEML6075);
+        // begin() defaults; the part powers up shut down
+        _veml6075.setIntegrationTime(VEML6075_100MS);
+        _veml6075.setHighDynamic(false);
+        _veml6075.setForcedMode(false);
+        _veml6075.shutdown(false);
+    }
+#endif
+}
+
+bool Sensor::readAll(AirData &air, LightData &light) {
+    syncReplayState();
+    if (!_gating || _replayActive) {
+        bool ok = getAirData(air);
+        if (_gating && !_replayActive) return ok; // Capture just ended, rail is off
+        return getLightData(light) || ok;
+    }
+
+    DLS_ENERGY_SCOPE(ENERGY_SENSOR); // Settle time is paid for too
+    powerUp();
+    bool ok = getAirData(air);
+    ok = getLightData(light) || ok;
+    setRail(false);
+    return ok;
+}
+
+#if DLS_SENSOR_BME680
+bool Sensor::configureBME680() {
+    bool ok = _bme680.setTemperatureOversampling(BME680_OS_8X);
+    ok &= _bme680.setHumidityOversampling(BME680_OS_2X);
+    ok &= _bme680.setPressureOversampling(BME680_OS_4X);
+    ok &= _bme680.setIIRFilterSize(BME680_FILTER_SIZE_3);
+    ok &= _bme680.setGasHeater(0, 0); // Off until the scheduler asks for a gas reading
+    _heaterOn = false;
+    return ok;
+}
+
+void Sensor::readBME680Raw(SampleRecord &raw) {
+    // --- Gas Scheduler ---
+    // 320 C / 150 ms heater pulse only when a gas sample is due; otherwise a
+    // plain T/H/P conversion (no heater, much shorter).
+    bool gasDue = !_hasGasReading || (raw.ms - _lastGasMs >= _gasIntervalMs);
+    if (gasDue != _heaterOn) {
+        if (gasDue) _bme680.setGasHeater(320, 150);
+        else _bme680.setGasHeater(0, 0);
+        _heaterOn = gasDue;
+    }
+
+    DLS_TRACE_SCOPE(gasDue ? "bme680.read+gas" : "bme680.read");
+    raw.ok = _bme680.performReading();
+#if DLS_FEATURE_ENERGY
+    if (gasDue) Energy::add(ENERGY_HEATER, 150000UL); // Heater pulse set above
+#endif
+    if (!raw.ok) return;
+    raw.v[0] = _bme680.temperature;
+    raw.v[1] = _bme680.humidity;
+    raw.v[2] = _bme680.pressure;
+    if (gasDue && _bme680.gas_resistance > 0) raw.v[3] = _bme680.gas_resistance;
+}
+
+bool Sensor::processBME680(const SampleRecord &raw, AirData &data) {
+    if (!raw.ok) return false;
+
+    float gasOhm = raw.v[3];
+    if (gasOhm != -999.0) {
+        uint32_t dt = _hasGasReading ? (raw.ms - _lastGasMs) / 1000 : _gasIntervalMs / 1000;
+        _airQuality.update(gasOhm, raw.v[1], dt);
+        _lastGasMs = raw.ms;
+        _hasGasReading = true;
+    }
+
+    convertAir(raw.v[0], raw.v[1], raw.v[2], gasOhm, data);
+    if (gasOhm != -999.0) _lastGasKOhm = data.gasResistance;
+    else data.gasResistance = _lastGasKOhm; // Hold the last heated measurement
+
+    data.iaq = _airQuality.getIAQ();
+    data.iaqAccuracy = _airQuality.getAccuracy();
+    return true;
+}
+#endif
+
+void Sensor::saveState() {
+#if DLS_SENSOR_BME680
+    // One small NVS write per wake; a power cut while asleep loses nothing
+    if (_foundAirSensor == AIR_BME680) _airQuality.persist(true);
+#endif
+}
+
+void Sensor::convertAir(float temperature, float humidity, float pressurePa, float gasOhm, AirData &data) {
+    data.temperature = temperature;
+    data.humidity = humidity;
+    // Multiply instead of divide: no FPU on the C3, soft-float division is costlier
+    data.pressure = (pressurePa != -999.0) ? pressurePa * 0.01F : -999.0;
+    data.gasResistance = (gasOhm != -999.0) ? gasOhm * 0.001F : -999.0;
+}
+
+// Entering or leaving replay: the recorded clock and IAQ history are not
+// the live ones, so gas timing restarts and the IAQ state is swapped.
+void Sensor::syncReplayState() {
+    bool replaying = _log && _log->isReplaying();
+    if (replaying == _replayActive) return;
+    _replayActive = replaying;
+#if DLS_SENSOR_BME680
+    _hasGasReading = false;
+    _lastGasKOhm = -999.0;
+    _airQuality.setReplay(replaying);
+#endif
 }
 
 bool Sensor::getAirData(AirData &data) {
+    DLS_TRACE_SCOPE("sensor.air");
     data.valid = false;
-    
+
+    SampleRecord raw;
+    syncReplayState();
+    if (_replayActive) {
+        if (!_log->next(SAMPLE_AIR, raw)) {
+            syncReplayState(); // Capture ended; back to live reads next time
+            return false;
+        }
+    } else {
+        if (!readAirRaw(raw)) return false;
+        if (_log) _log->record(raw);
+    }
+
+    data.valid = processAir(raw, data);
+    return data.valid;
+}
+
+bool Sensor::readAirRaw(SampleRecord &raw) {
+    DLS_ENERGY_SCOPE(ENERGY_SENSOR);
+    raw.ms = millis();
+    raw.kind = SAMPLE_AIR;
+    raw.driver = _foundAirSensor;
+    raw.ok = true;
+    raw.reserved = 0;
+    for (float &v : raw.v) v = -999.0;
+    if (_foundAirSensor == AIR_NONE) return false;
+
+    // Degraded: skipped until the re-probe is due, so a dead part cannot
+    // stall every loop on bus timeouts
+    I2CDevice dev = airDevice(_foundAirSensor);
+    if (!I2CBus::ready(dev)) return false;
+    DLS_I2C_SCOPE(dev);
+    if (I2CBus::degraded(dev) && !reprobeAir()) {
+        I2CBus::report(dev, false);
+        return false;
+    }
+
     switch (_foundAirSensor) {
+#if DLS_SENSOR_BME680
         case AIR_BME680:
-            if (_bme680.performReading()) {
-                data.temperature = _bme680.temperature;
-                data.humidity = _bme680.humidity;
-                data.pressure = _bme680.pressure / 100.0F;
-                data.gasResistance = _bme680.gas_resistance / 1000.0;
-                data.valid = true;
-            }
+            readBME680Raw(raw);
             break;
+#endif
 
+#if DLS_SENSOR_SHT3X
         case AIR_SHT3X:
-            data.temperature = _sht31.readTemperature();
-            data.humidity = _sht31.readHumidity();
-            data.valid = (!isnan(data.temperature) && !isnan(data.humidity));
+            raw.v[0] = _sht31.readTemperature(); // NaN on CRC/bus errors
+            raw.v[1] = _sht31.readHumidity();
             break;
+#endif
 
-        case AIR_SHTC3:
-            sensors_event_t h, t;
-            _shtc3.getEvent(&h, &t);
-            data.temperature = t.temperature;
-            data.humidity = h.relative_humidity;
-            data.valid = true;
+#if DLS_SENSOR_SHTC3
+        case AIR_SHTC3: {
+            sensors_event_t h = {}, t = {};
+            raw.ok = _shtc3.getEvent(&h, &t);
+            if (raw.ok) {
+                raw.v[0] = t.temperature;
+                raw.v[1] = h.relative_humidity;
+            }
             break;
+        }
+#endif
 
+#if DLS_SENSOR_BME280
         case AIR_BME280:
-            data.temperature = _bme280.readTemperature();
-            data.humidity = _bme280.readHumidity();
-            data.pressure = _bme280.readPressure() / 100.0F;
-            data.valid = true;
+            raw.v[0] = _bme280.readTemperature();
+            raw.v[1] = _bme280.readHumidity();
+            raw.v[2] = _bme280.readPressure();
             break;
+#endif
 
+#if DLS_SENSOR_BMP280
         case AIR_BMP280:
-            data.temperature = _bmp280.readTemperature();
-            data.pressure = _bmp280.readPressure() / 100.0F;
-            data.valid = true;
+            raw.v[0] = _bmp280.readTemperature();
+            raw.v[2] = _bmp280.readPressure();
             break;
-            
+#endif
+
         case AIR_NONE:
         default:
             return false;
     }
+    // Drivers report NaN (SHT3x, BMx280) or false (BME680, SHTC3) on bus errors
+    I2CBus::report(dev, raw.ok && !isnan(raw.v[0]));
+    return true;
+}
 
-    return data.valid;
+bool Sensor::processAir(const SampleRecord &raw, AirData &data) {
+    switch (raw.driver) {
+#if DLS_SENSOR_BME680
+        case AIR_BME680:
+            return processBME680(raw, data);
+#endif
+
+#if DLS_SENSOR_SHT3X
+        case AIR_SHT3X:
+            data.temperature = raw.v[0];
+            data.humidity = raw.v[1];
+            return raw.ok && !isnan(data.temperature) && !isnan(data.humidity);
+#endif
+
+#if DLS_SENSOR_SHTC3
+        case AIR_SHTC3:
+            data.temperature = raw.v[0];
+            data.humidity = raw.v[1];
+            return raw.ok && !isnan(data.temperature) && !isnan(data.humidity);
+#endif
+
+#if DLS_SENSOR_BME280
+        case AIR_BME280:
+            convertAir(raw.v[0], raw.v[1], raw.v[2], -999.0, data);
+            return raw.ok && !isnan(raw.v[0]) && !isnan(raw.v[1]) && !isnan(raw.v[2]);
+#endif
+
+#if DLS_SENSOR_BMP280
+        case AIR_BMP280:
+            convertAir(raw.v[0], -999.0, raw.v[2], -999.0, data);
+            return raw.ok && !isnan(raw.v[0]) && !isnan(raw.v[2]);
+#endif
+
+        default:
+            return false; // Driver not built into this image
+    }
 }
 
 bool Sensor::getLightData(LightData &data) {
+    DLS_TRACE_SCOPE("sensor.light");
     data.valid = false;
 
+    SampleRecord raw;
+    syncReplayState();
+    if (_replayActive) {
+        if (!_log->next(SAMPLE_LIGHT, raw)) return false;
+    } else {
+        if (!readLightRaw(raw)) return false;
+        if (_log) _log->record(raw);
+    }
+
+    data.valid = processLight(raw, data);
+    return data.valid;
+}
+
+bool Sensor::readLightRaw(SampleRecord &raw) {
+    DLS_ENERGY_SCOPE(ENERGY_SENSOR);
+    raw.ms = millis();
+    raw.kind = SAMPLE_LIGHT;
+    raw.driver = _foundLightSensor;
+    raw.ok = true;
+    raw.reserved = 0;
+    for (float &v : raw.v) v = -999.0;
+
     switch (_foundLightSensor) {
-        case LIGHT_VEML6075:
-            data.uva = _veml6075.readUVA();
-            data.uvb = _veml6075.readUVB();
-            data.uvIndex = _veml6075.readUVI();
-            data.valid = true;
+#if DLS_SENSOR_VEML6075
+        case LIGHT_VEML6075: {
+            if (!I2CBus::ready(I2C_DEV_VEML6075)) return false;
+            DLS_I2C_SCOPE(I2C_DEV_VEML6075);
+            // The driver has no error path; an address ping stands in for it
+            bool ok = I2CBus::ping(0x10);
+            if (ok && I2CBus::degraded(I2C_DEV_VEML6075)) ok = reprobeLight();
+            I2CBus::report(I2C_DEV_VEML6075, ok);
+            if (!ok) return false;
+            raw.v[0] = _veml6075.readUVA();
+            raw.v[1] = _veml6075.readUVB();
+            raw.v[2] = _veml6075.readUVI();
             break;
-            
+        }
+#endif
+
         case LIGHT_NONE:
         default:
             return false;
     }
-    
-    return data.valid;
+    return true;
+}
+
+bool Sensor::processLight(const SampleRecord &raw, LightData &data) {
+    switch (raw.driver) {
+#if DLS_SENSOR_VEML6075
+        case LIGHT_VEML6075:
+            data.uva = raw.v[0];
+            data.uvb = raw.v[1];
+            data.uvIndex = raw.v[2];
+            return raw.ok && !isnan(data.uvIndex);
+#endif
+
+        default:
+            return false;
+    }
 }
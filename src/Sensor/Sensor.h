@@ -1,19 +1,37 @@
 #pragma once
 
 #include <Arduino.h>
+#include <Wire.h>
+#include "Config/Features.h"
+#include "SampleLog.h"
 #include <Adafruit_Sensor.h>
+#if DLS_SENSOR_BME280
 #include <Adafruit_BME280.h>
+#endif
+#if DLS_SENSOR_BMP280
 #include <Adafruit_BMP280.h>
+#endif
+#if DLS_SENSOR_BME680
 #include <Adafruit_BME680.h>
+#include "AirQuality.h"
+#endif
+#if DLS_SENSOR_SHTC3
 #include <Adafruit_SHTC3.h>
+#endif
+#if DLS_SENSOR_SHT3X
 #include <Adafruit_SHT31.h>
+#endif
+#if DLS_SENSOR_VEML6075
 #include <Adafruit_VEML6075.h>
+#endif
 
 struct AirData {
     float temperature = -999.0;
     float humidity = -999.0;
     float pressure = -999.0;
-    float gasResistance = -999.0;
+    float gasResistance = -999.0; // kOhm, last heated measurement
+    float iaq = -999.0;           // 0..500, BME680 only
+    uint8_t iaqAccuracy = 0;      // 0 none .. 3 stable baseline
     bool valid = false;
 };
 
@@ -43,10 +61,35 @@ public:
     Sensor();
     void begin(TwoWire *wire = &Wire);
     
+    // BME680 gas heater duty cycle: one heated measurement per interval,
+    // T/H/P reads in between run with the heater off.
+    void setGasInterval(uint32_t seconds) { _gasIntervalMs = seconds * 1000UL; }
+
+    // Persist learned state (IAQ baseline) before deep sleep / power-off
+    void saveState();
+
+    // Raw driver reads go to the log while it records; while it replays,
+    // readings come from the log instead of the hardware.
+    void attachLog(SampleLog *log) { _log = log; }
+
+    // --- Power Gating ---
+    // With gating on, the sensor rail is switched off between samples.
+    // readAll() powers it up once for every driver, waits for the slowest
+    // one to boot, re-applies the cached configuration (no re-probe) and
+    // waits for the first conversion before reading.
+    void setPowerPin(int8_t pin); // Powers the rail; begin() waits out the boot time
+    void setPowerGating(bool enabled);
+    void setRail(bool on);
+
     // Data Readers
+    bool readAll(AirData &air, LightData &light); // Batched, one power window
     bool getAirData(AirData &data);
     bool getLightData(LightData &data);
 
+    // Raw-to-engineering conversion (Pa -> hPa, Ohm -> kOhm).
+    // Pass -999.0 for channels the driver does not provide.
+    static void convertAir(float temperature, float humidity, float pressurePa, float gasOhm, AirData &data);
+
     // Getters for detected types
     SensorTypeAir getFoundAirSensor() const { return _foundAirSensor; }
     SensorTypeLight getFoundLightSensor() const { return _foundLightSensor; }
@@ -56,13 +99,61 @@ private:
     
     // Detected Types
     SensorTypeAir _foundAirSensor = AIR_NONE;
+    uint8_t _airAddr = 0;
     SensorTypeLight _foundLightSensor = LIGHT_NONE;
 
-    // Sensor Objects
+    // Sensor Objects (only the drivers enabled in Features.h are built)
+#if DLS_SENSOR_BME680
     Adafruit_BME680 _bme680;
+#endif
+#if DLS_SENSOR_BME280
     Adafruit_BME280 _bme280;
+#endif
+#if DLS_SENSOR_BMP280
     Adafruit_BMP280 _bmp280;
+#endif
+#if DLS_SENSOR_SHTC3
     Adafruit_SHTC3 _shtc3;
+#endif
+#if DLS_SENSOR_SHT3X
     Adafruit_SHT31 _sht31;
+#endif
+#if DLS_SENSOR_VEML6075
     Adafruit_VEML6075 _veml6075;
+#endif
+
+    // Hardware access (fills raw driver output) and processing are split
+    // so recorded samples take exactly the live path through processing.
+    bool readAirRaw(SampleRecord &raw);
+    bool processAir(const SampleRecord &raw, AirData &data);
+    bool readLightRaw(SampleRecord &raw);
+    bool processLight(const SampleRecord &raw, LightData &data);
+    void syncReplayState();
+
+    void powerUp();
+    void reinitDrivers();
+    bool reprobeAir();   // begin() again at the known address, after a bus fault
+    bool reprobeLight();
+
+    SampleLog *_log = nullptr;
+    bool _replayActive = false;
+
+    int8_t _powerPin = -1;
+    bool _gating = false;
+    bool _railOn = true;
+    unsigned long _railOnMs = 0;
+    bool _needsReinit = false; // Registers lost since the rail was last up
+
+#if DLS_SENSOR_BME680
+    bool configureBME680();
+    void readBME680Raw(SampleRecord &raw);
+    bool processBME680(const SampleRecord &raw, AirData &data);
+
+    AirQuality _airQuality;
+    bool _heaterOn = false;
+    unsigned long _lastGasMs = 0;
+    bool _hasGasReading = false;
+    float _lastGasKOhm = -999.0;
+#endif
+    uint32_t _gasIntervalMs = 300000UL;
 };
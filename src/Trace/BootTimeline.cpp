@@ -0,0 +1,28 @@
+#include "BootTimeline.h"
+
+BootTimeline::Mark BootTimeline::_marks[BOOT_MAX_MARKS];
+uint8_t BootTimeline::_count = 0;
+
+void BootTimeline::mark(const char* name) {
+    if (_count >= BOOT_MAX_MARKS || has(name)) return;
+    _marks[_count].name = name;
+    _marks[_count].ms = millis();
+    _count++;
+}
+
+bool BootTimeline::has(const char* name) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (strcmp(_marks[i].name, name) == 0) return true;
+    }
+    return false;
+}
+
+void BootTimeline::print(Print &out) {
+    out.println("Boot timeline (ms since reset):");
+    uint32_t prev = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        out.printf("  %6lu  +%5lu  %s\n", (unsigned long)_marks[i].ms,
+                   (unsigned long)(_marks[i].ms - prev), _marks[i].name);
+        prev = _marks[i].ms;
+    }
+}
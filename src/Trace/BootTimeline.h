@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Milestones of one boot (ms since reset), first occurrence of each name
+// only. Printed once the first upload has been attempted and with "boot".
+#define BOOT_MAX_MARKS 16
+
+class BootTimeline {
+public:
+    static void mark(const char* name); // Static string
+    static bool has(const char* name);
+    static void print(Print &out);
+
+private:
+    struct Mark {
+        const char* name;
+        uint32_t ms;
+    };
+
+    static Mark _marks[BOOT_MAX_MARKS];
+    static uint8_t _count;
+};
@@ -0,0 +1,82 @@
+#include "Trace.h"
+
+#if DLS_FEATURE_TRACE
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+Trace::Event Trace::_ring[TRACE_RING_SIZE];
+uint32_t Trace::_head = 0;
+volatile bool Trace::_enabled = true;
+volatile bool Trace::_dumping = false;
+uint32_t Trace::_dropped = 0;
+
+static portMUX_TYPE s_traceMux = portMUX_INITIALIZER_UNLOCKED;
+
+void Trace::record(const char* name, uint32_t startUs, uint32_t durUs) {
+    void* task = xTaskGetCurrentTaskHandle();
+    portENTER_CRITICAL(&s_traceMux);
+    if (_dumping) {
+        _dropped++;
+    } else {
+        Event &e = _ring[_head % TRACE_RING_SIZE];
+        e.name = name;
+        e.startUs = startUs;
+        e.durUs = durUs;
+        e.task = task;
+        _head++;
+    }
+    portEXIT_CRITICAL(&s_traceMux);
+}
+
+void Trace::clear() {
+    portENTER_CRITICAL(&s_traceMux);
+    _head = 0;
+    _dropped = 0;
+    portEXIT_CRITICAL(&s_traceMux);
+}
+
+uint32_t Trace::count() {
+    return _head < TRACE_RING_SIZE ? _head : TRACE_RING_SIZE;
+}
+
+void Trace::writeJson(Print &out) {
+    portENTER_CRITICAL(&s_traceMux);
+    _dumping = true;
+    uint32_t head = _head;
+    portEXIT_CRITICAL(&s_traceMux);
+
+    uint32_t n = head < TRACE_RING_SIZE ? head : TRACE_RING_SIZE;
+    uint32_t first = head - n;
+
+    // Tasks are numbered in order of first appearance
+    void* tasks[8] = {};
+    uint8_t taskCount = 0;
+
+    out.print("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    const char* sep = "";
+    for (uint32_t i = 0; i < n; i++) {
+        const Event &e = _ring[(first + i) % TRACE_RING_SIZE];
+        uint8_t tid = 0;
+        while (tid < taskCount && tasks[tid] != e.task) tid++;
+        if (tid == taskCount && taskCount < 8) {
+            tasks[taskCount++] = e.task;
+            // Only the dumping task's name is safe to read; others (e.g. an
+            // OTA task that has ended) keep just their number.
+            if (e.task == xTaskGetCurrentTaskHandle()) {
+                out.printf("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                           sep, tid, pcTaskGetName(nullptr));
+                sep = ",";
+            }
+        }
+        out.printf("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lu,\"dur\":%lu}",
+                   sep, e.name, tid, (unsigned long)e.startUs, (unsigned long)e.durUs);
+        sep = ",";
+    }
+    out.printf("],\"otherData\":{\"dropped\":%lu}}", (unsigned long)_dropped);
+    out.println();
+
+    _dumping = false;
+}
+
+#endif
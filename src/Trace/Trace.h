@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config/Features.h"
+
+// Scoped trace spans for finding blocking sections.
+// DLS_TRACE_SCOPE("name") records one complete event (start + duration) into
+// a fixed ring when the enclosing block exits. Nothing is allocated; with
+// DLS_FEATURE_TRACE=0 the macro expands to nothing, and when tracing is
+// switched off at runtime a span costs one flag test.
+//
+// The ring is exported as Chrome trace_event JSON (serial "trace" command,
+// GET /api/trace) and can be opened in chrome://tracing or ui.perfetto.dev.
+
+#define TRACE_RING_SIZE 256
+
+#if DLS_FEATURE_TRACE
+
+class Trace {
+public:
+    static void enable(bool on) { _enabled = on; }
+    static bool enabled() { return _enabled; }
+    static void clear();
+
+    // Called by TraceScope; name must be a string literal (stored by pointer)
+    static void record(const char* name, uint32_t startUs, uint32_t durUs);
+
+    // Writes {"traceEvents":[...]} oldest first. Recording is paused while
+    // the dump runs, so events from that window are dropped.
+    static void writeJson(Print &out);
+
+    static uint32_t count(); // Events currently held
+    static uint32_t dropped() { return _dropped; }
+
+private:
+    struct Event {
+        const char* name;
+        uint32_t startUs;
+        uint32_t durUs;
+        void* task; // Mapped to a small tid on export
+    };
+
+    static Event _ring[TRACE_RING_SIZE];
+    static uint32_t _head; // Total events ever written
+    static volatile bool _enabled;
+    static volatile bool _dumping;
+    static uint32_t _dropped;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : _name(Trace::enabled() ? name : nullptr), _start(_name ? micros() : 0) {}
+    ~TraceScope() {
+        if (_name) Trace::record(_name, _start, micros() - _start);
+    }
+
+private:
+    const char* _name;
+    uint32_t _start;
+};
+
+#define DLS_TRACE_CONCAT_(a, b) a##b
+#define DLS_TRACE_CONCAT(a, b) DLS_TRACE_CONCAT_(a, b)
+#define DLS_TRACE_SCOPE(name) TraceScope DLS_TRACE_CONCAT(_traceScope, __LINE__)(name)
+
+#else
+
+#define DLS_TRACE_SCOPE(name) do {} while (0)
+
+#endif
@@ -0,0 +1,28 @@
+#include "Dashboard.h"
+#include "WebAssets.h"
+
+void Dashboard::begin(WebServer &server, RateLimiter &limiter) {
+    // WebServer drops request headers it was not told to keep
+    static const char* headers[] = {"If-None-Match"};
+    server.collectHeaders(headers, 1);
+
+    for (uint8_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        server.on(WEB_ASSETS[i].path, HTTP_GET, [&server, &limiter, i]() { serve(server, limiter, i); });
+    }
+}
+
+void Dashboard::serve(WebServer &server, RateLimiter &limiter, uint8_t index) {
+    if (!limiter.admit(server)) return;
+    const WebAsset &asset = WEB_ASSETS[index];
+
+    server.sendHeader("ETag", asset.etag);
+    server.sendHeader("Cache-Control", asset.immutable ? "public, max-age=31536000, immutable" : "no-cache");
+    if (server.header("If-None-Match") == asset.etag) {
+        server.send(304);
+        return;
+    }
+
+    // Only gzip is stored; every browser sends Accept-Encoding: gzip
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, asset.type, (const char*)asset.data, asset.size);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "RateLimiter.h"
+
+// Serves the dashboard in web/ from flash. The assets are gzip-compressed
+// at build time (embed_web.py -> WebAssets.h) and sent as-is with
+// Content-Encoding: gzip. Every response carries a strong ETag; the page
+// itself is revalidated on each load (304 when unchanged) and references
+// its script/style by content hash, so those are cached for a year.
+class Dashboard {
+public:
+    void begin(WebServer &server, RateLimiter &limiter);
+
+private:
+    static void serve(WebServer &server, RateLimiter &limiter, uint8_t index);
+};
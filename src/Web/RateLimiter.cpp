@@ -0,0 +1,75 @@
+#include "RateLimiter.h"
+
+void RateLimiter::refill(Bucket &b, uint32_t nowMs, uint32_t perS, uint32_t burst) {
+    uint32_t elapsed = nowMs - b.lastMs;
+    b.lastMs = nowMs;
+    uint32_t cap = burst * 1000UL;
+    // elapsed * perS is in milli-tokens; clamp before multiplying to avoid overflow
+    if (elapsed >= cap / perS) b.tokens = cap;
+    else b.tokens = min(cap, b.tokens + elapsed * perS);
+}
+
+uint32_t RateLimiter::retryAfter(const Bucket &b, uint32_t need, uint32_t perS) {
+    uint32_t missing = b.tokens >= need ? 0 : need - b.tokens;
+    uint32_t ms = (missing + perS - 1) / perS;
+    return ms / 1000 + 1; // Whole seconds, rounded up
+}
+
+RateLimiter::Client &RateLimiter::clientFor(uint32_t ip, uint32_t nowMs) {
+    Client* oldest = &_clients[0];
+    for (Client &c : _clients) {
+        if (c.ip == ip && c.lastSeenMs) return c;
+        if ((int32_t)(c.lastSeenMs - oldest->lastSeenMs) < 0) oldest = &c;
+    }
+    // New client: take the least recently seen slot with a full bucket
+    oldest->ip = ip;
+    oldest->bucket.tokens = RATE_CLIENT_BURST * 1000UL;
+    oldest->bucket.lastMs = nowMs;
+    oldest->shed = 0;
+    return *oldest;
+}
+
+bool RateLimiter::check(uint32_t ip, uint32_t nowMs, uint8_t cost, uint32_t &retryAfterS) {
+    uint32_t need = cost * 1000UL;
+    Client &c = clientFor(ip, nowMs);
+    c.lastSeenMs = nowMs ? nowMs : 1; // 0 marks a free slot
+
+    refill(c.bucket, nowMs, RATE_CLIENT_PER_S, RATE_CLIENT_BURST);
+    if (c.bucket.tokens < need) {
+        _shedClient++;
+        c.shed++;
+        retryAfterS = retryAfter(c.bucket, need, RATE_CLIENT_PER_S);
+        return false;
+    }
+
+    // The global bucket is only charged for requests the client budget let through
+    refill(_global, nowMs, RATE_GLOBAL_PER_S, RATE_GLOBAL_BURST);
+    if (_global.tokens < need) {
+        _shedGlobal++;
+        retryAfterS = retryAfter(_global, need, RATE_GLOBAL_PER_S);
+        return false;
+    }
+
+    c.bucket.tokens -= need;
+    _global.tokens -= need;
+    _admitted++;
+    return true;
+}
+
+bool RateLimiter::admit(WebServer &server, uint8_t cost) {
+    uint32_t retryAfterS;
+    if (check((uint32_t)server.client().remoteIP(), millis(), cost, retryAfterS)) return true;
+
+    server.sendHeader("Retry-After", String(retryAfterS));
+    server.send(429, "application/json", "{\"status\":false,\"error\":\"Too Many Requests\"}");
+    return false;
+}
+
+void RateLimiter::printStatus(Print &out) {
+    out.printf("HTTP: %lu admitted, %lu shed (client limit), %lu shed (global limit)\n",
+               (unsigned long)_admitted, (unsigned long)_shedClient, (unsigned long)_shedGlobal);
+    for (const Client &c : _clients) {
+        if (!c.lastSeenMs || !c.shed) continue;
+        out.printf("  %s: %lu shed\n", IPAddress(c.ip).toString().c_str(), (unsigned long)c.shed);
+    }
+}
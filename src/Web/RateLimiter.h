@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+// --- HTTP Admission Control ---
+// Token buckets in front of every HTTP handler: one shared by all clients
+// and one per client IP (LRU table). A request over either budget gets a
+// 429 with Retry-After before any handler work runs, so a runaway poller
+// costs a short reply instead of a JSON build or an archive scan.
+#define RATE_GLOBAL_PER_S 10
+#define RATE_GLOBAL_BURST 20
+#define RATE_CLIENT_PER_S 2
+#define RATE_CLIENT_BURST 8  // A dashboard load is page + script + style + API
+#define RATE_MAX_CLIENTS 8
+
+class RateLimiter {
+public:
+    // Handlers call this first; false means a 429 has already been sent.
+    // Expensive endpoints (archive scans) cost more than one token.
+    bool admit(WebServer &server, uint8_t cost = 1);
+
+    // Pure check, no response (retryAfterS: seconds until enough tokens are back)
+    bool check(uint32_t ip, uint32_t nowMs, uint8_t cost, uint32_t &retryAfterS);
+
+    void printStatus(Print &out);
+
+private:
+    // Tokens in milli-tokens so refill stays integer at ms resolution
+    struct Bucket {
+        uint32_t tokens;
+        uint32_t lastMs;
+    };
+
+    struct Client {
+        uint32_t ip;
+        Bucket bucket;
+        uint32_t lastSeenMs;
+        uint32_t shed;
+    };
+
+    static void refill(Bucket &b, uint32_t nowMs, uint32_t perS, uint32_t burst);
+    static uint32_t retryAfter(const Bucket &b, uint32_t need, uint32_t perS);
+    Client &clientFor(uint32_t ip, uint32_t nowMs);
+
+    Bucket _global = {RATE_GLOBAL_BURST * 1000UL, 0};
+    Client _clients[RATE_MAX_CLIENTS] = {};
+
+    uint32_t _admitted = 0;
+    uint32_t _shedClient = 0;
+    uint32_t _shedGlobal = 0;
+};
@@ -0,0 +1,62 @@
+#include "WeatherJson.h"
+#include <ArduinoJson.h>
+#include "Memory/Arena.h"
+
+void WeatherJson::build(const AirData &air, const LightData &light, const DerivedData &derived,
+                        const WindRainData &windRain, String &out) {
+    // 512 bytes should be enough for this JSON
+    JsonDocument doc(&JsonAllocator::instance);
+
+    doc["status"] = true;
+    
+    // Air Data
+    if (air.valid) {
+        if (air.temperature != -999.0) doc["temperature"] = air.temperature;
+        else doc["temperature"] = nullptr;
+
+        if (air.humidity != -999.0) doc["humidity"] = air.humidity;
+        else doc["humidity"] = nullptr;
+
+        if (air.pressure != -999.0) doc["pressure"] = air.pressure;
+        else doc["pressure"] = nullptr;
+
+        if (air.iaq != -999.0) {
+            doc["air_quality"] = air.iaq; // IAQ index 0..500
+            doc["iaq_accuracy"] = air.iaqAccuracy;
+        }
+        else doc["air_quality"] = nullptr;
+
+        if (air.gasResistance > 0) doc["gas_resistance"] = air.gasResistance; // kOhm
+        else doc["gas_resistance"] = nullptr;
+    } else {
+        doc["temperature"] = nullptr;
+        doc["humidity"] = nullptr;
+        doc["pressure"] = nullptr;
+        doc["air_quality"] = nullptr;
+        doc["gas_resistance"] = nullptr;
+    }
+
+    // Derived (computed once per sample in sampleSensors)
+    if (derived.dewPoint != -999.0) doc["dew_point"] = derived.dewPoint; else doc["dew_point"] = nullptr;
+    if (derived.heatIndex != -999.0) doc["heat_index"] = derived.heatIndex; else doc["heat_index"] = nullptr;
+    if (derived.seaLevelPressure != -999.0) doc["sea_level_pressure"] = derived.seaLevelPressure; else doc["sea_level_pressure"] = nullptr;
+    if (derived.absHumidity != -999.0) doc["abs_humidity"] = derived.absHumidity; else doc["abs_humidity"] = nullptr;
+
+    // Light/UV
+    if (light.valid) {
+        if (light.uvIndex != -1.0) doc["uv_index"] = light.uvIndex;
+        else doc["uv_index"] = nullptr;
+        // Lux not available in struct yet
+    } else {
+        doc["uv_index"] = nullptr;
+    }
+
+    // Wind/Rain (Placeholders)
+    if (windRain.windSpeed != -1.0) doc["wind_speed"] = windRain.windSpeed; else doc["wind_speed"] = nullptr;
+    if (windRain.windDir != -1.0) doc["wind_dir"] = windRain.windDir; else doc["wind_dir"] = nullptr;
+    
+    if (windRain.rainRate != -1.0) doc["rain_rate"] = windRain.rainRate; else doc["rain_rate"] = nullptr;
+    if (windRain.rainDaily != -1.0) doc["rain_daily"] = windRain.rainDaily; else doc["rain_daily"] = nullptr;
+
+    serializeJson(doc, out);
+}
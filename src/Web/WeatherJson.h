@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Sensor/Sensor.h"
+#include "Metrics/DerivedMetrics.h"
+
+// Wind and rain gauges (placeholders until fitted); -1.0 means "not available"
+struct WindRainData {
+    float windSpeed = -1.0;
+    float windDir = -1.0;
+    float rainRate = -1.0;
+    float rainDaily = -1.0;
+};
+
+// --- /api/weather payload ---
+// The latest sample as one JSON object; values at their sentinel go out as
+// null. Outside main.cpp so the native env builds and benchmarks it.
+class WeatherJson {
+public:
+    static void build(const AirData &air, const LightData &light, const DerivedData &derived,
+                      const WindRainData &windRain, String &out);
+};
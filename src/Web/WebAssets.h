@@ -0,0 +1,192 @@
+// Generated by embed_web.py from web/ - do not edit.
+#pragma once
+
+#include <Arduino.h>
+
+struct WebAsset {
+    const char* path;
+    const char* type;
+    const char* etag; // Quoted strong ETag of the gzip body
+    const uint8_t* data;
+    size_t size;
+    bool immutable; // URL carries the content hash
+};
+
+// app.js: 1445 bytes gzip
+static const uint8_t WEB_ASSET_0[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x57, 0xd1, 0x6e, 0xdb, 0x36,
+    0x14, 0x7d, 0xcf, 0x57, 0xdc, 0x71, 0x5d, 0x21, 0x2d, 0x8e, 0xec, 0xac, 0xed, 0x50, 0x2c, 0x71,
+    0x8a, 0x34, 0xcd, 0xd0, 0x00, 0x69, 0xda, 0x2e, 0xd9, 0x5e, 0x82, 0x20, 0x66, 0x24, 0x3a, 0xe2,
+    0x22, 0x93, 0x2e, 0x45, 0xd9, 0x31, 0x5c, 0x03, 0xfb, 0x87, 0xfd, 0xc8, 0xde, 0xf6, 0xde, 0x4f,
+    0xd9, 0x97, 0xec, 0x90, 0xa2, 0x6c, 0xd9, 0x6d, 0x97, 0xa7, 0x01, 0x41, 0x22, 0x5d, 0xde, 0x73,
+    0x2e, 0x79, 0xef, 0xb9, 0x97, 0x4a, 0xb7, 0x4b, 0x47, 0x95, 0x31, 0x42, 0x59, 0x9a, 0xf0, 0xa2,
+    0x12, 0x25, 0x0d, 0x8d, 0x1e, 0x51, 0x97, 0x8f, 0x65, 0x77, 0x2a, 0xb8, 0xcd, 0x85, 0xa1, 0x48,
+    0x4c, 0x84, 0x99, 0xd1, 0x6e, 0x8f, 0xca, 0x98, 0xb8, 0xca, 0x28, 0xd7, 0x95, 0x29, 0x66, 0xdd,
+    0x67, 0x3b, 0x23, 0xa9, 0xc8, 0x02, 0x9c, 0x95, 0x5b, 0xdd, 0x6e, 0x0b, 0xc9, 0x4d, 0x9a, 0xcb,
+    0x89, 0x68, 0x90, 0xcf, 0x08, 0x8e, 0x71, 0x42, 0x67, 0x9a, 0x32, 0x31, 0x86, 0xbb, 0x50, 0xa9,
+    0x14, 0x65, 0xb2, 0x95, 0x6a, 0x55, 0x5a, 0x3a, 0x7a, 0x7d, 0x78, 0x76, 0x76, 0x7c, 0x7a, 0x4e,
+    0x7d, 0xba, 0xdc, 0x22, 0x9a, 0xd3, 0x9d, 0x98, 0xfd, 0x44, 0xcc, 0x8a, 0xd1, 0x58, 0x18, 0x6e,
+    0x2b, 0x23, 0x58, 0x87, 0x0a, 0x7e, 0x23, 0x0a, 0x58, 0x2f, 0xd6, 0xac, 0x95, 0x92, 0x16, 0xc6,
+    0x4f, 0x7f, 0x1d, 0x31, 0x5a, 0x74, 0x5a, 0xe0, 0xbc, 0x1a, 0xc9, 0x4c, 0xda, 0x59, 0x0b, 0xf9,
+    0x7a, 0x65, 0x0a, 0xb0, 0xef, 0x36, 0x40, 0x63, 0x23, 0xca, 0x72, 0x3d, 0xdc, 0xbb, 0x95, 0x29,
+    0x80, 0xf2, 0x77, 0x7c, 0x03, 0xc6, 0xa5, 0xb9, 0xfe, 0x50, 0xf1, 0xa2, 0xe6, 0x0e, 0x67, 0x87,
+    0x5d, 0xf2, 0x0f, 0x2d, 0xa6, 0x43, 0x69, 0xe8, 0xfd, 0xd2, 0x2b, 0x90, 0x9d, 0x1c, 0xbe, 0xdf,
+    0x20, 0xab, 0x26, 0xd7, 0x12, 0x09, 0xba, 0x6f, 0x21, 0x7f, 0xfd, 0x8d, 0x4e, 0x82, 0x29, 0xc0,
+    0x36, 0x30, 0x99, 0x98, 0x5e, 0x8f, 0xb5, 0x54, 0xb6, 0x05, 0x7a, 0x25, 0xa6, 0xf4, 0x2e, 0xd8,
+    0x36, 0xb2, 0x74, 0xb5, 0xb7, 0x15, 0x32, 0x9f, 0x72, 0x93, 0x95, 0x48, 0x7b, 0xa6, 0xd3, 0x6a,
+    0x04, 0x0d, 0x24, 0xb7, 0xc2, 0x1e, 0x17, 0xc2, 0x3d, 0xbe, 0x9c, 0x9d, 0x64, 0x11, 0xf3, 0x0e,
+    0x2c, 0xde, 0x0b, 0xfe, 0xa5, 0x45, 0xe2, 0xcb, 0xe3, 0xe2, 0xbf, 0x20, 0xb5, 0xcf, 0x0a, 0xe3,
+    0xc4, 0xf2, 0x00, 0xc4, 0xbb, 0x38, 0xc4, 0xd6, 0x50, 0x43, 0x6e, 0x61, 0x6f, 0x39, 0xe9, 0xe1,
+    0x52, 0x1b, 0x31, 0xcd, 0x71, 0xe0, 0x7a, 0x45, 0xac, 0x91, 0xa5, 0x06, 0x32, 0x15, 0x81, 0x2f,
+    0x62, 0x99, 0x9c, 0x38, 0x26, 0x82, 0x57, 0x92, 0x16, 0xbc, 0x2c, 0xcf, 0xf8, 0x48, 0xc0, 0xdf,
+    0x1f, 0x85, 0x85, 0x05, 0x99, 0x35, 0x96, 0x1d, 0x46, 0xdb, 0x08, 0x95, 0x20, 0x91, 0xcd, 0x9a,
+    0x52, 0xc2, 0xbc, 0xbe, 0x78, 0x73, 0x4a, 0x7d, 0x18, 0x88, 0x06, 0xfb, 0xa0, 0x24, 0x4f, 0xd5,
+    0x67, 0x3e, 0xbb, 0xec, 0xe0, 0xd1, 0x1c, 0x10, 0xff, 0xbc, 0xd8, 0xef, 0x62, 0xf9, 0x60, 0x40,
+    0xdb, 0x9f, 0x3b, 0xfb, 0x86, 0x62, 0x07, 0xff, 0xfc, 0xf1, 0xe7, 0x7e, 0x39, 0xe6, 0xaa, 0x31,
+    0xbb, 0x6a, 0x04, 0x0a, 0xf7, 0x08, 0x06, 0xb7, 0x7a, 0xb0, 0x49, 0x54, 0x4e, 0x6e, 0x69, 0x22,
+    0xc5, 0xf4, 0xa5, 0xbe, 0xef, 0xb3, 0x1e, 0xf5, 0xd0, 0x7f, 0x3d, 0x7a, 0xda, 0x63, 0xe4, 0x54,
+    0x2a, 0xcc, 0x44, 0x1c, 0x96, 0x63, 0x91, 0xda, 0x5f, 0xb8, 0x95, 0xba, 0xcf, 0x94, 0x56, 0x08,
+    0xb5, 0x3f, 0xd6, 0xc5, 0xac, 0x90, 0x4a, 0x90, 0x97, 0x03, 0x82, 0xb1, 0x2e, 0x88, 0x41, 0xf5,
+    0xe5, 0x1d, 0x1a, 0xae, 0x6e, 0x1d, 0xac, 0x0e, 0xed, 0x12, 0xe0, 0x0b, 0x9e, 0xf0, 0xb1, 0xeb,
+    0xd2, 0xa3, 0x5c, 0x16, 0x59, 0x24, 0x0a, 0xa4, 0x73, 0x81, 0xd2, 0x54, 0x2a, 0x45, 0x28, 0x45,
+    0xa5, 0xb0, 0xe7, 0xbe, 0xc6, 0x91, 0xbe, 0xeb, 0x90, 0x15, 0xf7, 0xb6, 0x2e, 0x4e, 0x23, 0x8e,
+    0xc4, 0x99, 0x8e, 0xb4, 0xb2, 0x6e, 0xa8, 0xf4, 0xbd, 0xc3, 0x5e, 0x7b, 0x79, 0xad, 0x2a, 0x37,
+    0x3c, 0xbb, 0x15, 0xe4, 0x8a, 0x00, 0x36, 0x7a, 0x41, 0x4c, 0xdf, 0x31, 0x82, 0x56, 0x85, 0x31,
+    0xac, 0x8e, 0xcb, 0xcb, 0x99, 0x4a, 0x69, 0x19, 0xdd, 0x88, 0x21, 0xce, 0x9f, 0x87, 0xa1, 0x15,
+    0xd5, 0xa1, 0x2d, 0x86, 0xcc, 0xdc, 0x1f, 0xaf, 0x56, 0x08, 0x3c, 0x40, 0xce, 0xa7, 0x5c, 0x5a,
+    0x1a, 0x0a, 0x9b, 0xe6, 0x11, 0x6b, 0x4f, 0x34, 0xb4, 0xc4, 0x1c, 0x27, 0x4d, 0x73, 0xd7, 0xa5,
+    0x4a, 0xef, 0x94, 0x56, 0xa3, 0xc3, 0x69, 0xe1, 0x75, 0xd3, 0x70, 0x64, 0xdc, 0xf2, 0x25, 0x09,
+    0x08, 0x93, 0xdf, 0x4b, 0xad, 0xa2, 0xe0, 0xf2, 0x80, 0x4e, 0x57, 0x2c, 0x13, 0x27, 0x55, 0x30,
+    0x5d, 0xd6, 0x1a, 0xbb, 0xda, 0x5b, 0x5b, 0x5d, 0x57, 0xf2, 0x87, 0x0a, 0xc3, 0xf2, 0x5c, 0x14,
+    0xa8, 0xaa, 0x36, 0xd1, 0xe0, 0x5b, 0xaf, 0x4f, 0xaf, 0x13, 0x20, 0x17, 0x94, 0x78, 0x3d, 0x0d,
+    0xe2, 0x86, 0x02, 0x5a, 0x1d, 0x4a, 0x53, 0x5a, 0x5f, 0xa6, 0x8d, 0xa4, 0x23, 0x6c, 0xbf, 0x4f,
+    0xaa, 0x2a, 0x0a, 0xfa, 0xf8, 0x31, 0xbc, 0x55, 0x98, 0x21, 0x43, 0x68, 0x23, 0x73, 0x69, 0x86,
+    0x28, 0x5d, 0x9e, 0xcf, 0xaa, 0xd1, 0x8d, 0x30, 0xd1, 0x24, 0x4e, 0xac, 0xfe, 0x59, 0xde, 0x8b,
+    0x2c, 0xda, 0x0d, 0xfc, 0x0b, 0xff, 0x7b, 0x55, 0x6b, 0x6b, 0x2a, 0xd1, 0x21, 0xf6, 0x56, 0x79,
+    0x79, 0x7d, 0xfa, 0xdb, 0xd7, 0x4c, 0x61, 0xc8, 0xbc, 0x42, 0xf7, 0x45, 0x0e, 0x7f, 0xaa, 0x53,
+    0x5e, 0x88, 0x0b, 0x39, 0x12, 0xe7, 0xd6, 0x48, 0x75, 0x1b, 0xc5, 0x9e, 0x6a, 0x81, 0x4c, 0xa3,
+    0x02, 0xb8, 0x0b, 0x9a, 0xdc, 0xac, 0x48, 0x87, 0xbc, 0x28, 0x3d, 0xeb, 0x70, 0xe8, 0x68, 0xeb,
+    0xc6, 0x5d, 0x7c, 0xbd, 0xea, 0x17, 0xee, 0xae, 0x89, 0xda, 0xb3, 0xc0, 0x8f, 0x0e, 0x1c, 0x38,
+    0x1c, 0x24, 0x0c, 0x9b, 0x3a, 0x55, 0x9e, 0xad, 0x76, 0xb3, 0x12, 0xf7, 0x58, 0x3f, 0x78, 0x1f,
+    0xd0, 0xd3, 0xe7, 0x2e, 0x07, 0xbb, 0xb9, 0x97, 0xda, 0xb3, 0x11, 0x5b, 0x39, 0x2a, 0x3d, 0x85,
+    0xdf, 0x1b, 0xc8, 0x24, 0x19, 0x16, 0x1a, 0x65, 0x70, 0xc7, 0x4b, 0x60, 0x45, 0xd4, 0xae, 0x6b,
+    0xc1, 0x9e, 0x67, 0x7d, 0x58, 0x70, 0x83, 0xf6, 0x45, 0xf8, 0xc2, 0xc5, 0xef, 0x3f, 0x9a, 0xbb,
+    0x3f, 0x8b, 0xc7, 0xee, 0x9e, 0xc4, 0x8b, 0x0b, 0xb5, 0x13, 0xb6, 0xf4, 0x3d, 0x3d, 0xf9, 0xb1,
+    0xd7, 0x5b, 0x3c, 0xb6, 0xba, 0x5e, 0x58, 0x0c, 0xfe, 0x07, 0x2d, 0xca, 0xec, 0x3e, 0xa8, 0x11,
+    0xc2, 0x11, 0x05, 0xfa, 0xdc, 0xdf, 0x34, 0x6f, 0x87, 0x51, 0x04, 0x8d, 0x35, 0x77, 0x36, 0xf4,
+    0x52, 0x2b, 0x2e, 0x46, 0x81, 0xd9, 0xf5, 0x48, 0x70, 0xc5, 0xe2, 0x75, 0xd9, 0x3a, 0x61, 0x3e,
+    0x74, 0x6b, 0xb4, 0x06, 0xeb, 0x06, 0xba, 0x1e, 0x4d, 0xc0, 0xbb, 0xfd, 0xec, 0x63, 0xb0, 0xbd,
+    0xa0, 0xcb, 0x2b, 0x14, 0xc2, 0x6f, 0xcc, 0xe8, 0x69, 0x89, 0xdd, 0x15, 0x16, 0xc5, 0x8c, 0x4c,
+    0x4c, 0xfd, 0x03, 0x32, 0x97, 0x70, 0xbc, 0xa2, 0x6f, 0x82, 0xa0, 0xe3, 0x64, 0xc4, 0xc7, 0xcd,
+    0xda, 0xa5, 0xb9, 0xec, 0x5d, 0x75, 0x82, 0xcb, 0xd5, 0x32, 0x50, 0x66, 0xf8, 0xb4, 0xd6, 0x8a,
+    0xdb, 0x4a, 0x27, 0x84, 0xec, 0xac, 0x42, 0x74, 0x5c, 0xf0, 0x96, 0xd2, 0x3f, 0x17, 0x29, 0xbe,
+    0x67, 0x0e, 0x43, 0x46, 0x32, 0x59, 0xf2, 0x9b, 0x02, 0x7d, 0x83, 0x44, 0xa7, 0x85, 0x4e, 0xef,
+    0xa0, 0x12, 0xdc, 0x85, 0x10, 0x28, 0x6c, 0x33, 0x81, 0xab, 0xf5, 0x4e, 0x88, 0x31, 0x61, 0xb2,
+    0x84, 0x0b, 0x75, 0x2a, 0x2d, 0xca, 0x6a, 0x9b, 0x4f, 0xa3, 0x20, 0xe9, 0xa5, 0x98, 0xbf, 0xb6,
+    0xbb, 0xd5, 0xc6, 0x5a, 0x02, 0xf7, 0xed, 0xd6, 0xf7, 0xc4, 0x1b, 0x03, 0x82, 0x35, 0xc3, 0x9e,
+    0xb5, 0x84, 0xee, 0x27, 0xfa, 0x57, 0xfc, 0x93, 0x7a, 0xdc, 0x7b, 0x6f, 0x39, 0xa4, 0xa8, 0x8e,
+    0x9b, 0x14, 0x42, 0xdd, 0xda, 0x1c, 0x95, 0xf8, 0xa1, 0x39, 0xbb, 0x23, 0x4d, 0xd0, 0xa5, 0x87,
+    0x16, 0x8d, 0x7c, 0x53, 0xa1, 0xbf, 0x59, 0xed, 0x8b, 0xc1, 0xc9, 0x1a, 0x31, 0x78, 0xb2, 0x8d,
+    0xb1, 0xc3, 0x58, 0x58, 0x13, 0xf8, 0x3e, 0x53, 0x75, 0x33, 0x2f, 0x5b, 0xb0, 0x07, 0x87, 0x9a,
+    0x06, 0x35, 0xc3, 0x4f, 0xab, 0x3b, 0x77, 0x57, 0x4b, 0xeb, 0x9b, 0xda, 0xa1, 0xdd, 0xc6, 0xb5,
+    0x10, 0x48, 0x86, 0x86, 0xe3, 0x89, 0xc2, 0x14, 0xc3, 0x57, 0x54, 0x63, 0xcc, 0x25, 0x8c, 0x3b,
+    0x6d, 0x6b, 0xab, 0x23, 0x8c, 0x6b, 0x08, 0x97, 0xd8, 0xe6, 0x6c, 0xee, 0xe0, 0x5e, 0x2e, 0x9e,
+    0x7b, 0xa5, 0xaa, 0x9a, 0xdb, 0x37, 0x3e, 0x3e, 0x56, 0xa3, 0x42, 0x07, 0x55, 0x79, 0xb7, 0x70,
+    0xe4, 0x15, 0x76, 0x7b, 0x1d, 0xeb, 0xb7, 0x50, 0x63, 0xf9, 0x7d, 0x94, 0xcb, 0x06, 0xbb, 0xdd,
+    0x60, 0x57, 0x69, 0xf0, 0x5f, 0x02, 0x7d, 0x87, 0xd8, 0x71, 0x21, 0xd1, 0x6d, 0xbb, 0xfe, 0x20,
+    0x9f, 0xa5, 0xdc, 0x47, 0x5c, 0xe6, 0xdd, 0xbf, 0xd5, 0x2f, 0x41, 0xe3, 0x75, 0x1b, 0x5c, 0xda,
+    0x0e, 0x4d, 0xae, 0x7c, 0x2f, 0x0c, 0x1e, 0xcd, 0xa3, 0x28, 0xb2, 0xe0, 0xb5, 0x3d, 0x37, 0xac,
+    0x22, 0xa4, 0xd5, 0x3d, 0xfb, 0x18, 0x71, 0x8c, 0x19, 0x83, 0xf1, 0xd5, 0x1e, 0xf4, 0x8b, 0x0e,
+    0x10, 0x4f, 0x9e, 0xc3, 0x29, 0x8a, 0x26, 0x7e, 0x3b, 0x0e, 0xe6, 0x36, 0x18, 0xfb, 0x81, 0xb4,
+    0xe6, 0x3b, 0x88, 0x9b, 0xb8, 0xbf, 0x63, 0x17, 0x11, 0x23, 0xe6, 0x0c, 0xfe, 0x70, 0x5f, 0x52,
+    0xc2, 0xc0, 0xfd, 0x6b, 0xf0, 0x68, 0x5e, 0xe8, 0x36, 0x87, 0xbb, 0x36, 0x90, 0x20, 0xd8, 0x73,
+    0xb9, 0xc6, 0xed, 0x2f, 0xfa, 0x66, 0x76, 0xf3, 0x2c, 0x3b, 0x9e, 0x80, 0xe5, 0x54, 0x96, 0x20,
+    0xc3, 0x1c, 0x60, 0x69, 0xee, 0x85, 0xdb, 0x59, 0xbb, 0x06, 0x10, 0x7a, 0xf3, 0x5b, 0x60, 0x69,
+    0x09, 0xf7, 0xc4, 0xde, 0x16, 0x32, 0x7a, 0x82, 0x2d, 0x19, 0xdc, 0x07, 0xd1, 0xba, 0x77, 0xc7,
+    0x0f, 0xf3, 0xde, 0x97, 0x7d, 0x3c, 0xbe, 0x43, 0x4f, 0x7a, 0xc1, 0xe5, 0x5f, 0xe7, 0x15, 0xf2,
+    0x1d, 0x26, 0x0d, 0x00, 0x00,
+};
+
+// style.css: 633 bytes gzip
+static const uint8_t WEB_ASSET_1[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x54, 0xdb, 0x8e, 0xda, 0x30,
+    0x10, 0x7d, 0xe7, 0x2b, 0xac, 0xad, 0x2a, 0x81, 0x84, 0x23, 0x87, 0x05, 0x96, 0xc0, 0x17, 0xf4,
+    0xb9, 0xea, 0x07, 0x38, 0xc9, 0x38, 0xb8, 0x38, 0x76, 0x64, 0x3b, 0x5c, 0xba, 0xe2, 0xdf, 0x3b,
+    0x76, 0x12, 0xee, 0x2b, 0x2d, 0x2f, 0x48, 0xc7, 0x9e, 0x99, 0x73, 0x19, 0x67, 0x6d, 0x8d, 0xf1,
+    0xe4, 0x73, 0x44, 0x08, 0xa5, 0x8d, 0x95, 0x35, 0xb7, 0xa7, 0x35, 0xf9, 0x31, 0x5b, 0x2c, 0xdf,
+    0x21, 0xdf, 0x44, 0x34, 0xaf, 0x10, 0x10, 0x2b, 0xc1, 0x45, 0xd1, 0x01, 0xae, 0xb5, 0x82, 0x17,
+    0x10, 0xd0, 0xf8, 0xeb, 0x50, 0x0f, 0x47, 0x4f, 0x6b, 0x2e, 0x35, 0xe2, 0x29, 0xcc, 0xb2, 0xf7,
+    0xfc, 0x16, 0x6f, 0x3d, 0x94, 0x78, 0xb0, 0x9c, 0x7f, 0xcc, 0x57, 0x43, 0x5f, 0x63, 0x4b, 0xb0,
+    0x08, 0xc2, 0x0c, 0x56, 0x82, 0x0d, 0xbd, 0x8b, 0x02, 0x9c, 0x0b, 0x3d, 0x58, 0x9e, 0xad, 0xd2,
+    0x0e, 0x3d, 0x70, 0xab, 0xa5, 0x8e, 0x3c, 0x16, 0x19, 0x30, 0x6c, 0x70, 0x1e, 0x8d, 0x72, 0x53,
+    0x9e, 0x22, 0x71, 0x61, 0xb4, 0xa7, 0x82, 0xd7, 0x52, 0x21, 0x75, 0x77, 0x72, 0x1e, 0x6a, 0xda,
+    0xca, 0x29, 0xa1, 0xbc, 0x69, 0x14, 0xd0, 0x0e, 0x99, 0x92, 0xb7, 0xdf, 0x50, 0x19, 0x20, 0x7f,
+    0x7e, 0xbd, 0x4d, 0x89, 0xe3, 0xda, 0x51, 0x07, 0x56, 0x46, 0xf2, 0x39, 0x2f, 0x76, 0x95, 0x35,
+    0xad, 0x46, 0x8a, 0x7b, 0x6e, 0xc7, 0x41, 0xf3, 0x24, 0x1c, 0x14, 0x46, 0x19, 0x3b, 0x60, 0x17,
+    0x81, 0xf1, 0x08, 0x8d, 0xaa, 0x82, 0x56, 0x46, 0x78, 0xeb, 0x4d, 0x40, 0x1a, 0x5e, 0x96, 0x91,
+    0xe4, 0x8c, 0x35, 0xc7, 0xee, 0xca, 0x91, 0x1e, 0x64, 0xe9, 0xb7, 0x6b, 0x92, 0x2d, 0x23, 0x86,
+    0xac, 0xb7, 0xc0, 0x51, 0x75, 0xe4, 0x5d, 0x4a, 0xd7, 0x28, 0x8e, 0x9c, 0x85, 0x82, 0x58, 0xc0,
+    0x95, 0xac, 0x34, 0x95, 0xc8, 0x16, 0x0d, 0x28, 0x40, 0x7b, 0xb0, 0x01, 0xfe, 0xdb, 0x3a, 0x2f,
+    0xc5, 0x89, 0x16, 0xa8, 0x13, 0x41, 0xd4, 0xd8, 0xa0, 0xfd, 0x34, 0x07, 0x7f, 0x00, 0xd0, 0x5d,
+    0xd7, 0xf4, 0xea, 0x84, 0x93, 0xff, 0x30, 0x9b, 0x34, 0x99, 0x5b, 0xa8, 0x37, 0x03, 0x78, 0x00,
+    0x59, 0x6d, 0xb1, 0x74, 0xc9, 0x58, 0x2c, 0x48, 0x72, 0x5e, 0x56, 0xf0, 0x58, 0xc4, 0x92, 0x55,
+    0x5f, 0x74, 0x11, 0x33, 0x6f, 0x8e, 0x24, 0xed, 0x05, 0x75, 0x89, 0x51, 0xcb, 0x4b, 0xd9, 0x22,
+    0xc3, 0x2c, 0xcb, 0x7a, 0xfc, 0xd9, 0xbf, 0x78, 0x73, 0x72, 0x33, 0x2a, 0x31, 0x3b, 0xf2, 0xf9,
+    0xe2, 0x66, 0x1f, 0xf8, 0x64, 0x33, 0x98, 0x1d, 0x96, 0x6a, 0x43, 0xce, 0x43, 0x19, 0x58, 0xfb,
+    0xb2, 0xae, 0x5f, 0x89, 0xe7, 0xba, 0x51, 0x88, 0xe8, 0xde, 0xdf, 0xca, 0xca, 0x32, 0xf0, 0x0c,
+    0xff, 0x18, 0x63, 0x8d, 0xa8, 0x07, 0xb4, 0x53, 0xb5, 0xb5, 0x46, 0x1d, 0x16, 0x1a, 0xe0, 0x7e,
+    0x1c, 0x72, 0xa4, 0x42, 0x2a, 0x35, 0x25, 0xb5, 0xd4, 0x18, 0xde, 0x78, 0x16, 0x84, 0x4f, 0x49,
+    0x2a, 0xec, 0x24, 0x66, 0x5e, 0xf1, 0x06, 0x8d, 0x9d, 0xf5, 0x49, 0x26, 0x05, 0xb7, 0x65, 0x1c,
+    0xf4, 0x4a, 0x55, 0x7c, 0x22, 0x93, 0xab, 0x6b, 0x58, 0x88, 0x4e, 0x3a, 0xa3, 0x64, 0xf9, 0xe8,
+    0xd1, 0x93, 0xb1, 0x83, 0xdf, 0x97, 0x10, 0xd2, 0xf9, 0xdd, 0xcc, 0x44, 0xf1, 0x1c, 0x14, 0xda,
+    0xf2, 0x62, 0x3f, 0xc3, 0x43, 0x43, 0x53, 0xee, 0x43, 0x5d, 0x84, 0x54, 0x83, 0xa7, 0x5d, 0xf9,
+    0x9e, 0xab, 0x16, 0xb3, 0xbf, 0x5f, 0x97, 0x98, 0xfc, 0xf3, 0xb2, 0x5c, 0x16, 0x3d, 0x2c, 0x02,
+    0xbb, 0x69, 0xd2, 0x6a, 0xe9, 0xef, 0x7b, 0xb0, 0x24, 0x8b, 0x3d, 0xbe, 0x66, 0xd5, 0xf5, 0xa2,
+    0x0a, 0x84, 0x8f, 0x0d, 0x6f, 0xda, 0x59, 0xae, 0xc3, 0x3e, 0x7e, 0x57, 0xd2, 0xc7, 0x20, 0xa9,
+    0xaf, 0x77, 0xfb, 0x0a, 0x8b, 0xfb, 0xd7, 0x96, 0x32, 0xf6, 0x73, 0x43, 0xb6, 0xbd, 0x8a, 0x39,
+    0xbb, 0x1d, 0xd4, 0x18, 0x75, 0x52, 0x52, 0x47, 0xf9, 0x98, 0xf5, 0x9a, 0x68, 0xa3, 0x61, 0x43,
+    0x9c, 0xb7, 0x66, 0x07, 0xc3, 0xdc, 0xfe, 0x43, 0x38, 0x19, 0xf0, 0xe1, 0x19, 0xa7, 0xc9, 0x22,
+    0xce, 0x14, 0xf8, 0xcd, 0xec, 0x1f, 0x71, 0x2f, 0xc9, 0x9b, 0xb0, 0x1a, 0xab, 0x2e, 0xb7, 0x2f,
+    0x35, 0x3c, 0xbd, 0xb6, 0xa8, 0x62, 0x74, 0xed, 0xc8, 0x1f, 0x1d, 0xb8, 0x32, 0x39, 0x8f, 0xfe,
+    0x03, 0x99, 0x90, 0x19, 0xc4, 0xab, 0x05, 0x00, 0x00,
+};
+
+// index.html: 440 bytes gzip
+static const uint8_t WEB_ASSET_2[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x53, 0x4b, 0x8e, 0x13, 0x31,
+    0x10, 0xdd, 0xcf, 0x29, 0x8c, 0xd7, 0x64, 0x9c, 0x4e, 0x7a, 0x3a, 0x0d, 0x72, 0x9b, 0x0d, 0x4b,
+    0xc4, 0x06, 0x24, 0xd6, 0x35, 0x76, 0x65, 0x6c, 0x70, 0xec, 0x96, 0xed, 0x74, 0x94, 0x1d, 0x07,
+    0x40, 0xe2, 0x08, 0xec, 0xe6, 0x0a, 0xb0, 0xe6, 0x28, 0x5c, 0x00, 0x8e, 0x30, 0x76, 0x7f, 0x34,
+    0x11, 0x23, 0x24, 0x56, 0xf6, 0xab, 0x7a, 0xf5, 0xca, 0xf5, 0x31, 0x7f, 0xa6, 0xbc, 0x4c, 0xe7,
+    0x1e, 0x89, 0x4e, 0x07, 0x2b, 0xae, 0x78, 0x39, 0x88, 0x05, 0x77, 0xd7, 0x51, 0x74, 0x54, 0x5c,
+    0x11, 0xc2, 0x35, 0x82, 0x2a, 0x97, 0x7c, 0x3d, 0x60, 0x02, 0x22, 0x35, 0x84, 0x88, 0xa9, 0xa3,
+    0xc7, 0xb4, 0x5f, 0xb5, 0x94, 0xb0, 0xd9, 0x99, 0x4c, 0xb2, 0x28, 0x5e, 0xbf, 0x79, 0x47, 0x3e,
+    0x20, 0x24, 0x8d, 0x81, 0xbc, 0xf5, 0x0a, 0x39, 0x9b, 0xec, 0x17, 0x02, 0x0e, 0x0e, 0xd8, 0xd1,
+    0xc1, 0xe0, 0xa9, 0xf7, 0x21, 0x51, 0x22, 0xbd, 0x4b, 0xe8, 0xb2, 0xe0, 0xc9, 0xa8, 0xa4, 0x3b,
+    0x85, 0x83, 0x91, 0xb8, 0x1a, 0xc1, 0x73, 0x62, 0x9c, 0x49, 0x06, 0xec, 0x2a, 0x4a, 0xb0, 0xd8,
+    0x55, 0x8f, 0xe9, 0xac, 0x71, 0x9f, 0x48, 0x40, 0xdb, 0xd1, 0x98, 0xce, 0x16, 0xa3, 0x46, 0xcc,
+    0x5a, 0x3a, 0xe0, 0xbe, 0xa3, 0x6c, 0x34, 0x5d, 0xcb, 0x18, 0x5f, 0x0d, 0xdd, 0xb6, 0x5a, 0x6f,
+    0xeb, 0xb6, 0x6a, 0x6f, 0xd6, 0xbb, 0x7d, 0x53, 0x6f, 0x6e, 0x66, 0x09, 0xce, 0x96, 0xc2, 0xf8,
+    0xad, 0x57, 0xe7, 0x59, 0xb5, 0xd8, 0x30, 0x4c, 0xa0, 0xc0, 0x4a, 0xfc, 0xf9, 0xf6, 0xe5, 0xfe,
+    0xf7, 0x8f, 0xaf, 0xe4, 0x69, 0x61, 0xd9, 0xb9, 0xf0, 0x62, 0x0f, 0x8e, 0x18, 0x55, 0xde, 0x02,
+    0xe9, 0x18, 0x73, 0x4d, 0x16, 0x62, 0xec, 0xe8, 0x2d, 0xa8, 0x3b, 0xa4, 0xe2, 0xd7, 0xe7, 0x7b,
+    0xce, 0x0a, 0x67, 0xce, 0xc2, 0x2e, 0xd3, 0xf0, 0x03, 0x98, 0x29, 0x58, 0x42, 0x50, 0x91, 0x0a,
+    0xce, 0x8a, 0x65, 0x76, 0xee, 0xbd, 0x4f, 0x8f, 0x0f, 0x7a, 0x1f, 0xd0, 0xa9, 0x97, 0x79, 0x40,
+    0x31, 0xe5, 0xa4, 0x68, 0x51, 0xa6, 0x31, 0x52, 0xfb, 0x63, 0x88, 0x74, 0x61, 0xe5, 0x30, 0xdf,
+    0x27, 0xe3, 0x1d, 0x19, 0xc0, 0x1e, 0x73, 0xaf, 0x1b, 0x2a, 0x1a, 0xa2, 0x39, 0x9b, 0xac, 0xff,
+    0xa4, 0x6d, 0x6a, 0x4a, 0x26, 0x51, 0x54, 0x62, 0x53, 0xff, 0x47, 0x44, 0xd5, 0xb4, 0x54, 0xec,
+    0x88, 0xfa, 0x9b, 0x98, 0xab, 0x1d, 0x75, 0x16, 0xfc, 0xf3, 0x3b, 0xe1, 0xb0, 0x0c, 0x07, 0x7a,
+    0xc3, 0x4e, 0x53, 0x27, 0xa9, 0xb8, 0x44, 0x9c, 0x81, 0x78, 0x4a, 0x85, 0x20, 0xb5, 0x19, 0x70,
+    0xa6, 0xce, 0xa8, 0x50, 0xe7, 0x5e, 0x5e, 0x76, 0x88, 0x47, 0x19, 0x4c, 0x9f, 0x48, 0x0c, 0x72,
+    0x8c, 0xee, 0xaf, 0x3f, 0x96, 0x15, 0x50, 0xdb, 0x76, 0x07, 0xf0, 0xa2, 0xd9, 0x61, 0x8d, 0x0d,
+    0xaa, 0x75, 0xe9, 0xf1, 0xc4, 0x9c, 0x36, 0x61, 0x5a, 0x80, 0x3c, 0x96, 0xf1, 0x13, 0x3c, 0x00,
+    0xc6, 0xba, 0x38, 0x87, 0x15, 0x03, 0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+    {"/app.js", "application/javascript", "\"d387aa967e4e6ed0\"", WEB_ASSET_0, sizeof(WEB_ASSET_0), true},
+    {"/style.css", "text/css", "\"31034818507f6425\"", WEB_ASSET_1, sizeof(WEB_ASSET_1), true},
+    {"/", "text/html", "\"6e576839223a916b\"", WEB_ASSET_2, sizeof(WEB_ASSET_2), false},
+};
+
+#define WEB_ASSET_COUNT 3
@@ -1,22 +1,78 @@
 #include <Wire.h>
-#include <WebServer.h>
 #include <ArduinoJson.h>
 #include "DLSWeather.h"
 #include "variant.h"
+#include "Config/Features.h"
+#if DLS_FEATURE_WEBSERVER
+#include <WebServer.h>
+#include "Web/RateLimiter.h"
+#endif
+#if DLS_FEATURE_DASHBOARD
+#include "Web/Dashboard.h"
+#endif
+#include "Web/WeatherJson.h"
 #include "Sensor/Sensor.h"
 #include "NetworkManager/DLSNetwork.h"
 #include "Display/Display.h"
+#include "Bus/I2CBus.h"
 #include "Config/Config.h"
+#include "Metrics/DerivedMetrics.h"
+#include "Metrics/EventTrigger.h"
+#if DLS_FEATURE_OTA
+#include "Ota/OtaUpdater.h"
+#endif
+#include "Trace/Trace.h"
+#include "Trace/BootTimeline.h"
+#include "Energy/Energy.h"
+#include "Log/Log.h"
+#include "Memory/Arena.h"
+#if DLS_FEATURE_ARCHIVE
+#include "Archive/Archive.h"
+#endif
+#if DLS_FEATURE_RELAY
+#include "Relay/Relay.h"
+#include "Relay/EspNowLink.h"
+#endif
+#if DLS_FEATURE_MQTT
+#include "Mqtt/MqttPublisher.h"
+#endif
+#if DLS_FEATURE_BENCH
+#include "Bench/Bench.h"
+#endif
 #include <esp_sleep.h>
 #include <esp_system.h>
+#include <esp_timer.h>
 
 // --- NESNELER ---
 Config config;
 DLSWeather* dls;
 Sensor sensorManager;
+SampleLog sampleLog; // Raw sensor record/replay (see Sensor/SampleLog.h)
 DLSNetwork network;
 Display display;
+DerivedMetrics metrics;
+EventTrigger events;
+#if DLS_FEATURE_ARCHIVE
+Archive archive;
+#endif
+#if DLS_FEATURE_WEBSERVER
 WebServer server(80); // Web Sunucusu
+RateLimiter apiLimiter; // 429 before any handler work
+#endif
+#if DLS_FEATURE_DASHBOARD
+Dashboard dashboard;
+#endif
+#if DLS_FEATURE_OTA
+OtaUpdater ota;
+#endif
+#if DLS_FEATURE_RELAY
+EspNowLink relayLink;
+RelayNode relayNode;       // "relay": "node"
+RelayGateway relayGateway; // "relay": "gateway"
+#endif
+#if DLS_FEATURE_MQTT
+MqttPublisher mqtt; // "mqttHost", next to DLSWeather
+#endif
 
 // --- GLOBAL VARIABLES (For API & Loop) ---
 AirData latestAir;
@@ -36,113 +92,521 @@ unsigned long lastAttemptTime = 0;
 bool pendingRetry = false;
 bool isFromSleep = false;
 unsigned long bootTime = 0;
-
-// --- API handlers ---
-void handleWeatherAPI() {
-    // 512 bytes should be enough for this JSON
-    JsonDocument doc;
-
-    doc["status"] = true;
+#define BOOT_NET_WAIT_MS 15000UL // First upload waits this long for Wi-Fi + NTP
+const EventRule* pendingEvent = nullptr; // Rapid change waiting for an upload
+bool relayUplink = false; // Relay node: uploads go over ESP-NOW, Wi-Fi stays off
+
+// --- Sampling ---
+// Reads all sensors, derives metrics once and pushes the result to the display.
+void sampleSensors() {
+    sensorManager.readAll(latestAir, latestLight);
+    BootTimeline::mark("first.sample");
+    metrics.update(latestAir);
+    const DerivedData &derived = metrics.get();
+
+    const EventRule* fired = events.update(millis(), latestAir, latestRainRate);
+    if (fired && !pendingEvent) pendingEvent = fired;
+
+#if DLS_FEATURE_ARCHIVE
+    if (!sampleLog.isReplaying()) archive.add(network.getEpochTime(), latestAir, latestLight);
+#endif
+
+    // --- Display Data Update ---
+    // Pass -999.0 if invalid, implementation handles printing "NaN"
+    display.setAirData(
+        latestAir.valid ? latestAir.temperature : -999.0,
+        latestAir.valid ? latestAir.humidity : -999.0,
+        latestAir.valid ? latestAir.pressure : -999.0,
+        latestAir.valid ? latestAir.iaq : -999.0,
+        latestAir.iaqAccuracy,
+        derived.dewPoint
+    );
+    
+    display.setLightData(
+        latestLight.valid ? latestLight.uvIndex : -1.0,
+        -1.0 // Lux placeholder
+    );
     
-    // Air Data
-    if (latestAir.valid) {
-        if (latestAir.temperature != -999.0) doc["temperature"] = latestAir.temperature;
-        else doc["temperature"] = nullptr;
+    display.setWindData(-1.0, -1.0); // Speed, Dir
+    display.setRainData(-1.0, -1.0); // Rate, Daily
+}
 
-        if (latestAir.humidity != -999.0) doc["humidity"] = latestAir.humidity;
-        else doc["humidity"] = nullptr;
+#if DLS_FEATURE_RELAY
+// --- Relay ---
+// Node side: the latest sample as one ESP-NOW frame to the gateway
+bool sendRelayed() {
+    RelayFrame frame;
+    frame.encode(config.getStationID().c_str(), config.getLat(), config.getLon(), latestAir, latestLight);
+    return relayNode.send(frame);
+}
 
-        if (latestAir.pressure != -999.0) doc["pressure"] = latestAir.pressure;
-        else doc["pressure"] = nullptr;
+// Gateway side: uploads a relayed sample under the sender's station ID,
+// authorized with this node's API key
+bool forwardRelayed(const RelayFrame &frame, unsigned long epoch) {
+    DLS_TRACE_SCOPE("relay.forward");
+    DLS_ENERGY_SCOPE(ENERGY_HTTP);
+    DLSWeather upload(frame.station, config.getAPIKey(), frame.lat, frame.lon);
+    upload.begin();
+    if (frame.temperatureC() != -999.0) upload.temperature(frame.temperatureC());
+    if (frame.humidityPct() != -999.0)  upload.humidity(frame.humidityPct());
+    if (frame.pressureHpa() != -999.0)  upload.pressure(frame.pressureHpa());
+    if (frame.iaqIndex() != -999.0)     upload.airQuality(frame.iaqIndex());
+    if (frame.uvIdx() != -1.0)          upload.uvIndex(frame.uvIdx());
+    bool ok = upload.send(epoch);
+    if (ok) LOG_I("Relay", "%s aktarildi (seq %u)", frame.station, frame.seq);
+    else LOG_W("Relay", "%s aktarilamadi, kod %d", frame.station, upload.getLastCode());
+    return ok;
+}
+#endif
+
+// --- API payload ---
+void buildWeatherJson(String &response) {
+    WindRainData windRain;
+    windRain.windSpeed = latestWindSpeed;
+    windRain.windDir = latestWindDir;
+    windRain.rainRate = latestRainRate;
+    windRain.rainDaily = latestRainDaily;
+    WeatherJson::build(latestAir, latestLight, metrics.get(), windRain, response);
+}
 
-        if (latestAir.gasResistance > 0 && latestAir.gasResistance != -999.0) 
-            doc["air_quality"] = latestAir.gasResistance / 1000.0; // kOhm? User example said "300.4", likely raw or specific unit
-        else doc["air_quality"] = nullptr;
-    } else {
-        doc["temperature"] = nullptr;
-        doc["humidity"] = nullptr;
-        doc["pressure"] = nullptr;
-        doc["air_quality"] = nullptr;
+// --- API handlers ---
+#if DLS_FEATURE_WEBSERVER
+// Streams a Print into chunked HTTP responses without building a String
+class ChunkedResponse : public Print {
+public:
+    explicit ChunkedResponse(WebServer &srv) : _srv(srv) {}
+    ~ChunkedResponse() { flush(); }
+
+    size_t write(uint8_t c) override {
+        if (_len == sizeof(_buf)) flush();
+        _buf[_len++] = c;
+        return 1;
     }
 
-    // Light/UV
-    if (latestLight.valid) {
-        if (latestLight.uvIndex != -1.0) doc["uv_index"] = latestLight.uvIndex;
-        else doc["uv_index"] = nullptr;
-        // Lux not available in struct yet
-    } else {
-        doc["uv_index"] = nullptr;
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t i = 0; i < size; i++) write(data[i]);
+        return size;
     }
 
-    // Wind/Rain (Placeholders)
-    if (latestWindSpeed != -1.0) doc["wind_speed"] = latestWindSpeed; else doc["wind_speed"] = nullptr;
-    if (latestWindDir != -1.0) doc["wind_dir"] = latestWindDir; else doc["wind_dir"] = nullptr;
-    
-    if (latestRainRate != -1.0) doc["rain_rate"] = latestRainRate; else doc["rain_rate"] = nullptr;
-    if (latestRainDaily != -1.0) doc["rain_daily"] = latestRainDaily; else doc["rain_daily"] = nullptr;
+    void flush() override {
+        if (_len) _srv.sendContent((const char*)_buf, _len);
+        _len = 0;
+    }
 
+private:
+    WebServer &_srv;
+    uint8_t _buf[256];
+    size_t _len = 0;
+};
+
+void handleWeatherAPI() {
+    if (!apiLimiter.admit(server)) return;
     String response;
-    serializeJson(doc, response);
+    buildWeatherJson(response);
     server.send(200, "application/json", response);
 }
 
+#if DLS_FEATURE_TRACE
+void handleTraceAPI() {
+    if (!apiLimiter.admit(server)) return;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+    {
+        ChunkedResponse out(server);
+        Trace::writeJson(out);
+    }
+    server.sendContent(""); // Terminating chunk
+}
+#endif
+
+#if DLS_FEATURE_ENERGY
+void handleEnergyAPI() {
+    if (!apiLimiter.admit(server)) return;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+    {
+        ChunkedResponse out(server);
+        Energy::writeJson(out);
+    }
+    server.sendContent("");
+}
+#endif
+
+#if DLS_FEATURE_ARCHIVE
+// GET /api/archive?tier=raw|5m|1h&from=<epoch>&to=<epoch> (default: last 24 h of 5m)
+void handleArchiveAPI() {
+    if (!apiLimiter.admit(server, 4)) return; // Scans flash pages
+    ArchiveTier tier = TIER_5MIN;
+    if (server.hasArg("tier") && !Archive::parseTier(server.arg("tier").c_str(), tier)) {
+        server.send(400, "application/json", "{\"status\":false,\"error\":\"Bad tier\"}");
+        return;
+    }
+    uint32_t now = network.getEpochTime();
+    uint32_t to = server.hasArg("to") ? strtoul(server.arg("to").c_str(), nullptr, 10) : now;
+    uint32_t from = server.hasArg("from") ? strtoul(server.arg("from").c_str(), nullptr, 10) : to - 86400UL;
+
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+    {
+        ChunkedResponse out(server);
+        archive.query(tier, from, to, out);
+    }
+    server.sendContent("");
+}
+#endif
+
 void handleNotFound() {
+    if (!apiLimiter.admit(server)) return;
     String message = "{\"status\":false,\"error\":\"Not Found\"}";
     server.send(404, "application/json", message);
 }
+#endif
+
+#if DLS_FEATURE_BENCH
+// --- Microbenchmarks (bench environments only) ---
+void runBenchmarks() {
+    static Bench bench;
+
+    // Fixed synthetic sample so runs are comparable across boots
+    latestAir.temperature = 21.37;
+    latestAir.humidity = 48.2;
+    latestAir.pressure = 1012.6;
+    latestAir.gasResistance = 152.3;
+    latestAir.iaq = 57.0;
+    latestAir.iaqAccuracy = 3;
+    latestAir.valid = true;
+    latestLight.uvIndex = 3.4;
+    latestLight.valid = true;
+    metrics.setAltitude(120.0);
+    metrics.update(latestAir);
+    display.setAirData(latestAir.temperature, latestAir.humidity, latestAir.pressure, latestAir.iaq,
+                       latestAir.iaqAccuracy, metrics.get().dewPoint);
+    display.setLightData(latestLight.uvIndex, -1.0);
+    display.setWindData(-1.0, -1.0);
+    display.setRainData(-1.0, -1.0);
+    display.setNetworkInfo("192.168.1.42", "BenchNet", "Online", true);
+
+    static bool registered = false;
+    if (!registered) {
+        bench.add("api_json", []() {
+            String response;
+            buildWeatherJson(response);
+        });
+        bench.add("page_net",   []() { display.renderPage(PAGE_NET); });
+        bench.add("page_air",   []() { display.renderPage(PAGE_AIR); });
+        bench.add("page_rain",  []() { display.renderPage(PAGE_RAIN); });
+        bench.add("page_wind",  []() { display.renderPage(PAGE_WIND); });
+        bench.add("page_light", []() { display.renderPage(PAGE_LIGHT); });
+        bench.add("sensor_convert", []() {
+            AirData data;
+            Sensor::convertAir(21.37, 48.2, 101260.0, 152300.0, data);
+        }, 1000);
+        bench.add("metrics_float", []() {
+            DerivedData out;
+            DerivedMetrics::computeFloat(latestAir, 120.0, out);
+        });
+        bench.add("metrics_fixed", []() {
+            DerivedData out;
+            DerivedMetrics::computeFixed(latestAir, 120.0, out);
+        });
+        bench.add("config_to_json", []() {
+            String out;
+            config.toJson(out);
+        });
+        bench.add("config_from_json", []() {
+            static Config scratch; // Parsed into a spare instance, never saved
+            scratch.fromJson("{\"ssid\":\"BenchNet\",\"pass\":\"secret\",\"api\":\"KEY\",\"station\":\"ST-BENCH\","
+                             "\"lat\":41.01,\"lon\":28.97,\"interval\":10,\"deepSleep\":false}");
+        });
+        registered = true;
+    }
+
+    bool pass = bench.run(Serial);
+    pass = DerivedMetrics::checkAccuracy(Serial) && pass;
+    Serial.println(pass ? "[Bench] ALL PASS" : "[Bench] FAILED");
+}
+#endif
+
+// --- Replay Benchmark ---
+// Pushes the whole capture through sampling, metrics, display and the API
+// payload as fast as possible and reports how the bad readings came out.
+void runReplay() {
+    if (!sampleLog.startReplay(false)) return;
+
+    uint32_t samples = 0, invalid = 0, nanValues = 0;
+    int64_t start = esp_timer_get_time();
+    while (sampleLog.isReplaying()) {
+        sampleSensors();
+        if (!sampleLog.isReplaying() && !latestAir.valid) break; // Capture ended on this read
+        samples++;
+        if (!latestAir.valid) invalid++;
+        if (isnan(latestAir.temperature) || isnan(latestAir.humidity)) nanValues++;
+        display.renderPage(PAGE_AIR);
+        String response;
+        buildWeatherJson(response);
+    }
+    int64_t elapsedUs = esp_timer_get_time() - start;
+    sampleSensors(); // Back on live readings
+
+    Serial.printf("Replay: %lu ornek, %lu gecersiz, %lu NaN, %lu us/ornek\n",
+                  (unsigned long)samples, (unsigned long)invalid, (unsigned long)nanValues,
+                  (unsigned long)(samples ? elapsedUs / samples : 0));
+}
+
+// --- Serial Commands (in addition to Config's) ---
+void registerCommands() {
+    config.commands().add("status", [](const char*) {
+        Serial.printf("Uptime: %lu s\n", millis() / 1000);
+        Serial.printf("Heap: %u free / %u min block\n", (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMaxAllocHeap());
+        Arena::printStatus(Serial);
+        network.printStatus(Serial);
+#if DLS_FEATURE_WEBSERVER
+        apiLimiter.printStatus(Serial);
+#endif
+#if DLS_FEATURE_RELAY
+        if (relayUplink) relayNode.printStatus(Serial);
+        else if (config.isRelayGateway()) relayGateway.printStatus(Serial);
+#endif
+#if DLS_FEATURE_MQTT
+        mqtt.printStatus(Serial);
+#endif
+        Log::printStatus(Serial);
+        Serial.printf("Air sensor: %d, Light sensor: %d\n",
+                      (int)sensorManager.getFoundAirSensor(), (int)sensorManager.getFoundLightSensor());
+    }, "Calisma durumu");
+
+    config.commands().add("boot", [](const char*) { BootTimeline::print(Serial); }, "Acilis zaman cizelgesi");
+
+    config.commands().add("i2c", [](const char* args) {
+        if (strcasecmp(args, "reset") == 0) I2CBus::resetStats();
+        I2CBus::printStatus(Serial);
+    }, "i2c [reset]: I2C saat profilleri ve bus kullanimi");
+
+    config.commands().add("events", [](const char*) { events.printStatus(Serial); }, "Olay kurallari ve token durumu");
+
+#if DLS_FEATURE_ENERGY
+    config.commands().add("energy", [](const char* args) {
+        // "energy" report, "energy set <channel> <uA>", "energy battery <mAh>", "energy reset"
+        char cmd[12] = "", channel[12] = "";
+        unsigned long value = 0;
+        sscanf(args, "%11s", cmd);
+        if (strcasecmp(cmd, "set") == 0) {
+            if (sscanf(args, "%*s %11s %lu", channel, &value) != 2 || !Energy::setCurrent(channel, value)) {
+                Serial.println("ERR: energy set <cpu|radio|boot|wifi|ntp|sensor|heater|display|http|sleep> <uA>");
+                return;
+            }
+        } else if (strcasecmp(cmd, "battery") == 0) {
+            if (sscanf(args, "%*s %lu", &value) != 1 || value == 0) {
+                Serial.println("ERR: energy battery <mAh>");
+                return;
+            }
+            Energy::setBattery(value);
+        } else if (strcasecmp(cmd, "reset") == 0) {
+            Energy::reset();
+        }
+        Energy::printReport(Serial);
+    }, "energy [set <kanal> <uA>|battery <mAh>|reset]: Enerji tahmini");
+#endif
+
+#if DLS_FEATURE_ARCHIVE
+    config.commands().add("archive", [](const char* args) {
+        // "archive" status, "archive <tier> [hours]" dumps JSON
+        ArchiveTier tier;
+        char name[8] = "";
+        unsigned long hours = 24;
+        sscanf(args, "%7s %lu", name, &hours);
+        if (!*name || !Archive::parseTier(name, tier)) {
+            archive.printStatus(Serial);
+            return;
+        }
+        uint32_t now = network.getEpochTime();
+        archive.query(tier, now - hours * 3600UL, now, Serial);
+    }, "archive [raw|5m|1h] [saat]: gecmis veriler");
+#endif
+
+    config.commands().add("rec", [](const char* args) {
+        if (strcasecmp(args, "start") == 0) sampleLog.startRecording();
+        else if (strcasecmp(args, "stop") == 0) sampleLog.stopRecording();
+        else if (strcasecmp(args, "dump") == 0) sampleLog.dumpCsv(Serial);
+        else sampleLog.printStatus(Serial);
+    }, "rec [start|stop|dump]: ham sensor kaydi");
+
+    config.commands().add("replay", [](const char* args) {
+        if (strcasecmp(args, "stop") == 0) sampleLog.stopReplay();
+        else if (strcasecmp(args, "run") == 0) runReplay();
+        else sampleLog.startReplay(strcasecmp(args, "loop") == 0);
+    }, "replay [loop|stop|run]: kaydi sensor yerine oynat");
+
+#if DLS_FEATURE_OTA
+    config.commands().add("ota", [](const char* args) {
+        // "ota" checks the manifest, "ota status" reports, "ota <url> [md5]" flashes an image
+        if (strcasecmp(args, "status") == 0) {
+            ota.printStatus(Serial);
+            return;
+        }
+        bool started;
+        if (*args) {
+            String url = args;
+            String md5;
+            int space = url.indexOf(' ');
+            if (space > 0) {
+                md5 = url.substring(space + 1);
+                md5.trim();
+                url = url.substring(0, space);
+            }
+            started = ota.startImage(url, md5);
+        } else {
+            started = ota.checkNow();
+        }
+        Serial.println(started ? "OTA_STARTED" : "OTA_BUSY");
+    }, "ota [url [md5]] | ota status: HTTP uzerinden guncelle");
+#endif
+
+#if DLS_FEATURE_TRACE
+    config.commands().add("trace", [](const char* args) {
+        // "trace" dumps Chrome trace JSON; "trace on|off|clear" controls recording
+        if (strcasecmp(args, "on") == 0) Trace::enable(true);
+        else if (strcasecmp(args, "off") == 0) Trace::enable(false);
+        else if (strcasecmp(args, "clear") == 0) Trace::clear();
+        else {
+            Trace::writeJson(Serial);
+            return;
+        }
+        Serial.printf("Trace: %s, %lu olay\n", Trace::enabled() ? "acik" : "kapali", (unsigned long)Trace::count());
+    }, "trace [on|off|clear]: Chrome trace JSON dok");
+#endif
+
+#if DLS_FEATURE_BENCH
+    config.commands().add("bench", [](const char* args) {
+        if (strcasecmp(args, "reset") == 0) Bench::forgetRecorded(); // Next run records again
+        runBenchmarks();
+    }, "bench [reset]: Benchmarklari calistir (reset: kartta kayitli referanslari sil)");
+#endif
+}
+
+// Wi-Fi roaming or the ESP-NOW relay, per config. Returns right away.
+void startUplink(bool configured) {
+    if (configured && !relayUplink) {
+        for (uint8_t i = 1; i < config.getNetworkCount(); i++) {
+            network.addNetwork(config.getNetworkSSID(i), config.getNetworkPass(i));
+        }
+        network.begin(config.getSSID(), config.getPass(), LED_PIN);
+        BootTimeline::mark("wifi.start");
+
+#if DLS_FEATURE_MDNS
+        // 2b. mDNS (announced once connected)
+        String hostname = "dls-weather";
+        if (!config.getStationID().isEmpty() && config.getStationID() != "ST-XXXXX") {
+            hostname += "-" + config.getStationID();
+        }
+        network.startMDNS(hostname.c_str());
+#endif
+    }
+
+#if DLS_FEATURE_RELAY
+    // 2c. ESP-NOW relay: a node sends without associating, a gateway
+    // listens on its AP's channel
+    if (relayUplink) {
+        if (relayNode.begin(relayLink, config.getRelayPeer().c_str())) {
+            LOG_I("Relay", "Node, gateway %s", config.getRelayPeer().c_str());
+        }
+        BootTimeline::mark("relay.start");
+    } else if (configured && config.isRelayGateway()) {
+        relayGateway.begin(relayLink, config.getRelayPeers().c_str());
+        WiFi.setSleep(false); // Modem sleep would miss frames between beacons
+        LOG_I("Relay", "Gateway, MAC %s", WiFi.macAddress().c_str());
+        if (config.isDeepSleepEnabled()) LOG_W("Relay", "Gateway uyurken aktarim yapilamaz, deepSleep kapatin!");
+    }
+#endif
+}
 
 void setup() {
-    // 0. SENSOR POWER ON (MOSFET)
-    pinMode(SENSOR_PWR_PIN, OUTPUT);
-    digitalWrite(SENSOR_PWR_PIN, HIGH);
+    // 0. SENSOR POWER ON (MOSFET); Sensor::begin() waits out the boot time
+    sensorManager.setPowerPin(SENSOR_PWR_PIN);
     
-    Serial.begin(115200);
-    delay(3000); // Give sensors and serial time to stabilize
-    // 1. Ayarlari Yukle
-    config.begin();
+#if DLS_FEATURE_ENERGY
+    Energy::begin();
+#endif
 
     // Check reset reason
     isFromSleep = (esp_reset_reason() == ESP_RST_DEEPSLEEP);
+
+    Serial.begin(115200);
+    Log::begin();
+#if ARDUINO_USB_CDC_ON_BOOT
+    if (!isFromSleep) {
+        // Give an attached monitor a moment to open the USB port; returns
+        // as soon as it does
+        DLS_ENERGY_SCOPE(ENERGY_BOOT_DELAY);
+        unsigned long start = millis();
+        while (!Serial && millis() - start < 1000) delay(10);
+    }
+#endif
+    BootTimeline::mark("serial");
+
+    // 1. Ayarlari Yukle
+    config.begin();
+    registerCommands();
+#if DLS_FEATURE_OTA
+    ota.begin(config.getOtaUrl()); // Rolls back a new image that keeps failing
+#endif
     bootTime = millis();
+    BootTimeline::mark("config");
 
     config.checkSerialCommands(); // Boot sirasinda komut yakalama sansi
 
-    Serial.println("\n--- Yuklu Ayarlar ---");
-    Serial.println("SSID: " + config.getSSID());
-    Serial.println("Station ID: " + config.getStationID());
-    Serial.println("Interval: " + String(config.getInterval()) + " dk");
-    Serial.println("---------------------");
+    LOG_I("Config", "SSID: %s", config.getSSID().c_str());
+    LOG_I("Config", "Station ID: %s", config.getStationID().c_str());
+    LOG_I("Config", "Interval: %d dk", config.getInterval());
 
-    // 2. I2C Baslat
-    Wire.begin(I2C_SDA, I2C_SCL); 
+    // 2. Network Baslat: scan, association and DHCP run in the background
+    // while the rest of setup() probes the peripherals
+#if DLS_FEATURE_RELAY
+    relayUplink = config.isRelayNode();
+#endif
+    bool configured = relayUplink || !(config.getSSID() == "WIFI_SSID_GIRIN" || config.getSSID().isEmpty());
+#if !DLS_FEATURE_BENCH
+    startUplink(configured);
+#endif
 
-    // 3. Ekrani Baslat
-    display.begin(&Wire);
-    display.printStartup(config.getSSID());
+    // 3. I2C Baslat
+    I2CBus::begin(Wire, I2C_SDA, I2C_SCL); // Per-device clocks, see Bus/I2CBus.h
 
-    // 4. Ayar Kontrolu
-    if (config.getSSID() == "WIFI_SSID_GIRIN" || config.getSSID().isEmpty()) {
+    // 4. Ekrani Baslat
+    display.begin(&Wire);
+    display.printStartup(config.getSSID().c_str());
+    BootTimeline::mark("display");
+
+#if DLS_FEATURE_BENCH
+    // Bench images start the uplink only after the benchmarks: Wi-Fi, LwIP
+    // and the relay allocate from their own tasks, and the malloc counters
+    // would pick that up
+    runBenchmarks();
+    startUplink(configured);
+#endif
+
+    // 5. Ayar Kontrolu
+    if (!configured) {
         display.showMessage("Ayar Eksik!");
-        Serial.println("\n!!! AYARLAR EKSIK !!!");
-        Serial.println("Lutfen Serial/Docs uzerinden ayarlari girin.");
+        LOG_E("Config", "!!! AYARLAR EKSIK !!!");
+        LOG_E("Config", "Lutfen Serial/Docs uzerinden ayarlari girin.");
         while (true) {
             config.checkSerialCommands();
             delay(10);
         }
     }
 
-    // 5. Network Baslat
-    network.begin(config.getSSID(), config.getPass(), LED_PIN);
-    
-    // 5b. mDNS Baslat
-    String hostname = "dls-weather";
-    if (!config.getStationID().isEmpty() && config.getStationID() != "ST-XXXXX") {
-        hostname += "-" + config.getStationID();
-    }
-    network.startMDNS(hostname.c_str());
-
     // 6. Sensor Baslat
+    sensorManager.setGasInterval(config.getGasInterval());
+    sensorManager.attachLog(&sampleLog);
     sensorManager.begin(&Wire);
+    // Deep sleep already cuts the rail for the whole interval
+    sensorManager.setPowerGating(config.isSensorGatingEnabled() && !config.isDeepSleepEnabled());
+#if DLS_FEATURE_ARCHIVE
+    archive.begin();
+#endif
+    BootTimeline::mark("sensors");
+    metrics.setAltitude(config.getAltitude());
 
     // 7. DLS Weather Kutuphanesi
     dls = new DLSWeather(
@@ -152,29 +616,57 @@ void setup() {
         config.getLon()
     );
     dls->begin();
+#if DLS_FEATURE_MQTT
+    if (!relayUplink) mqtt.begin(config); // A relay node has no IP uplink
+#endif
 
+#if DLS_FEATURE_WEBSERVER
     // 8. Web Server
     server.on("/api/weather", HTTP_GET, handleWeatherAPI);
+#if DLS_FEATURE_TRACE
+    server.on("/api/trace", HTTP_GET, handleTraceAPI);
+#endif
+#if DLS_FEATURE_ARCHIVE
+    server.on("/api/archive", HTTP_GET, handleArchiveAPI);
+#endif
+#if DLS_FEATURE_ENERGY
+    server.on("/api/energy", HTTP_GET, handleEnergyAPI);
+#endif
+#if DLS_FEATURE_DASHBOARD
+    dashboard.begin(server, apiLimiter);
+#endif
     server.onNotFound(handleNotFound);
     server.begin();
-    Serial.println("API Server Baslatildi.");
+    LOG_I("API", "Server Baslatildi.");
+#endif
+    BootTimeline::mark("setup.done");
 }
 
 void loop() {
-    network.update(); // Handles generic network tasks (e.g. WiFi KeepAlive if implemented)
-    server.handleClient(); // Handle API stats
+    if (!relayUplink) network.update(); // Handles generic network tasks (e.g. WiFi KeepAlive if implemented)
     config.checkSerialCommands();
+#if DLS_FEATURE_OTA
+    ota.update(network.isConnected()); // Periodic manifest check; download runs in its own task
+#endif
     
     // --- DISPLAY UPDATE LOOP ---
     display.update();
     
     // Update Network Info on Display
     bool isConnected = network.isConnected();
+#if DLS_FEATURE_MQTT
+    mqtt.loop(isConnected); // Keeps the session alive between cycles
+#endif
     if (isConnected) {
         // WiFi localIP requires WiFi.h which is included in DLSNetwork.h
-        display.setNetworkInfo(WiFi.localIP().toString(), config.getSSID(), "Online", true);
+        IPAddress ip = WiFi.localIP();
+        char ipStr[16];
+        snprintf(ipStr, sizeof(ipStr), "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+        display.setNetworkInfo(ipStr, network.getSSID().c_str(), "Online", true);
+    } else if (relayUplink) {
+        display.setNetworkInfo("ESP-NOW", config.getRelayPeer().c_str(), "Relay", true);
     } else {
-        display.setNetworkInfo("0.0.0.0", config.getSSID(), "Offline", false);
+        display.setNetworkInfo("0.0.0.0", config.getSSID().c_str(), "Offline", false);
     }
 
     int currentMinute = network.getMinutes();
@@ -191,109 +683,145 @@ void loop() {
         if (config.isDeepSleepEnabled() && !isFromSleep) {
             if (millis() - bootTime > 300000) {
                 shouldAttempt = true;
-                Serial.println("\n[DeepSleep] Startup delay finished. Triggering first broadcast.");
+                LOG_I("DeepSleep", "Startup delay finished. Triggering first broadcast.");
             } else {
                 static unsigned long lastMsg = 0;
                 if (millis() - lastMsg > 60000) {
                     lastMsg = millis();
-                    Serial.print("[DeepSleep] Waiting for config window... ");
-                    Serial.print((300000 - (millis() - bootTime)) / 1000);
-                    Serial.println("s remaining.");
+                    LOG_I("DeepSleep", "Waiting for config window... %lus remaining.",
+                          (300000 - (millis() - bootTime)) / 1000);
                 }
+#if DLS_FEATURE_WEBSERVER
                 // Ayar gelme ihtimaline karsi Web Server'i calistir
                 server.handleClient();
+#endif
             }
         } else if (isFromSleep) {
             // Uykudan uyanmissak hemen gonder (zaten uyku suresi doldu)
             shouldAttempt = true;
-            Serial.println("\n[DeepSleep] Wake-up detected. Sending data immediately.");
+            LOG_I("DeepSleep", "Wake-up detected. Sending data immediately.");
         } else {
             // Normal modda hemen basla
             shouldAttempt = true;
         }
     } else if (isScheduledTime) {
         shouldAttempt = true;
+    } else if (pendingEvent) {
+        // Out-of-band upload, paid from the event token bucket
+        if (config.isEventUploadEnabled() && (isConnected || relayUplink) && !config.isDeepSleepEnabled() &&
+            events.takeToken(millis())) {
+            shouldAttempt = true;
+            LOG_I("Event", "%s, hemen gonderiliyor...", pendingEvent->name);
+        } else {
+            LOG_I("Event", "%s, siradaki gonderime kaldi.", pendingEvent->name);
+        }
+        pendingEvent = nullptr;
     } else if (pendingRetry && (millis() - lastAttemptTime > 60000)) {
         // Retry every 1 minute if failed (user requested 1 min for testing)
         shouldAttempt = true;
-        Serial.println("\n[Retry] Re-attempting failed broadcast...");
+        LOG_I("Retry", "Re-attempting failed broadcast...");
+    }
+
+    // The first upload waits for the background connect and the first NTP
+    // answer (bounded, as the old blocking connect was); sensors are
+    // sampled for the display and API meanwhile
+    if (shouldAttempt && firstRun && !relayUplink && !(isConnected && network.isTimeSynced()) &&
+        millis() - bootTime < BOOT_NET_WAIT_MS) {
+        shouldAttempt = false;
     }
 
     if (shouldAttempt) {
         lastAttemptTime = millis();
         if (firstRun) {
-            Serial.println("\n--- Ilk Acilis Verisi Hazirlaniyor ---");
+            LOG_I(nullptr, "--- Ilk Acilis Verisi Hazirlaniyor ---");
         } else if (isScheduledTime) {
-            Serial.println("\n--- Zamani Geldi, Veriler Okunuyor ---");
+            LOG_I(nullptr, "--- Zamani Geldi, Veriler Okunuyor ---");
         }
         
         // --- 1. SENSOR OKUMA ---
-        sensorManager.getAirData(latestAir);
-        sensorManager.getLightData(latestLight);
+        sampleSensors();
         // Placeholder for future Wind/Rain
         // sensorManager.getWindData(latestWind);
         // sensorManager.getRainData(latestRain);
 
-        // --- Display Data Update ---
-        // Pass -999.0 if invalid, implementation handles printing "NaN"
-        float gasRes = (latestAir.valid && latestAir.gasResistance > 0) ? latestAir.gasResistance : -999.0;
-        display.setAirData(
-            latestAir.valid ? latestAir.temperature : -999.0,
-            latestAir.valid ? latestAir.humidity : -999.0,
-            latestAir.valid ? latestAir.pressure : -999.0,
-            gasRes
-        );
-        
-        display.setLightData(
-            latestLight.valid ? latestLight.uvIndex : -1.0,
-            -1.0 // Lux placeholder
-        );
-        
-        display.setWindData(-1.0, -1.0); // Speed, Dir
-        display.setRainData(-1.0, -1.0); // Rate, Daily
-
         // --- Serial Monitor Log ---
-        Serial.println("\n[Sensor Data]");
         if (latestAir.valid) {
-            Serial.print("Temp: "); Serial.print(latestAir.temperature); Serial.println(" C");
+            LOG_I("Sensor Data", "Temp: %.2f C", latestAir.temperature);
             if (latestAir.humidity != -999.0) {
-                Serial.print("Hum:  "); Serial.print(latestAir.humidity); Serial.println(" %");
+                LOG_I("Sensor Data", "Hum:  %.2f %%", latestAir.humidity);
+            }
+            LOG_I("Sensor Data", "Pres: %.2f hPa", latestAir.pressure);
+            if (metrics.get().dewPoint != -999.0) {
+                LOG_I("Sensor Data", "Dew:  %.2f C", metrics.get().dewPoint);
             }
-            Serial.print("Pres: "); Serial.print(latestAir.pressure); Serial.println(" hPa");
             if (latestAir.gasResistance > 0) {
-                Serial.print("Gas:  "); Serial.print(latestAir.gasResistance); Serial.println(" KOhms");
+                LOG_I("Sensor Data", "Gas:  %.2f KOhms", latestAir.gasResistance);
+            }
+            if (latestAir.iaq != -999.0) {
+                LOG_I("Sensor Data", "IAQ:  %.0f (acc %d)", latestAir.iaq, (int)latestAir.iaqAccuracy);
             }
         } 
 
         if (latestLight.valid) {
-            Serial.print("UV Idx: "); Serial.println(latestLight.uvIndex);
+            LOG_I("Sensor Data", "UV Idx: %.2f", latestLight.uvIndex);
         }
-        Serial.println("----------------");
 
         // --- 2. DLS Kutuphanesine Yazma (VALIDATION CHECK) ---
         if (latestAir.valid) {
             if (latestAir.temperature != -999.0) dls->temperature(latestAir.temperature);
             if (latestAir.humidity != -999.0)    dls->humidity(latestAir.humidity);
             if (latestAir.pressure != -999.0)    dls->pressure(latestAir.pressure);
-            if (latestAir.gasResistance > 0 && latestAir.gasResistance != -999.0) 
-                dls->airQuality(latestAir.gasResistance);
+            if (latestAir.iaq != -999.0)         dls->airQuality(latestAir.iaq);
         }
 
         if (latestLight.valid) {
              if (latestLight.uvIndex != -1.0) dls->uvIndex(latestLight.uvIndex);
         }
 
+#if DLS_FEATURE_MQTT
+        // Queued in RTC memory while offline, published with the next batch
+        if (!sampleLog.isReplaying()) mqtt.addSample(network.getEpochTime(), latestAir, latestLight, metrics.get());
+#endif
+
         // --- 3. Gonderim (Sadece bagliysa) ---
-        if (isConnected) {
+        if (sampleLog.isReplaying()) {
+            // Replayed data must never reach the live station
+            LOG_W("Rec", "Replay aktif, gonderim atlandi.");
+            lastSentMinute = currentMinute;
+            firstRun = false;
+            pendingRetry = false;
+        } else if (isConnected || relayUplink) {
             display.setStatus("Sending...");
             display.update(); // Force update to show sending
             
-            if (dls->send(network.getEpochTime())) {
-                Serial.println("Basariyla gonderildi.");
+            bool sent;
+#if DLS_FEATURE_RELAY
+            if (relayUplink) {
+                DLS_TRACE_SCOPE("relay.send");
+                sent = sendRelayed();
+            } else
+#endif
+            {
+                DLS_TRACE_SCOPE("dls.send");
+                DLS_ENERGY_SCOPE(ENERGY_HTTP);
+                sent = dls->send(network.getEpochTime());
+            }
+            if (sent) {
+                LOG_I("DLS", "Basariyla gonderildi.");
+                if (!BootTimeline::has("first.upload")) {
+                    BootTimeline::mark("first.upload");
+                    BootTimeline::print(Serial);
+                }
                 display.setStatus("Success!");
                 lastSentMinute = currentMinute;
                 firstRun = false; 
                 pendingRetry = false;
+#if DLS_FEATURE_OTA
+                ota.markValid(); // First successful upload confirms a freshly flashed image
+#endif
+#if DLS_FEATURE_RELAY
+                if (config.isRelayGateway()) relayGateway.flush(); // Uplink is warm, send the batch too
+#endif
 
                 // --- DEEP SLEEP CHECK ---
                 if (config.isDeepSleepEnabled()) {
@@ -303,38 +831,58 @@ void loop() {
                     // Full interval sleep as requested (prevent drift alignment errors)
                     long sleepSeconds = (long)interval * 60;
 
-                    Serial.print("\n[DeepSleep] Entering sleep for ");
-                    Serial.print(sleepSeconds);
-                    Serial.println(" seconds... ");
+                    LOG_I("DeepSleep", "Entering sleep for %ld seconds... ", sleepSeconds);
                     
+#if DLS_FEATURE_OTA
+                    // Let a running download finish; success restarts into the new image
+                    while (ota.isBusy()) delay(100);
+#endif
+#if DLS_FEATURE_MQTT
+                    mqtt.flush(); // Unacked samples stay in RTC memory for the next wake-up
+#endif
+
                     display.setStatus("Sleeping...");
                     display.update();
                     delay(2000); // Give time for display/serial
                     
                     display.off(); // Clear and turn off screen
                     
+                    sensorManager.saveState(); // Keep the IAQ baseline across power loss
+
                     // SENSOR POWER OFF (MOSFET)
-                    digitalWrite(SENSOR_PWR_PIN, LOW);
+                    sensorManager.setRail(false);
+
+#if DLS_FEATURE_ENERGY
+                    Energy::endCycle(sleepSeconds); // Books the coming sleep with this cycle
+#endif
 
                     // ESP32 deep sleep takes microseconds
                     esp_sleep_enable_timer_wakeup((uint64_t)sleepSeconds * 1000000);
+                    Log::flush();
                     esp_deep_sleep_start();
                 }
             } else {
-                int errCode = dls->getLastCode();
-                Serial.print("[Retry] Gonderme hatasi! Kod: "); Serial.println(errCode);
+                int errCode = relayUplink ? 0 : dls->getLastCode();
+                if (relayUplink) LOG_W("Retry", "Gateway yanit vermedi!");
+                else LOG_W("Retry", "Gonderme hatasi! Kod: %d", errCode);
                 
-                String errStr;
-                if (errCode == -1) errStr = "WiFi Err";
-                else if (errCode > 0) errStr = "HTTP " + String(errCode);
-                else errStr = "Conn Err";
+                char errStr[16];
+                if (relayUplink) strcpy(errStr, "No Gateway");
+                else if (errCode == -1) strcpy(errStr, "WiFi Err");
+                else if (errCode > 0) snprintf(errStr, sizeof(errStr), "HTTP %d", errCode);
+                else strcpy(errStr, "Conn Err");
                 
                 display.setStatus(errStr, true);
                 pendingRetry = true;
                 firstRun = false;
             }
+#if DLS_FEATURE_ENERGY
+            // Always-on nodes close a cycle per upload attempt; sleeping
+            // nodes keep a failed attempt in the cycle that ends in sleep
+            if (!config.isDeepSleepEnabled()) Energy::endCycle(0);
+#endif
         } else {
-            Serial.println("[Retry] WiFi bagli degil! 1 dk sonra tekrar denenecek.");
+            LOG_W("Retry", "WiFi bagli degil! 1 dk sonra tekrar denenecek.");
             display.setStatus("No WiFi", true);
             pendingRetry = true;
             firstRun = false;
@@ -349,32 +897,23 @@ void loop() {
         // NO, reading I2C too fast is bad. Every 2-5 seconds is good.
         
         static unsigned long lastSensorRead = 0;
-        if (millis() - lastSensorRead > 2000) {
+        if (lastSensorRead == 0 || millis() - lastSensorRead > 2000) {
             lastSensorRead = millis();
-            sensorManager.getAirData(latestAir);
-            sensorManager.getLightData(latestLight);
-            
-            // Update Display Immediate (Optional, display.update() handles paging, but data setters need calling)
-            // But we already set data inside the upload block. 
-            // We should move set*Data calls OUTSIDE the upload block to keep display fresh.
-            
-            float gasRes = (latestAir.valid && latestAir.gasResistance > 0) ? latestAir.gasResistance : -999.0;
-            display.setAirData(
-                latestAir.valid ? latestAir.temperature : -999.0,
-                latestAir.valid ? latestAir.humidity : -999.0,
-                latestAir.valid ? latestAir.pressure : -999.0,
-                gasRes
-            );
-            
-            display.setLightData(
-                latestLight.valid ? latestLight.uvIndex : -1.0,
-                -1.0 
-            );
-            // Wind/Rain placeholdes
-            display.setWindData(-1.0, -1.0);
-            display.setRainData(-1.0, -1.0); 
+            sampleSensors();
         }
     }
 
+#if DLS_FEATURE_RELAY
+    if (config.isRelayGateway()) {
+        relayGateway.update(isConnected && network.isTimeSynced(), network.getEpochTime(), forwardRelayed);
+    }
+#endif
+
+#if DLS_FEATURE_WEBSERVER
+    // API last: sampling and uploads due in this pass have already run, and
+    // at most one request is served per pass
+    server.handleClient();
+#endif
+
     delay(10); // Short delay for stability
 }
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Wire.h>
+#include <FakeSensor.h>
+
+// reading: temperature, humidity, pressure
+class Adafruit_BME280 {
+public:
+    static inline FakeSensor fake;
+
+    bool begin(uint8_t addr = 0x77, TwoWire* = &Wire) { return fake.fitted; }
+    void setSampling() {}
+    float readTemperature() { return fake.read(0); }
+    float readHumidity() { return fake.reading[1]; }
+    float readPressure() { return fake.reading[2]; }
+};
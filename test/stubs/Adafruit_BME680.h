@@ -0,0 +1,43 @@
+#pragma once
+
+#include <FakeSensor.h>
+
+#define BME680_OS_NONE 0
+#define BME680_OS_1X 1
+#define BME680_OS_2X 2
+#define BME680_OS_4X 3
+#define BME680_OS_8X 4
+#define BME680_OS_16X 5
+#define BME680_FILTER_SIZE_0 0
+#define BME680_FILTER_SIZE_3 2
+
+// reading: temperature, humidity, pressure, gas. The gas channel is only
+// measured while the heater is on, as on the part.
+class Adafruit_BME680 {
+public:
+    static inline FakeSensor fake;
+
+    bool begin(uint8_t addr = 0x77, bool = true) { return fake.fitted; }
+    bool setTemperatureOversampling(uint8_t) { return fake.fitted; }
+    bool setHumidityOversampling(uint8_t) { return fake.fitted; }
+    bool setPressureOversampling(uint8_t) { return fake.fitted; }
+    bool setIIRFilterSize(uint8_t) { return fake.fitted; }
+    bool setGasHeater(uint16_t celsius, uint16_t ms) {
+        heaterOn = celsius != 0 && ms != 0;
+        return fake.fitted;
+    }
+    bool performReading() {
+        if (!fake.fitted || isnan(fake.reading[0])) return false;
+        temperature = fake.read(0);
+        humidity = fake.reading[1];
+        pressure = (uint32_t)fake.reading[2];
+        gas_resistance = heaterOn ? (uint32_t)fake.reading[3] : 0;
+        return true;
+    }
+
+    float temperature = 0;
+    uint32_t pressure = 0;
+    float humidity = 0;
+    uint32_t gas_resistance = 0;
+    bool heaterOn = false;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Host stand-in for Adafruit_GFX. Lines, circles and text placement follow
+// the library's own algorithms pixel for pixel, so shapes land where they
+// do on the OLED. The classic 5x7 font is not copied: each printable
+// character gets a fixed pattern derived from its code instead, which keeps
+// the 6x8 cell, the cursor advance and the wrap of the real font.
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        drawLine(x, y, x, y + h - 1, color);
+    }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        drawLine(x, y, x + w - 1, y, color);
+    }
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+    }
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+    // Bresenham, as writeLine()
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        bool steep = abs(y1 - y0) > abs(x1 - x0);
+        if (steep) {
+            std::swap(x0, y0);
+            std::swap(x1, y1);
+        }
+        if (x0 > x1) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+        int16_t dx = x1 - x0, dy = abs(y1 - y0);
+        int16_t err = dx / 2;
+        int16_t ystep = y0 < y1 ? 1 : -1;
+        for (; x0 <= x1; x0++) {
+            if (steep) drawPixel(y0, x0, color);
+            else drawPixel(x0, y0, color);
+            err -= dy;
+            if (err < 0) {
+                y0 += ystep;
+                err += dx;
+            }
+        }
+    }
+
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+        drawPixel(x0, y0 + r, color);
+        drawPixel(x0, y0 - r, color);
+        drawPixel(x0 + r, y0, color);
+        drawPixel(x0 - r, y0, color);
+        while (x < y) {
+            if (f >= 0) {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x;
+            drawPixel(x0 + x, y0 + y, color);
+            drawPixel(x0 - x, y0 + y, color);
+            drawPixel(x0 + x, y0 - y, color);
+            drawPixel(x0 - x, y0 - y, color);
+            drawPixel(x0 + y, y0 + x, color);
+            drawPixel(x0 - y, y0 + x, color);
+            drawPixel(x0 + y, y0 - x, color);
+            drawPixel(x0 - y, y0 - x, color);
+        }
+    }
+
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+        fillCircleHelper(x0, y0, r, 3, 0, color);
+    }
+
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+        int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r, px = x, py = y;
+        delta++;
+        while (x < y) {
+            if (f >= 0) {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x;
+            if (x < y + 1) {
+                if (corners & 1) drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+                if (corners & 2) drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+            }
+            if (y != py) {
+                if (corners & 1) drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+                if (corners & 2) drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+                py = y;
+            }
+            px = x;
+        }
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+        if (x >= _width || y >= _height || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0) return;
+        for (int8_t i = 0; i < 5; i++) {
+            uint8_t line = glyphColumn(c, i);
+            for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                if (line & 1) fillRect(x + i * size, y + j * size, size, size, color);
+                else if (bg != color) fillRect(x + i * size, y + j * size, size, size, bg);
+            }
+        }
+        if (bg != color) fillRect(x + 5 * size, y, size, 8 * size, bg);
+    }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            _cursorX = 0;
+            _cursorY += _textSize * 8;
+        } else if (c != '\r') {
+            if (_wrap && _cursorX + _textSize * 6 > _width) {
+                _cursorX = 0;
+                _cursorY += _textSize * 8;
+            }
+            drawChar(_cursorX, _cursorY, c, _textColor, _textBg, _textSize);
+            _cursorX += _textSize * 6;
+        }
+        return 1;
+    }
+    using Print::write;
+
+    void setCursor(int16_t x, int16_t y) {
+        _cursorX = x;
+        _cursorY = y;
+    }
+    void setTextSize(uint8_t s) { _textSize = s > 0 ? s : 1; }
+    void setTextColor(uint16_t c) { _textColor = _textBg = c; } // Transparent background
+    void setTextColor(uint16_t c, uint16_t bg) {
+        _textColor = c;
+        _textBg = bg;
+    }
+    void setTextWrap(bool w) { _wrap = w; }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    int16_t getCursorX() const { return _cursorX; }
+    int16_t getCursorY() const { return _cursorY; }
+
+protected:
+    // Stand-in glyph: five 7-bit columns from the character code; blank
+    // for space and control characters
+    static uint8_t glyphColumn(unsigned char c, int8_t i) {
+        if (c <= ' ' || c == 0x7F) return 0;
+        uint32_t h = c * 2654435761u;
+        return ((h >> (i * 5)) & 0x7F) | (i == 0 ? 0x01 : 0);
+    }
+
+    int16_t _width;
+    int16_t _height;
+    int16_t _cursorX = 0;
+    int16_t _cursorY = 0;
+    uint16_t _textColor = 0xFFFF;
+    uint16_t _textBg = 0xFFFF;
+    uint8_t _textSize = 1;
+    bool _wrap = true;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <FakeSensor.h>
+
+// reading: temperature, humidity
+class Adafruit_SHT31 {
+public:
+    static inline FakeSensor fake;
+
+    bool begin(uint8_t addr = 0x44) { return fake.fitted; }
+    float readTemperature() { return fake.read(0); }
+    float readHumidity() { return fake.reading[1]; }
+};
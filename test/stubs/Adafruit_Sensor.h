@@ -0,0 +1,9 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Only the fields the SHTC3 read path uses
+typedef struct {
+    float temperature;
+    float relative_humidity;
+} sensors_event_t;
@@ -0,0 +1,166 @@
+#pragma once
+
+// Host stand-in for the Arduino core, just enough for the modules built by
+// the native environment (see build_src_filter in platformio.ini). Time only
+// moves when a test moves it: millis() returns Host::nowMs, and delay()
+// advances it.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x13
+
+#define F(x) x
+#define PROGMEM
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+using std::isnan;
+using std::max; // As in the ESP32 core
+using std::min;
+
+namespace Host {
+inline uint32_t nowMs = 0;
+inline uint64_t extraUs = 0; // Sub-millisecond time, e.g. I2C transfers
+
+// GPIO hooks for fakes that model a line (see Wire.h); unset pins read HIGH
+inline void (*pinWrite)(uint8_t pin, uint8_t level) = nullptr;
+inline int (*pinRead)(uint8_t pin) = nullptr;
+}
+
+inline unsigned long millis() { return Host::nowMs; }
+inline unsigned long micros() { return (unsigned long)(Host::nowMs * 1000ULL + Host::extraUs); }
+inline void delay(unsigned long ms) { Host::nowMs += ms; }
+inline void delayMicroseconds(unsigned int us) { Host::extraUs += us; }
+inline void yield() {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+    if (Host::pinWrite) Host::pinWrite(pin, level);
+}
+inline int digitalRead(uint8_t pin) { return Host::pinRead ? Host::pinRead(pin) : HIGH; }
+
+class String {
+public:
+    String(const char* s = "") : _s(s ? s : "") {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int v) : _s(std::to_string(v)) {}
+    explicit String(unsigned int v) : _s(std::to_string(v)) {}
+    explicit String(long v) : _s(std::to_string(v)) {}
+    explicit String(unsigned long v) : _s(std::to_string(v)) {}
+    explicit String(double v, unsigned int decimals = 2) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        _s = buf;
+    }
+    const char* c_str() const { return _s.c_str(); }
+    unsigned int length() const { return _s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    bool operator==(const char* o) const { return _s == o; }
+    bool operator==(const String &o) const { return _s == o._s; }
+    bool operator!=(const char* o) const { return _s != o; }
+    bool operator!=(const String &o) const { return _s != o._s; }
+    bool concat(const char* o) { if (o) _s += o; return o != nullptr; }
+    bool concat(const char* o, unsigned int n) { if (o) _s.append(o, n); return o != nullptr; }
+    bool concat(const String &o) { _s += o._s; return true; }
+    bool concat(char c) { _s += c; return true; }
+    String &operator+=(const char* o) { concat(o); return *this; }
+    String &operator+=(const String &o) { concat(o); return *this; }
+    String &operator+=(char c) { concat(c); return *this; }
+
+private:
+    std::string _s;
+};
+
+// Concatenation as in WString.h: the result is a StringSumHelper
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String &s) : String(s) {}
+};
+
+inline StringSumHelper operator+(const String &a, const String &b) {
+    StringSumHelper r(a);
+    r += b;
+    return r;
+}
+inline StringSumHelper operator+(const String &a, const char* b) { return a + String(b); }
+inline StringSumHelper operator+(const char* a, const String &b) { return String(a) + b; }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t n) {
+        for (size_t i = 0; i < n; i++) write(buf[i]);
+        return n;
+    }
+    size_t write(const char* s) { return write(reinterpret_cast<const uint8_t*>(s), strlen(s)); }
+    virtual void flush() {}
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (n < 0) return 0;
+        return write(reinterpret_cast<const uint8_t*>(buf), (size_t)n < sizeof(buf) ? n : sizeof(buf) - 1);
+    }
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t println(const char* s = "") { return write(s) + write("\r\n"); }
+    size_t println(const String &s) { return println(s.c_str()); }
+};
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() { return -1; }
+};
+
+// Serial goes to stdout, so a failing test shows what the module printed
+class HardwareSerial : public Stream {
+public:
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    void begin(unsigned long) {}
+};
+
+inline HardwareSerial Serial;
+
+namespace Host {
+inline uint32_t restarts = 0; // ESP.restart() calls; the process keeps running
+}
+
+class EspClass {
+public:
+    void restart() { Host::restarts++; }
+};
+
+inline EspClass ESP;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+// In-memory File: a test writes bytes into it, then reads them back the way
+// the archive reads a page from LittleFS. Copies share the bytes, like two
+// handles on one file; a File opened on a missing path is false.
+class File : public Stream {
+public:
+    typedef std::shared_ptr<std::vector<uint8_t>> Bytes;
+
+    File() : _data(std::make_shared<std::vector<uint8_t>>()) {}
+    explicit File(Bytes data, size_t pos = 0) : _data(std::move(data)), _pos(pos) {}
+
+    size_t write(uint8_t c) override {
+        _data->push_back(c);
+        return 1;
+    }
+    using Print::write;
+    int available() override { return (int)(_data->size() - _pos); }
+    int read() override { return _pos < _data->size() ? (*_data)[_pos++] : -1; }
+    int read(uint8_t* buf, size_t len) {
+        size_t n = _data->size() - _pos < len ? _data->size() - _pos : len;
+        memcpy(buf, _data->data() + _pos, n);
+        _pos += n;
+        return (int)n;
+    }
+    bool seek(size_t pos) {
+        if (pos > _data->size()) return false;
+        _pos = pos;
+        return true;
+    }
+    size_t size() const { return _data ? _data->size() : 0; }
+    void close() {}
+    operator bool() const { return _data != nullptr; }
+
+private:
+    Bytes _data;
+    size_t _pos = 0;
+};
+
+// Paths to bytes; "w" truncates, "a" appends, "r" fails on a missing path
+class FS {
+public:
+    bool begin(bool formatOnFail = false) {
+        (void)formatOnFail;
+        return true;
+    }
+    void end() {}
+
+    File open(const char* path, const char* mode = "r") {
+        auto it = _files.find(path);
+        if (mode[0] == 'r') return it == _files.end() ? File(nullptr) : File(it->second);
+        File::Bytes &data = _files[path];
+        if (!data) data = std::make_shared<std::vector<uint8_t>>();
+        if (mode[0] == 'w') data->clear();
+        return File(data, data->size());
+    }
+    bool exists(const char* path) const { return _files.count(path) > 0; }
+    bool remove(const char* path) { return _files.erase(path) > 0; }
+    void format() { _files.clear(); }
+
+private:
+    std::map<std::string, File::Bytes> _files;
+};
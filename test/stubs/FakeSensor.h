@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Shared by the fake Adafruit drivers in test/stubs. A test fits a part by
+// setting its `fitted` flag and sets what the next conversion returns in
+// `reading` (driver units: C, %RH, Pa, Ohm, UV counts); a part that is not
+// fitted fails begin(). Each driver class has its own FakeSensor, so a test
+// can fit any combination.
+struct FakeSensor {
+    bool fitted = false;
+    float reading[4] = {NAN, NAN, NAN, NAN};
+    uint32_t conversions = 0;
+
+    void set(float a, float b = NAN, float c = NAN, float d = NAN) {
+        reading[0] = a;
+        reading[1] = b;
+        reading[2] = c;
+        reading[3] = d;
+    }
+    float read(uint8_t channel) {
+        conversions++;
+        return reading[channel];
+    }
+};
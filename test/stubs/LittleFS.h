@@ -0,0 +1,6 @@
+#pragma once
+
+#include <FS.h>
+
+// The data partition, in memory (see FS.h)
+inline FS LittleFS;
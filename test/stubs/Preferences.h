@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+// In-memory NVS. Namespaces live for the whole test run, so a second
+// Preferences opened on the same namespace sees what the first wrote, as
+// after a reboot. Host::nvs() clears it between tests.
+namespace Host {
+typedef std::map<std::string, std::vector<uint8_t>> NvsNamespace;
+inline std::map<std::string, NvsNamespace> &nvs() {
+    static std::map<std::string, NvsNamespace> store;
+    return store;
+}
+}
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false, const char* = nullptr) {
+        _ns = &Host::nvs()[name];
+        _readOnly = readOnly;
+        return true;
+    }
+    void end() { _ns = nullptr; }
+
+    bool clear() {
+        if (!_ns || _readOnly) return false;
+        _ns->clear();
+        return true;
+    }
+    bool remove(const char* key) { return _ns && !_readOnly && _ns->erase(key) > 0; }
+    bool isKey(const char* key) const { return _ns && _ns->count(key); }
+
+    size_t putBytes(const char* key, const void* value, size_t len) {
+        if (!_ns || _readOnly) return 0;
+        const uint8_t* p = static_cast<const uint8_t*>(value);
+        (*_ns)[key].assign(p, p + len);
+        return len;
+    }
+    size_t getBytesLength(const char* key) const {
+        auto it = find(key);
+        return it ? it->size() : 0;
+    }
+    size_t getBytes(const char* key, void* buf, size_t maxLen) const {
+        auto it = find(key);
+        if (!it || it->size() > maxLen) return 0;
+        memcpy(buf, it->data(), it->size());
+        return it->size();
+    }
+
+    size_t putString(const char* key, const String &value) { return putBytes(key, value.c_str(), value.length()); }
+    String getString(const char* key, const String &defaultValue = String()) const {
+        auto it = find(key);
+        if (!it) return defaultValue;
+        return String(std::string(it->begin(), it->end()).c_str());
+    }
+
+    size_t putBool(const char* key, bool value) { return put(key, (uint8_t)value); }
+    bool getBool(const char* key, bool defaultValue = false) const { return get(key, (uint8_t)defaultValue) != 0; }
+    size_t putUChar(const char* key, uint8_t value) { return put(key, value); }
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) const { return get(key, defaultValue); }
+    size_t putUShort(const char* key, uint16_t value) { return put(key, value); }
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) const { return get(key, defaultValue); }
+    size_t putInt(const char* key, int32_t value) { return put(key, value); }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) const { return get(key, defaultValue); }
+    size_t putUInt(const char* key, uint32_t value) { return put(key, value); }
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) const { return get(key, defaultValue); }
+    size_t putFloat(const char* key, float value) { return put(key, value); }
+    float getFloat(const char* key, float defaultValue = NAN) const { return get(key, defaultValue); }
+
+private:
+    const std::vector<uint8_t>* find(const char* key) const {
+        if (!_ns) return nullptr;
+        auto it = _ns->find(key);
+        return it == _ns->end() ? nullptr : &it->second;
+    }
+    template <typename T> size_t put(const char* key, T value) { return putBytes(key, &value, sizeof(value)); }
+    template <typename T> T get(const char* key, T defaultValue) const {
+        T value;
+        return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+    }
+
+    Host::NvsNamespace* _ns = nullptr;
+    bool _readOnly = false;
+};
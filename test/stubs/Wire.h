@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Fault-injecting fake of the Arduino TwoWire. Devices present on the bus
+// ACK their address; anything else NACKs. A test can make the next
+// transfers fail, make them time out (each costs the configured timeout),
+// or have a slave hold SDA low until it has seen a number of SCL pulses,
+// which is what I2CBus::recover() must clear.
+
+#define I2C_ERROR_NACK_ADDR 2
+#define I2C_ERROR_TIMEOUT 5
+
+class TwoWire {
+public:
+    // --- Fault Injection ---
+    void attach(uint8_t addr) { _present[addr & 0x7F] = true; }
+    void detach(uint8_t addr) { _present[addr & 0x7F] = false; }
+    void failNext(uint8_t count, uint8_t error = I2C_ERROR_TIMEOUT) {
+        _failCount = count;
+        _failError = error;
+    }
+    // The slave releases SDA after this many SCL pulses (255: never)
+    void holdSda(uint8_t pulses) {
+        _sdaHeldFor = pulses;
+        installPins(this);
+    }
+
+    // --- Observed ---
+    uint32_t clock() const { return _clock; }
+    uint16_t timeoutMs() const { return _timeoutMs; }
+    uint32_t transfers = 0;
+    uint32_t sclPulses = 0;
+    uint32_t restarts = 0; // begin() after end()
+
+    // --- TwoWire API ---
+    bool begin(int sda, int scl, uint32_t frequency) {
+        _sda = sda;
+        _scl = scl;
+        _clock = frequency;
+        if (!_running && _started) restarts++;
+        _running = _started = true;
+        return true;
+    }
+    bool end() {
+        bool was = _running;
+        _running = false;
+        return was;
+    }
+    void setClock(uint32_t frequency) { _clock = frequency; }
+    void setTimeOut(uint16_t ms) { _timeoutMs = ms; }
+
+    void beginTransmission(uint8_t addr) { _addr = addr & 0x7F; }
+    size_t write(uint8_t) { return 1; }
+    uint8_t endTransmission(bool = true) { return transfer(); }
+    uint8_t requestFrom(uint8_t addr, uint8_t len, bool = true) {
+        _addr = addr & 0x7F;
+        return transfer() == 0 ? len : 0;
+    }
+    int available() { return 0; }
+    int read() { return -1; }
+
+private:
+    uint8_t transfer() {
+        transfers++;
+        if (_sdaHeldFor || _failCount) {
+            if (_failCount) _failCount--;
+            if (_failError == I2C_ERROR_TIMEOUT || _sdaHeldFor) Host::nowMs += _timeoutMs;
+            return _sdaHeldFor ? I2C_ERROR_TIMEOUT : _failError;
+        }
+        return _present[_addr] ? 0 : I2C_ERROR_NACK_ADDR;
+    }
+
+    // Models the two lines through the Arduino.h GPIO hooks
+    static void installPins(TwoWire* bus) {
+        _bus = bus;
+        Host::pinWrite = [](uint8_t pin, uint8_t level) {
+            if (pin != _bus->_scl) return;
+            if (level == HIGH && !_bus->_sclHigh) {
+                _bus->sclPulses++;
+                if (_bus->_sdaHeldFor && _bus->_sdaHeldFor != 255) _bus->_sdaHeldFor--;
+            }
+            _bus->_sclHigh = level == HIGH;
+        };
+        Host::pinRead = [](uint8_t pin) -> int {
+            if (pin == _bus->_sda) return _bus->_sdaHeldFor ? LOW : HIGH;
+            return HIGH;
+        };
+    }
+
+    static inline TwoWire* _bus = nullptr;
+
+    bool _present[128] = {};
+    uint8_t _addr = 0;
+    uint8_t _failCount = 0;
+    uint8_t _failError = I2C_ERROR_TIMEOUT;
+    uint8_t _sdaHeldFor = 0;
+    bool _sclHigh = true;
+    int _sda = -1;
+    int _scl = -1;
+    uint32_t _clock = 100000;
+    uint16_t _timeoutMs = 50;
+    bool _running = false;
+    bool _started = false;
+};
+
+inline TwoWire Wire;
@@ -0,0 +1,65 @@
+#pragma once
+
+// The ROM tinfl API on top of zlib's raw inflate. Same status codes and
+// calling convention, including the wrapping 32 KB output window.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum {
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4
+};
+
+typedef enum {
+    TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS = -4,
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+// Allocated with malloc() and set up by tinfl_init(), as on the device
+typedef struct {
+    uint32_t m_state; // 0: zlib stream not started yet
+    z_stream zs;
+} tinfl_decompressor;
+
+#define tinfl_init(r) do { (r)->m_state = 0; } while (0)
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor* r, const uint8_t* in, size_t* inBytes,
+                                     uint8_t* outStart, uint8_t* outNext, size_t* outBytes,
+                                     const uint32_t flags) {
+    (void)outStart;
+    if (r->m_state == 0) {
+        r->zs = z_stream();
+        if (inflateInit2(&r->zs, -MAX_WBITS) != Z_OK) return TINFL_STATUS_FAILED;
+        r->m_state = 1;
+    }
+    r->zs.next_in = const_cast<Bytef*>(in);
+    r->zs.avail_in = (uInt)*inBytes;
+    r->zs.next_out = outNext;
+    r->zs.avail_out = (uInt)*outBytes;
+    int rc = inflate(&r->zs, Z_NO_FLUSH);
+    *inBytes -= r->zs.avail_in;
+    *outBytes -= r->zs.avail_out;
+
+    tinfl_status status;
+    if (rc == Z_STREAM_END) status = TINFL_STATUS_DONE;
+    else if (rc != Z_OK && rc != Z_BUF_ERROR) status = TINFL_STATUS_FAILED;
+    else if (r->zs.avail_out == 0) status = TINFL_STATUS_HAS_MORE_OUTPUT;
+    else if (flags & TINFL_FLAG_HAS_MORE_INPUT) status = TINFL_STATUS_NEEDS_MORE_INPUT;
+    else status = TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+
+    if (status <= TINFL_STATUS_DONE) { // Finished either way: release zlib's state
+        inflateEnd(&r->zs);
+        r->m_state = 0;
+    }
+    return status;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <malloc.h>
+
+// Host heap: one pool, no PSRAM, so every Arena falls back to the
+// internal heap as on a board without PSRAM
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline size_t heap_caps_get_total_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : 320 * 1024; }
+inline size_t heap_caps_get_free_size(uint32_t caps) { return heap_caps_get_total_size(caps); }
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? nullptr : malloc(size);
+}
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? nullptr : calloc(n, size);
+}
+inline void* heap_caps_malloc_prefer(size_t size, size_t, ...) { return malloc(size); }
+inline void* heap_caps_realloc_prefer(void* ptr, size_t size, size_t, ...) { return realloc(ptr, size); }
+inline size_t heap_caps_get_allocated_size(void* ptr) { return malloc_usable_size(ptr); }
+inline void heap_caps_free(void* ptr) { free(ptr); }
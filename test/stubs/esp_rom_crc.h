@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+#include <zlib.h>
+
+// Same polynomial and conditioning as the ROM routine
+inline uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len) {
+    return (uint32_t)crc32(crc, buf, len);
+}
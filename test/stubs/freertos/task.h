@@ -0,0 +1,15 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// No scheduler on the host: tasks are never started, so the log ring is
+// only drained by Log::flush()
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+inline BaseType_t xTaskCreate(TaskFunction_t, const char*, uint32_t, void*, int, TaskHandle_t* handle) {
+    if (handle) *handle = nullptr;
+    return pdPASS;
+}
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
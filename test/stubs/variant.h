@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Arduino.h>
+
+// --- Host "board" for the native test environment ---
+#define LED_PIN -1
+#define I2C_SDA 21
+#define I2C_SCL 22
+#define SENSOR_PWR_PIN -1
+
+// --- Feature Selection ---
+// Every sensor driver is built against the fakes in test/stubs; a test fits
+// the parts it needs and sets their readings (see FakeSensor.h)
+
+// No OLED driver: Display falls through to the headless framebuffer
+#define DLS_DISPLAY_SSD1306 0
+#define DLS_DISPLAY_SH1106 0
+#define DLS_DISPLAY_HEADLESS 1
+
+// Subsystems with no host side
+#define DLS_FEATURE_TRACE 0
+#define DLS_FEATURE_ENERGY 0
@@ -0,0 +1,261 @@
+// Host-side counterpart of the on-device microbenchmarks (src/Bench): every
+// case of runBenchmarks() plus the host-only ones, timed on the build
+// machine and checked for heap allocations. Host timings are not comparable
+// with a board, and not between machines either, so each case is expressed
+// relative to a fixed calibration loop and only a large slowdown fails.
+
+#include <unity.h>
+#include <chrono>
+#include <new>
+#include "Metrics/DerivedMetrics.h"
+#include "Metrics/EventTrigger.h"
+#include "Archive/GorillaCodec.h"
+#include "Config/SerialCommands.h"
+#include "Config/Config.h"
+#include "Display/Display.h"
+#include "Sensor/Sensor.h"
+#include "Web/WeatherJson.h"
+
+#define HOST_BENCH_ITERATIONS 20000
+#define HOST_BENCH_SLOWDOWN_PCT 200 // Allowed over the baseline ratio
+#define HOST_BENCH_RUNS 3             // Best of, so a busy build machine doesn't fail a case
+
+// Every operator new in the image lands here
+static uint32_t s_allocs = 0;
+
+void* operator new(size_t size) {
+    s_allocs++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+struct HostBaseline {
+    const char* name;
+    uint32_t ratioPct;      // Time per iteration, % of the calibration loop
+    uint32_t allocsPerIter;
+};
+
+// Recorded with gcc 12 on x86-64 (the env builds with -O2); regenerate
+// from the "baseline" lines. The JSON cases count String growth only: the
+// JsonDocument pools come from malloc, which this counter doesn't see.
+static const HostBaseline HOST_BASELINE[] = {
+    { "api_json",         24000, 5 },
+    { "page_net",         37000, 0 },
+    { "page_air",         48000, 0 },
+    { "page_rain",        21500, 0 },
+    { "page_wind",        21000, 0 },
+    { "page_light",       23000, 0 },
+    { "sensor_convert",      20, 0 },
+    { "metrics_float",      170, 0 },
+    { "metrics_fixed",      440, 0 },
+    { "config_to_json",   16000, 5 },
+    { "config_from_json",  9000, 1 },
+    { "gorilla_encode",     260, 0 },
+    { "serial_dispatch",    410, 0 },
+    { "event_update",       145, 0 },
+};
+
+static volatile uint32_t s_sink;
+
+static void calibration() {
+    uint32_t x = 2463534242u;
+    for (uint8_t i = 0; i < 16; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    s_sink = x;
+}
+
+template <typename Fn> static double nsPerIter(Fn fn, uint32_t iterations, uint32_t &allocs) {
+    fn(); // Warm-up
+    uint32_t allocStart = s_allocs;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    allocs = (s_allocs - allocStart + iterations - 1) / iterations;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+template <typename Fn> static void check(const char* name, Fn fn, uint32_t iterations = HOST_BENCH_ITERATIONS) {
+    uint32_t allocs = 0, unused;
+    double ns = 0;
+    uint32_t ratio = UINT32_MAX;
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        double runNs = nsPerIter(fn, iterations, allocs);
+        double calNs = nsPerIter(calibration, HOST_BENCH_ITERATIONS, unused);
+        uint32_t runRatio = (uint32_t)(runNs * 100 / calNs + 0.5);
+        if (runRatio < ratio) {
+            ratio = runRatio;
+            ns = runNs;
+        }
+    }
+    printf("baseline { \"%s\", %u, %u }  (%.0f ns/iter)\n", name, (unsigned)ratio, (unsigned)allocs, ns);
+
+    const HostBaseline* b = nullptr;
+    for (const HostBaseline &h : HOST_BASELINE) {
+        if (strcmp(h.name, name) == 0) b = &h;
+    }
+    TEST_ASSERT_NOT_NULL(b);
+    // Same rule as Bench::run(): fewer allocations than recorded is fine
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(b->allocsPerIter, allocs, "heap allocations per iteration");
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(b->ratioPct + b->ratioPct * HOST_BENCH_SLOWDOWN_PCT / 100, ratio,
+                                             "slower than the baseline");
+}
+
+static AirData sample() {
+    AirData air;
+    air.temperature = 21.37;
+    air.humidity = 48.2;
+    air.pressure = 1012.6;
+    air.gasResistance = 152.3;
+    air.iaq = 57.0;
+    air.iaqAccuracy = 3;
+    air.valid = true;
+    return air;
+}
+
+// The display as runBenchmarks() leaves it
+static Display &benchDisplay() {
+    static Display display;
+    static bool ready = false;
+    if (!ready) {
+        AirData air = sample();
+        DerivedData derived;
+        DerivedMetrics::computeFloat(air, 120.0, derived);
+        display.begin();
+        display.setAirData(air.temperature, air.humidity, air.pressure, air.iaq, air.iaqAccuracy, derived.dewPoint);
+        display.setLightData(3.4, -1.0);
+        display.setWindData(-1.0, -1.0);
+        display.setRainData(-1.0, -1.0);
+        display.setNetworkInfo("192.168.1.42", "BenchNet", "Online", true);
+        ready = true;
+    }
+    return display;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_api_json() {
+    static AirData air = sample();
+    static LightData light;
+    static DerivedData derived;
+    static WindRainData windRain;
+    light.uvIndex = 3.4;
+    light.valid = true;
+    DerivedMetrics::computeFloat(air, 120.0, derived);
+    check("api_json", []() {
+        String response;
+        WeatherJson::build(air, light, derived, windRain, response);
+    });
+
+    String response;
+    WeatherJson::build(air, light, derived, windRain, response);
+    TEST_ASSERT_NOT_NULL(strstr(response.c_str(), "\"status\":true"));
+    TEST_ASSERT_NOT_NULL(strstr(response.c_str(), "\"iaq_accuracy\":3"));
+    TEST_ASSERT_NOT_NULL(strstr(response.c_str(), "\"wind_speed\":null"));
+}
+
+static void test_pages() {
+    static const char* names[PAGE_COUNT] = {"page_net", "page_air", "page_rain", "page_wind", "page_light"};
+    Display &display = benchDisplay();
+    for (int p = 0; p < PAGE_COUNT; p++) {
+        DisplayPage page = (DisplayPage)p;
+        check(names[p], [&]() { display.renderPage(page); }, 1000);
+    }
+}
+
+static void test_sensor_convert() {
+    check("sensor_convert", []() {
+        AirData data;
+        Sensor::convertAir(21.37, 48.2, 101260.0, 152300.0, data);
+    });
+}
+
+static void test_metrics_float() {
+    AirData air = sample();
+    check("metrics_float", [&]() {
+        DerivedData out;
+        DerivedMetrics::computeFloat(air, 120.0, out);
+    });
+}
+
+static void test_metrics_fixed() {
+    AirData air = sample();
+    check("metrics_fixed", [&]() {
+        DerivedData out;
+        DerivedMetrics::computeFixed(air, 120.0, out);
+    });
+}
+
+static void test_config_to_json() {
+    static Config config;
+    check("config_to_json", []() {
+        String out;
+        config.toJson(out);
+    });
+}
+
+static void test_config_from_json() {
+    static Config scratch;
+    check("config_from_json", []() {
+        scratch.fromJson("{\"ssid\":\"BenchNet\",\"pass\":\"secret\",\"api\":\"KEY\",\"station\":\"ST-BENCH\","
+                         "\"lat\":41.01,\"lon\":28.97,\"interval\":10,\"deepSleep\":false}");
+    });
+    TEST_ASSERT_TRUE(scratch.getSSID() == "BenchNet");
+    TEST_ASSERT_TRUE(scratch.getStationID() == "ST-BENCH");
+}
+
+static void test_gorilla_encode() {
+    GorillaState state;
+    state.reset(1718000000);
+    uint32_t ts = 1718000000;
+    int32_t values[6] = {2137, 4820, 101260, 57, 340, GORILLA_MISSING};
+    uint8_t out[GORILLA_MAX_RECORD_BYTES];
+    check("gorilla_encode", [&]() {
+        ts += 300;
+        values[0] += (ts & 4) ? 3 : -3;
+        Gorilla::encode(state, ts, values, 6, out, sizeof(out));
+    });
+}
+
+static void test_serial_dispatch() {
+    static SerialCommands commands;
+    static uint32_t hits = 0;
+    commands.add("info", [](const char*) { hits++; });
+    commands.add("ssid=", [](const char*) { hits++; });
+    check("serial_dispatch", []() {
+        for (const char* p = "ssid=BenchNet\r\n"; *p; p++) commands.feed(*p);
+    });
+    TEST_ASSERT_GREATER_THAN_UINT32(HOST_BENCH_ITERATIONS, hits);
+}
+
+static void test_event_update() {
+    static EventTrigger trigger;
+    AirData air = sample();
+    uint32_t now = 0;
+    check("event_update", [&]() {
+        now += 1000;
+        air.temperature = 21.37f + (now / 1000 % 7) * 0.1f;
+        trigger.update(now, air, -1.0);
+    });
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_api_json);
+    RUN_TEST(test_pages);
+    RUN_TEST(test_sensor_convert);
+    RUN_TEST(test_metrics_float);
+    RUN_TEST(test_metrics_fixed);
+    RUN_TEST(test_config_to_json);
+    RUN_TEST(test_config_from_json);
+    RUN_TEST(test_gorilla_encode);
+    RUN_TEST(test_serial_dispatch);
+    RUN_TEST(test_event_update);
+    return UNITY_END();
+}
@@ -0,0 +1,111 @@
+// Derived metrics: the float path against published reference values, and
+// the integer path (used on the ESP32-C3) against the float path.
+
+#include <unity.h>
+#include "Metrics/DerivedMetrics.h"
+
+// Same limits as DerivedMetrics::checkAccuracy()
+#define TOL_DEW 0.2F
+#define TOL_HI 0.3F
+#define TOL_SLP 0.5F
+#define TOL_AH 0.1F
+
+class NullPrint : public Print {
+public:
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+};
+
+static AirData air(float t, float rh, float hPa) {
+    AirData a;
+    a.temperature = t;
+    a.humidity = rh;
+    a.pressure = hPa;
+    a.valid = true;
+    return a;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_float_reference_values() {
+    DerivedData out;
+    DerivedMetrics::computeFloat(air(20.0, 50.0, 1013.25), 0, out);
+    TEST_ASSERT_TRUE(out.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 9.26, out.dewPoint);      // Magnus
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 8.65, out.absHumidity);   // g/m3
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1013.25, out.seaLevelPressure);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 19.7, out.heatIndex);     // Below 80 F: simple formula
+
+    DerivedMetrics::computeFloat(air(30.0, 70.0, 900.0), 1000, out);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 35.0, out.heatIndex);     // NOAA table: 86 F, 70 % -> 95 F
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 1006.2, out.seaLevelPressure); // 900 * (1 - 6.5 / 309.65)^-5.257
+}
+
+static void test_fixed_matches_float() {
+    float errDew = 0, errHi = 0, errSlp = 0, errAh = 0;
+    for (float t = -39.5F; t <= 59.5F; t += 1.3F) {
+        for (float rh = 1.0F; rh <= 100.0F; rh += 3.7F) {
+            for (int alt = -100; alt <= 3000; alt += 350) {
+                float hPa = 1013.25F * powf(1.0F - 2.25577e-5F * alt, 5.25588F);
+                DerivedData f, x;
+                DerivedMetrics::computeFloat(air(t, rh, hPa), alt, f);
+                DerivedMetrics::computeFixed(air(t, rh, hPa), alt, x);
+                TEST_ASSERT_EQUAL(f.valid, x.valid);
+                // Near the -40 C table edge one path may have no dew point
+                if (f.dewPoint != -999.0F && x.dewPoint != -999.0F) {
+                    errDew = max(errDew, fabsf(f.dewPoint - x.dewPoint));
+                }
+                errHi = max(errHi, fabsf(f.heatIndex - x.heatIndex));
+                errSlp = max(errSlp, fabsf(f.seaLevelPressure - x.seaLevelPressure));
+                errAh = max(errAh, fabsf(f.absHumidity - x.absHumidity));
+            }
+        }
+    }
+    printf("max error: dew %.3f C, heat %.3f C, slp %.3f hPa, abs %.3f g/m3\n", errDew, errHi, errSlp, errAh);
+    TEST_ASSERT_TRUE(errDew <= TOL_DEW);
+    TEST_ASSERT_TRUE(errHi <= TOL_HI);
+    TEST_ASSERT_TRUE(errSlp <= TOL_SLP);
+    TEST_ASSERT_TRUE(errAh <= TOL_AH);
+}
+
+static void test_on_device_check_passes() {
+    NullPrint out;
+    TEST_ASSERT_TRUE(DerivedMetrics::checkAccuracy(out));
+}
+
+static void test_missing_inputs() {
+    DerivedData f, x;
+
+    // No humidity: only the sea level pressure
+    AirData a = air(15.0, -999.0, 1000.0);
+    DerivedMetrics::computeFloat(a, 200, f);
+    DerivedMetrics::computeFixed(a, 200, x);
+    TEST_ASSERT_TRUE(f.valid && x.valid);
+    TEST_ASSERT_EQUAL_FLOAT(-999.0, f.dewPoint);
+    TEST_ASSERT_EQUAL_FLOAT(-999.0, x.dewPoint);
+    TEST_ASSERT_EQUAL_FLOAT(-999.0, x.heatIndex);
+    TEST_ASSERT_FLOAT_WITHIN(TOL_SLP, f.seaLevelPressure, x.seaLevelPressure);
+
+    // Temperature out of the supported range, or the sample invalid
+    a = air(75.0, 50.0, 1000.0);
+    DerivedMetrics::computeFloat(a, 0, f);
+    DerivedMetrics::computeFixed(a, 0, x);
+    TEST_ASSERT_FALSE(f.valid);
+    TEST_ASSERT_FALSE(x.valid);
+
+    a = air(20.0, 50.0, 1000.0);
+    a.valid = false;
+    DerivedMetrics::computeFixed(a, 0, x);
+    TEST_ASSERT_FALSE(x.valid);
+    TEST_ASSERT_EQUAL_FLOAT(-999.0, x.seaLevelPressure);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_float_reference_values);
+    RUN_TEST(test_fixed_matches_float);
+    RUN_TEST(test_on_device_check_passes);
+    RUN_TEST(test_missing_inputs);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+// Display pages rendered into the headless framebuffer: the page layout of
+// the backend, the fixed layout (header rule, footer, Wi-Fi icon), the
+// static layer cache and golden hashes of every page. The hashes depend on
+// the stand-in glyphs of test/stubs/Adafruit_GFX.h, not the OLED font.
+
+#include <unity.h>
+#include "Display/Display.h"
+
+static bool pixel(const uint8_t* fb, int x, int y) {
+    return fb[x + (y / 8) * SCREEN_WIDTH] & (1 << (y & 7));
+}
+
+// FNV-1a over the whole framebuffer
+static uint32_t hashFrame(const uint8_t* fb) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < SCREEN_BUFFER_SIZE; i++) h = (h ^ fb[i]) * 16777619u;
+    return h;
+}
+
+// A display with the same readings every run
+static void fill(Display &d) {
+    d.setNetworkInfo("192.168.1.42", "DLS-Lab", "OK", true);
+    for (int i = 0; i < 12; i++) {
+        Host::nowMs = i * SPARK_COL_MS;
+        d.setAirData(20.0 + i * 0.25, 55.0, 1012.0 - i * 0.5, 48.0, 3, 11.2);
+        d.setRainData(i < 6 ? 0.0 : 1.5, 3.2);
+        d.setWindData(2.0 + (i % 4), 225.0);
+        d.setLightData(i * 0.4, 1200.0 * i);
+    }
+}
+
+void setUp() {
+    Host::nowMs = 0;
+}
+
+void tearDown() {}
+
+static void test_headless_is_selected() {
+    Display d;
+    d.begin();
+    TEST_ASSERT_EQUAL(DISP_HEADLESS, d.getType());
+    const uint8_t* fb = d.framebuffer();
+    TEST_ASSERT_NOT_NULL(fb);
+    for (size_t i = 0; i < SCREEN_BUFFER_SIZE; i++) TEST_ASSERT_EQUAL(0, fb[i]);
+}
+
+static void test_backend_page_layout() {
+    HeadlessBackend backend;
+    TEST_ASSERT_TRUE(backend.begin());
+    const uint8_t* fb = backend.buffer();
+
+    backend.gfx().drawPixel(3, 10, DISP_WHITE);
+    TEST_ASSERT_EQUAL_HEX8(1 << 2, fb[3 + 1 * SCREEN_WIDTH]);
+    backend.gfx().drawPixel(127, 63, DISP_WHITE);
+    TEST_ASSERT_EQUAL_HEX8(0x80, fb[SCREEN_BUFFER_SIZE - 1]);
+    backend.gfx().drawPixel(3, 10, DISP_BLACK);
+    TEST_ASSERT_EQUAL_HEX8(0, fb[3 + 1 * SCREEN_WIDTH]);
+
+    // Off-screen pixels are clipped, not wrapped into a neighbouring row
+    backend.gfx().drawPixel(-1, 0, DISP_WHITE);
+    backend.gfx().drawPixel(128, 0, DISP_WHITE);
+    backend.gfx().drawPixel(0, 64, DISP_WHITE);
+    backend.gfx().drawPixel(0, -1, DISP_WHITE);
+    uint32_t set = 0;
+    for (size_t i = 0; i < SCREEN_BUFFER_SIZE; i++) set += __builtin_popcount(fb[i]);
+    TEST_ASSERT_EQUAL(1, set);
+
+    backend.flush();
+    TEST_ASSERT_EQUAL(1, backend.frames());
+}
+
+static void test_header_and_footer() {
+    Display d;
+    d.begin();
+    d.renderPage(PAGE_AIR);
+    const uint8_t* fb = d.framebuffer();
+
+    // "WEATHER" is 42 px wide at x 43; the rule stops 3 px short of it on both sides
+    TEST_ASSERT_TRUE(pixel(fb, 0, 3));
+    TEST_ASSERT_TRUE(pixel(fb, 40, 3));
+    TEST_ASSERT_FALSE(pixel(fb, 41, 3));
+    TEST_ASSERT_FALSE(pixel(fb, 87, 3));
+    TEST_ASSERT_TRUE(pixel(fb, 88, 3));
+    TEST_ASSERT_TRUE(pixel(fb, 127, 3));
+
+    for (int x = 0; x < SCREEN_WIDTH; x++) TEST_ASSERT_TRUE(pixel(fb, x, 54));
+    for (int x = 0; x < SCREEN_WIDTH; x++) TEST_ASSERT_FALSE(pixel(fb, x, 53));
+}
+
+static void test_wifi_icon() {
+    Display d;
+    d.begin();
+    d.setNetworkInfo("", "", "", false);
+    d.renderPage(PAGE_NET);
+    const uint8_t* fb = d.framebuffer();
+    TEST_ASSERT_FALSE(pixel(fb, 122, 61)); // Ring only
+    TEST_ASSERT_TRUE(pixel(fb, 122, 59));
+    TEST_ASSERT_TRUE(pixel(fb, 120, 61));
+    TEST_ASSERT_TRUE(pixel(fb, 124, 61));
+    TEST_ASSERT_TRUE(pixel(fb, 122, 63));
+
+    d.setNetworkInfo("", "", "", true);
+    d.renderPage(PAGE_NET);
+    TEST_ASSERT_TRUE(pixel(fb, 122, 61)); // Filled
+    TEST_ASSERT_TRUE(pixel(fb, 121, 60));
+    TEST_ASSERT_FALSE(pixel(fb, 125, 61));
+}
+
+static void test_cached_layer_matches_first_render() {
+    Display d;
+    d.begin();
+    fill(d);
+    uint8_t first[SCREEN_BUFFER_SIZE];
+    for (int p = 0; p < PAGE_COUNT; p++) {
+        d.renderPage((DisplayPage)p); // Draws and caches the static layer
+        memcpy(first, d.framebuffer(), sizeof(first));
+        d.renderPage((DisplayPage)p); // Blits it
+        TEST_ASSERT_EQUAL_MEMORY(first, d.framebuffer(), SCREEN_BUFFER_SIZE);
+    }
+}
+
+static void test_value_change_stays_in_its_field() {
+    Display d;
+    d.begin();
+    fill(d);
+    uint8_t before[SCREEN_BUFFER_SIZE];
+    d.renderPage(PAGE_NET);
+    memcpy(before, d.framebuffer(), sizeof(before));
+
+    d.setNetworkInfo("10.0.0.7", "DLS-Lab", "OK", true);
+    d.renderPage(PAGE_NET);
+    const uint8_t* fb = d.framebuffer();
+
+    // The IP row is y 28..35 (pages 3 and 4), after the 6-character label
+    uint32_t changed = 0;
+    for (size_t i = 0; i < SCREEN_BUFFER_SIZE; i++) {
+        if (fb[i] == before[i]) continue;
+        changed++;
+        size_t page = i / SCREEN_WIDTH, x = i % SCREEN_WIDTH;
+        TEST_ASSERT_TRUE(page == 3 || page == 4);
+        TEST_ASSERT_TRUE(x >= 6 * 6);
+    }
+    TEST_ASSERT_TRUE(changed > 0);
+}
+
+static void test_page_hashes() {
+    static const uint32_t golden[PAGE_COUNT] = {
+        0xDF313811, // NET
+        0xBFFA94C0, // AIR
+        0x6DB1A06F, // RAIN
+        0xB6911C50, // WIND
+        0x2278BEB8, // LIGHT
+    };
+    Display d;
+    d.begin();
+    fill(d);
+    for (int p = 0; p < PAGE_COUNT; p++) {
+        d.renderPage((DisplayPage)p);
+        TEST_ASSERT_EQUAL_HEX32(golden[p], hashFrame(d.framebuffer()));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_headless_is_selected);
+    RUN_TEST(test_backend_page_layout);
+    RUN_TEST(test_header_and_footer);
+    RUN_TEST(test_wifi_icon);
+    RUN_TEST(test_cached_layer_matches_first_render);
+    RUN_TEST(test_value_change_stays_in_its_field);
+    RUN_TEST(test_page_hashes);
+    return UNITY_END();
+}
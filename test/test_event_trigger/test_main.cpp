@@ -0,0 +1,139 @@
+// EventTrigger: rule windows and the token bucket that pays for extra
+// uploads, driven with synthetic one-minute samples.
+
+#include <unity.h>
+#include "Metrics/EventTrigger.h"
+
+#define MINUTE 60000UL
+#define HOUR (60 * MINUTE)
+
+static AirData air(float t, float rh, float hPa) {
+    AirData a;
+    a.temperature = t;
+    a.humidity = rh;
+    a.pressure = hPa;
+    a.valid = true;
+    return a;
+}
+
+// Feeds a temperature series one sample per minute from startMs; returns
+// the minute index of the first event, or -1
+static int feedTemps(EventTrigger &trigger, uint32_t startMs, const float* temps, int count,
+                     const char* expected = "temp_crash") {
+    for (int i = 0; i < count; i++) {
+        const EventRule* rule = trigger.update(startMs + i * MINUTE, air(temps[i], 50.0, 1013.0), -1.0);
+        if (rule) {
+            TEST_ASSERT_EQUAL_STRING(expected, rule->name);
+            return i;
+        }
+    }
+    return -1;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_rules_without_rain_sensor() {
+    TEST_ASSERT_EQUAL(3, EVENT_RULE_COUNT);
+    TEST_ASSERT_EQUAL(3, EVT_CHANNEL_COUNT);
+}
+
+static void test_fast_drop_fires() {
+    EventTrigger trigger;
+    float temps[20];
+    for (int i = 0; i < 20; i++) temps[i] = i < 10 ? 25.0F : 25.0F - (i - 9) * 0.5F;
+    // 25.0 -> 22.0 after six 0.5 C steps
+    TEST_ASSERT_EQUAL(15, feedTemps(trigger, 0, temps, 20));
+}
+
+static void test_rise_and_slow_drift_do_not_fire() {
+    EventTrigger trigger;
+    float temps[120];
+    for (int i = 0; i < 60; i++) temps[i] = 15.0F + i * 0.2F;   // Warming: wrong direction
+    for (int i = 60; i < 120; i++) temps[i] = 27.0F - (i - 60) * 0.1F; // -1.5 C per 15 min
+    TEST_ASSERT_EQUAL(-1, feedTemps(trigger, 0, temps, 120));
+}
+
+static void test_cooldown_then_rearms() {
+    EventTrigger trigger;
+    float temps[40];
+    for (int i = 0; i < 40; i++) temps[i] = (i % 2) ? 20.0F : 24.0F; // Flapping
+    TEST_ASSERT_EQUAL(1, feedTemps(trigger, 0, temps, 2));
+    // Still flapping during the 30 min cooldown: quiet
+    TEST_ASSERT_EQUAL(-1, feedTemps(trigger, 2 * MINUTE, temps, 29));
+    // After the cooldown the window starts empty and fires again
+    TEST_ASSERT_EQUAL(1, feedTemps(trigger, 31 * MINUTE + 1, temps, 4));
+}
+
+static void test_gap_longer_than_window_clears_it() {
+    EventTrigger trigger;
+    trigger.update(0, air(25.0, 50.0, 1013.0), -1.0);
+    // Sensor outage for an hour; the next reading is not compared with the old one
+    TEST_ASSERT_NULL(trigger.update(HOUR, air(20.0, 50.0, 1013.0), -1.0));
+}
+
+static void test_placeholders_are_ignored() {
+    EventTrigger trigger;
+    trigger.update(0, air(25.0, 50.0, 1013.0), -1.0);
+    TEST_ASSERT_NULL(trigger.update(MINUTE, air(-999.0, -999.0, -999.0), -1.0));
+    TEST_ASSERT_NULL(trigger.update(2 * MINUTE, air(NAN, NAN, NAN), -1.0));
+    AirData invalid = air(0.0, 0.0, 0.0);
+    invalid.valid = false;
+    TEST_ASSERT_NULL(trigger.update(3 * MINUTE, invalid, -1.0));
+    TEST_ASSERT_NULL(trigger.update(4 * MINUTE, air(25.0, 50.0, 1013.0), -1.0));
+}
+
+static void test_other_channels() {
+    EventTrigger trigger;
+    trigger.update(0, air(20.0, 50.0, 1013.0), -1.0);
+    const EventRule* rule = trigger.update(5 * MINUTE, air(20.0, 66.0, 1013.0), -1.0);
+    TEST_ASSERT_NOT_NULL(rule);
+    TEST_ASSERT_EQUAL_STRING("humidity_jump", rule->name);
+
+    EventTrigger pressure;
+    pressure.update(0, air(20.0, 50.0, 1013.0), -1.0);
+    TEST_ASSERT_NULL(pressure.update(10 * MINUTE, air(20.0, 50.0, 1012.2), -1.0));
+    rule = pressure.update(20 * MINUTE, air(20.0, 50.0, 1011.9), -1.0);
+    TEST_ASSERT_NOT_NULL(rule);
+    TEST_ASSERT_EQUAL_STRING("pressure_drop", rule->name);
+}
+
+static void test_token_bucket() {
+    EventTrigger trigger;
+    uint32_t t0 = 5 * HOUR;
+    // Starts full
+    for (int i = 0; i < EVENT_TOKENS_MAX; i++) TEST_ASSERT_TRUE(trigger.takeToken(t0));
+    TEST_ASSERT_FALSE(trigger.takeToken(t0));
+
+    // One token per refill period, counted from when the bucket was full
+    TEST_ASSERT_FALSE(trigger.takeToken(t0 + EVENT_TOKEN_REFILL_S * 1000UL - 1));
+    TEST_ASSERT_TRUE(trigger.takeToken(t0 + EVENT_TOKEN_REFILL_S * 1000UL));
+    TEST_ASSERT_FALSE(trigger.takeToken(t0 + EVENT_TOKEN_REFILL_S * 1000UL));
+
+    // A long quiet spell does not bank more than the bucket holds
+    uint32_t later = t0 + 48 * HOUR;
+    for (int i = 0; i < EVENT_TOKENS_MAX; i++) TEST_ASSERT_TRUE(trigger.takeToken(later));
+    TEST_ASSERT_FALSE(trigger.takeToken(later));
+}
+
+static void test_token_bucket_across_millis_wrap() {
+    EventTrigger trigger;
+    uint32_t t0 = 0xFFFFFFFFUL - 10 * MINUTE;
+    for (int i = 0; i < EVENT_TOKENS_MAX; i++) TEST_ASSERT_TRUE(trigger.takeToken(t0));
+    TEST_ASSERT_FALSE(trigger.takeToken(t0 + 30 * MINUTE)); // Wrapped, half a period
+    TEST_ASSERT_TRUE(trigger.takeToken(t0 + EVENT_TOKEN_REFILL_S * 1000UL));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rules_without_rain_sensor);
+    RUN_TEST(test_fast_drop_fires);
+    RUN_TEST(test_rise_and_slow_drift_do_not_fire);
+    RUN_TEST(test_cooldown_then_rearms);
+    RUN_TEST(test_gap_longer_than_window_clears_it);
+    RUN_TEST(test_placeholders_are_ignored);
+    RUN_TEST(test_other_channels);
+    RUN_TEST(test_token_bucket);
+    RUN_TEST(test_token_bucket_across_millis_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+// Gorilla record codec: records encoded into a page and read back through
+// BitReader must come out bit-exact, whatever the cadence and values do.
+
+#include <unity.h>
+#include "Archive/GorillaCodec.h"
+
+#define VALUES 6
+#define BASE_TS 1718000000UL
+
+struct Record {
+    uint32_t ts;
+    int32_t values[VALUES];
+};
+
+// Encodes records back to back into a page file; returns bytes written
+static size_t writePage(File &page, const Record* records, size_t count) {
+    GorillaState state;
+    state.reset(BASE_TS);
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t buf[GORILLA_MAX_RECORD_BYTES];
+        size_t len = Gorilla::encode(state, records[i].ts, records[i].values, VALUES, buf, sizeof(buf));
+        TEST_ASSERT_TRUE(len > 0);
+        page.write(buf, len);
+        total += len;
+    }
+    return total;
+}
+
+static size_t readPage(File &page, Record* out, size_t max) {
+    GorillaState state;
+    state.reset(BASE_TS);
+    BitReader reader(page);
+    size_t n = 0;
+    while (n < max && Gorilla::decode(reader, state, out[n].ts, out[n].values, VALUES)) n++;
+    return n;
+}
+
+static void assertSame(const Record* expected, const Record* actual, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].ts, actual[i].ts);
+        TEST_ASSERT_EQUAL_INT32_ARRAY(expected[i].values, actual[i].values, VALUES);
+    }
+}
+
+static uint32_t s_rng;
+
+static uint32_t rnd() {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+void setUp() {
+    s_rng = 2463534242u;
+}
+
+void tearDown() {}
+
+static void test_steady_series_is_one_byte_per_record() {
+    static Record in[100];
+    for (size_t i = 0; i < 100; i++) {
+        in[i] = {(uint32_t)(BASE_TS + 300 * (i + 1)), {2137, 4820, 101260, 57, 340, GORILLA_MISSING}};
+    }
+    File page;
+    size_t bytes = writePage(page, in, 100);
+    // The first record carries the cadence and the values; after that one
+    // '0' bit per field fits in a byte
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(99 + GORILLA_MAX_RECORD_BYTES, bytes);
+
+    static Record out[100];
+    TEST_ASSERT_EQUAL(100, readPage(page, out, 100));
+    assertSame(in, out, 100);
+}
+
+static void test_random_walk_round_trip() {
+    static Record in[2000];
+    uint32_t ts = BASE_TS;
+    int32_t v[VALUES] = {2137, 4820, 101260, 57, 340, -1500};
+    for (size_t i = 0; i < 2000; i++) {
+        uint32_t r = rnd();
+        // Mostly a 300 s cadence with jitter, sometimes a long gap or a clock step back
+        if (r % 50 == 0) ts += 86400 * (1 + r % 7);
+        else if (r % 97 == 0) ts -= 3600;
+        else ts += 300 + (int32_t)(r % 5) - 2;
+
+        for (uint8_t c = 0; c < VALUES; c++) {
+            uint32_t k = rnd();
+            switch (k % 8) {
+            case 0: break;                                      // Unchanged
+            case 1: v[c] = GORILLA_MISSING; break;              // Sensor dropped out
+            case 2: v[c] = (int32_t)rnd(); break;               // Arbitrary jump
+            case 3: v[c] = (k & 8) ? INT32_MAX : INT32_MIN + 1; break;
+            default:
+                if (v[c] == GORILLA_MISSING) v[c] = 2000;
+                else v[c] += (int32_t)(k >> 8) % 5000 - 2500; // Small steps of every width
+            }
+        }
+        in[i].ts = ts;
+        memcpy(in[i].values, v, sizeof(v));
+    }
+
+    File page;
+    writePage(page, in, 2000);
+    static Record out[2000];
+    TEST_ASSERT_EQUAL(2000, readPage(page, out, 2000));
+    assertSame(in, out, 2000);
+}
+
+static void test_torn_record_ends_the_page() {
+    Record in[3] = {
+        {BASE_TS + 300, {100, 200, 300, 400, 500, 600}},
+        {BASE_TS + 600, {101, 199, 300, 400, 500, 600}},
+        {BASE_TS + 900, {INT32_MAX, INT32_MIN + 1, 0, -1, 70000, 600}},
+    };
+    File whole;
+    writePage(whole, in, 3);
+
+    // Cut the last record short, as a power loss mid-append would
+    uint8_t bytes[3 * GORILLA_MAX_RECORD_BYTES];
+    int len = whole.read(bytes, sizeof(bytes));
+    File torn;
+    torn.write(bytes, len - 1);
+
+    Record out[3];
+    TEST_ASSERT_EQUAL(2, readPage(torn, out, 3));
+    assertSame(in, out, 2);
+}
+
+static void test_record_that_does_not_fit() {
+    GorillaState state;
+    state.reset(BASE_TS);
+    int32_t values[VALUES] = {INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX};
+    uint8_t buf[8];
+    TEST_ASSERT_EQUAL(0, Gorilla::encode(state, BASE_TS + 300, values, VALUES, buf, sizeof(buf)));
+
+    uint8_t big[GORILLA_MAX_RECORD_BYTES];
+    GorillaState fresh;
+    fresh.reset(BASE_TS);
+    TEST_ASSERT_TRUE(Gorilla::encode(fresh, BASE_TS + 300, values, VALUES, big, sizeof(big)) > 0);
+}
+
+static void test_worst_case_record_size() {
+    GorillaState state;
+    state.reset(BASE_TS);
+    int32_t values[GORILLA_MAX_VALUES];
+    for (int32_t &v : values) v = INT32_MIN + 1;
+    uint8_t buf[GORILLA_MAX_RECORD_BYTES];
+    size_t len = Gorilla::encode(state, 0, values, GORILLA_MAX_VALUES, buf, sizeof(buf));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(GORILLA_MAX_RECORD_BYTES, len);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_series_is_one_byte_per_record);
+    RUN_TEST(test_random_walk_round_trip);
+    RUN_TEST(test_torn_record_ends_the_page);
+    RUN_TEST(test_record_that_does_not_fit);
+    RUN_TEST(test_worst_case_record_size);
+    return UNITY_END();
+}
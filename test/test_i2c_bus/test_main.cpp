@@ -0,0 +1,170 @@
+// I2CBus fault handling against the fault-injecting TwoWire in test/stubs:
+// timed-out and NACKed transfers, a slave holding SDA low, and the degrade
+// and re-probe backoff of a dead device.
+
+#include <unity.h>
+#include <string>
+#include "Bus/I2CBus.h"
+
+#define SDA_PIN 21
+#define SCL_PIN 22
+#define BME280_ADDR 0x76
+
+static TwoWire* s_wire;
+
+// What a driver does around one read: skip a degraded device, otherwise
+// talk to it and report the result
+static bool readDevice(I2CDevice dev, uint8_t addr) {
+    if (!I2CBus::ready(dev)) return false;
+    DLS_I2C_SCOPE(dev);
+    bool ok = I2CBus::ping(addr);
+    I2CBus::report(dev, ok);
+    return ok;
+}
+
+void setUp() {
+    Host::nowMs = 1000;
+    s_wire = new TwoWire();
+    s_wire->attach(BME280_ADDR);
+    I2CBus::begin(*s_wire, SDA_PIN, SCL_PIN);
+    for (uint8_t i = 0; i < I2C_DEV_COUNT; i++) I2CBus::report((I2CDevice)i, true);
+}
+
+void tearDown() {
+    Host::pinRead = nullptr;
+    Host::pinWrite = nullptr;
+    delete s_wire;
+}
+
+static void test_begin_applies_timeout_and_default_clock() {
+    TEST_ASSERT_EQUAL_UINT16(DLS_I2C_TIMEOUT_MS, s_wire->timeoutMs());
+    TEST_ASSERT_EQUAL_UINT32(DLS_I2C_DEFAULT_HZ, s_wire->clock());
+}
+
+static void test_clock_profiles() {
+    TEST_ASSERT_EQUAL_UINT32(400000UL, I2CBus::clockFor(I2C_DEV_OLED)); // Capped by DLS_I2C_MAX_HZ
+    TEST_ASSERT_EQUAL_UINT32(400000UL, I2CBus::clockFor(I2C_DEV_BME280));
+    {
+        DLS_I2C_SCOPE(I2C_DEV_BME280);
+        TEST_ASSERT_EQUAL_UINT32(400000UL, s_wire->clock());
+        DLS_I2C_SCOPE(I2C_DEV_DEFAULT); // Nested: keeps the outer device's clock
+        TEST_ASSERT_EQUAL_UINT32(400000UL, s_wire->clock());
+    }
+    DLS_I2C_SCOPE(I2C_DEV_DEFAULT);
+    TEST_ASSERT_EQUAL_UINT32(DLS_I2C_DEFAULT_HZ, s_wire->clock());
+}
+
+static void test_ping() {
+    TEST_ASSERT_TRUE(I2CBus::ping(BME280_ADDR));
+    TEST_ASSERT_FALSE(I2CBus::ping(0x77));
+    s_wire->failNext(1);
+    uint32_t before = Host::nowMs;
+    TEST_ASSERT_FALSE(I2CBus::ping(BME280_ADDR));
+    TEST_ASSERT_EQUAL_UINT32(before + DLS_I2C_TIMEOUT_MS, Host::nowMs); // One timeout, not a hang
+    TEST_ASSERT_TRUE(I2CBus::ping(BME280_ADDR));
+}
+
+static void test_transient_failure_does_not_degrade() {
+    s_wire->failNext(DLS_I2C_DEGRADE_FAILS - 1);
+    for (uint8_t i = 0; i < DLS_I2C_DEGRADE_FAILS - 1; i++) TEST_ASSERT_FALSE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+    TEST_ASSERT_FALSE(I2CBus::degraded(I2C_DEV_BME280));
+    TEST_ASSERT_TRUE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+
+    // The count restarts after a success
+    s_wire->failNext(DLS_I2C_DEGRADE_FAILS - 1);
+    for (uint8_t i = 0; i < DLS_I2C_DEGRADE_FAILS - 1; i++) readDevice(I2C_DEV_BME280, BME280_ADDR);
+    TEST_ASSERT_FALSE(I2CBus::degraded(I2C_DEV_BME280));
+}
+
+static void test_dead_device_degrades_and_backs_off() {
+    s_wire->detach(BME280_ADDR);
+    for (uint8_t i = 0; i < DLS_I2C_DEGRADE_FAILS; i++) readDevice(I2C_DEV_BME280, BME280_ADDR);
+    TEST_ASSERT_TRUE(I2CBus::degraded(I2C_DEV_BME280));
+
+    // Skipped without touching the bus until the re-probe is due
+    uint32_t transfers = s_wire->transfers;
+    Host::nowMs += DLS_I2C_BACKOFF_BASE_MS - 1;
+    TEST_ASSERT_FALSE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+    TEST_ASSERT_EQUAL_UINT32(transfers, s_wire->transfers);
+
+    // Failed re-probes double the wait, up to the cap
+    unsigned long wait = DLS_I2C_BACKOFF_BASE_MS;
+    for (uint8_t round = 0; round < 12; round++) {
+        Host::nowMs += wait;
+        TEST_ASSERT_TRUE(I2CBus::ready(I2C_DEV_BME280));
+        TEST_ASSERT_FALSE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+        wait = wait * 2 > DLS_I2C_BACKOFF_MAX_MS ? DLS_I2C_BACKOFF_MAX_MS : wait * 2;
+        Host::nowMs += wait - 1;
+        TEST_ASSERT_FALSE(I2CBus::ready(I2C_DEV_BME280));
+        Host::nowMs -= wait - 1;
+    }
+
+    // Plugged back in: the next re-probe brings it back
+    s_wire->attach(BME280_ADDR);
+    Host::nowMs += wait;
+    TEST_ASSERT_TRUE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+    TEST_ASSERT_FALSE(I2CBus::degraded(I2C_DEV_BME280));
+    TEST_ASSERT_TRUE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+}
+
+static void test_devices_degrade_independently() {
+    s_wire->detach(BME280_ADDR);
+    for (uint8_t i = 0; i < DLS_I2C_DEGRADE_FAILS; i++) readDevice(I2C_DEV_BME280, BME280_ADDR);
+    s_wire->attach(0x3C);
+    TEST_ASSERT_TRUE(readDevice(I2C_DEV_OLED, 0x3C));
+    TEST_ASSERT_TRUE(I2CBus::degraded(I2C_DEV_BME280));
+    TEST_ASSERT_FALSE(I2CBus::degraded(I2C_DEV_OLED));
+}
+
+static void test_stuck_sda_is_clocked_free() {
+    s_wire->holdSda(3);
+    TEST_ASSERT_FALSE(readDevice(I2C_DEV_BME280, BME280_ADDR)); // Times out, then recovers
+    TEST_ASSERT_EQUAL_UINT32(3, s_wire->sclPulses);
+    TEST_ASSERT_EQUAL_UINT32(1, s_wire->restarts);               // Wire restarted after the pulses
+    TEST_ASSERT_EQUAL_UINT16(DLS_I2C_TIMEOUT_MS, s_wire->timeoutMs());
+    TEST_ASSERT_TRUE(I2CBus::checkLines());
+    TEST_ASSERT_TRUE(readDevice(I2C_DEV_BME280, BME280_ADDR));
+}
+
+static void test_sda_stuck_for_good() {
+    s_wire->holdSda(255);
+    TEST_ASSERT_FALSE(I2CBus::checkLines());
+    TEST_ASSERT_EQUAL_UINT32(9, s_wire->sclPulses); // Gives up after one byte's worth
+
+    // Every device on the bus degrades instead of stalling the loop forever
+    uint32_t start = Host::nowMs;
+    for (uint8_t i = 0; i < 10; i++) readDevice(I2C_DEV_BME280, BME280_ADDR);
+    TEST_ASSERT_TRUE(I2CBus::degraded(I2C_DEV_BME280));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(DLS_I2C_DEGRADE_FAILS * DLS_I2C_TIMEOUT_MS, Host::nowMs - start);
+}
+
+static void test_status_reports_degraded_devices() {
+    class Capture : public Print {
+    public:
+        size_t write(uint8_t c) override {
+            text += (char)c;
+            return 1;
+        }
+        using Print::write;
+        std::string text;
+    } out;
+    s_wire->detach(BME280_ADDR);
+    for (uint8_t i = 0; i < DLS_I2C_DEGRADE_FAILS; i++) readDevice(I2C_DEV_BME280, BME280_ADDR);
+    I2CBus::printStatus(out);
+    TEST_ASSERT_TRUE(out.text.find("bme280") != std::string::npos);
+    TEST_ASSERT_TRUE(out.text.find("DEGRADED") != std::string::npos);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_applies_timeout_and_default_clock);
+    RUN_TEST(test_clock_profiles);
+    RUN_TEST(test_ping);
+    RUN_TEST(test_transient_failure_does_not_degrade);
+    RUN_TEST(test_dead_device_degrades_and_backs_off);
+    RUN_TEST(test_devices_degrade_independently);
+    RUN_TEST(test_stuck_sda_is_clocked_free);
+    RUN_TEST(test_sda_stuck_for_good);
+    RUN_TEST(test_status_reports_degraded_devices);
+    return UNITY_END();
+}
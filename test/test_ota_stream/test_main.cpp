@@ -0,0 +1,223 @@
+// OTA image framing: gzip images made with zlib (as copy_firmware.py makes
+// them with Python's gzip) are streamed through OtaStream in uneven chunks,
+// intact, cut short and corrupted.
+
+#include <unity.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include "Ota/OtaStream.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+// Serves a buffer in uneven reads; the last read ends the body cleanly
+// (a short file) or with -1 (a dropped connection)
+class MemorySource : public OtaSource {
+public:
+    MemorySource(const Bytes &data, bool dropAtEnd = false) : _data(data), _drop(dropAtEnd) {}
+
+    int read(uint8_t* buf, size_t len) override {
+        if (_pos >= _data.size()) return _drop ? -1 : 0;
+        static const size_t steps[] = {1, 700, 13, OTA_IN_CHUNK, 333};
+        size_t n = steps[_reads++ % 5];
+        if (n > len) n = len;
+        if (n > _data.size() - _pos) n = _data.size() - _pos;
+        memcpy(buf, _data.data() + _pos, n);
+        _pos += n;
+        return (int)n;
+    }
+
+private:
+    const Bytes &_data;
+    bool _drop;
+    size_t _pos = 0;
+    uint32_t _reads = 0;
+};
+
+class MemorySink : public OtaSink {
+public:
+    bool write(const uint8_t* data, size_t len) override {
+        if (written.size() + len > limit) return false;
+        written.insert(written.end(), data, data + len);
+        return true;
+    }
+    const char* error() const override { return "partition full"; }
+
+    Bytes written;
+    size_t limit = SIZE_MAX;
+};
+
+static Bytes s_image;
+
+// A firmware-like image: runs of repeated words with noise, larger than the
+// 32 KB window so the output wraps several times
+static Bytes makeImage(size_t size) {
+    Bytes out(size);
+    uint32_t x = 2463534242u;
+    for (size_t i = 0; i < size; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        out[i] = (x % 4 == 0) ? (uint8_t)x : (uint8_t)(i / 64);
+    }
+    return out;
+}
+
+static Bytes gzip(const Bytes &data, const char* name = nullptr, bool extras = false) {
+    z_stream zs = z_stream();
+    TEST_ASSERT_EQUAL(Z_OK, deflateInit2(&zs, 9, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY));
+    gz_header header = gz_header();
+    char extra[] = "xx\x04\x00test";
+    char comment[] = "dls weather";
+    header.name = (Bytef*)name;
+    if (extras) {
+        header.extra = (Bytef*)extra;
+        header.extra_len = 8;
+        header.comment = (Bytef*)comment;
+        header.hcrc = 1;
+    }
+    if (name || extras) TEST_ASSERT_EQUAL(Z_OK, deflateSetHeader(&zs, &header));
+
+    Bytes out(deflateBound(&zs, data.size()) + 64);
+    zs.next_in = const_cast<Bytef*>(data.data());
+    zs.avail_in = data.size();
+    zs.next_out = out.data();
+    zs.avail_out = out.size();
+    TEST_ASSERT_EQUAL(Z_STREAM_END, deflate(&zs, Z_FINISH));
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+// Runs the same path as the updater: fill, sniff the magic, stream
+static bool stream(const Bytes &body, MemorySink &sink, const char* &error, bool dropAtEnd = false) {
+    MemorySource source(body, dropAtEnd);
+    OtaInput in(source);
+    error = "empty body";
+    if (!in.fill()) return false;
+    return OtaStream::isGzip(in) ? OtaStream::inflateGzip(in, sink, error)
+                                 : OtaStream::copyRaw(in, sink, error);
+}
+
+void setUp() {
+    if (s_image.empty()) s_image = makeImage(100000);
+}
+
+void tearDown() {}
+
+static void test_valid_image() {
+    Bytes gz = gzip(s_image);
+    TEST_ASSERT_TRUE(gz.size() < s_image.size());
+    MemorySink sink;
+    const char* error = nullptr;
+    TEST_ASSERT_TRUE(stream(gz, sink, error));
+    TEST_ASSERT_EQUAL(s_image.size(), sink.written.size());
+    TEST_ASSERT_TRUE(sink.written == s_image);
+}
+
+static void test_header_fields_are_skipped() {
+    MemorySink named;
+    const char* error = nullptr;
+    Bytes gz = gzip(s_image, "firmware.bin");
+    TEST_ASSERT_EQUAL_HEX8(0x08, gz[3]); // FNAME
+    TEST_ASSERT_TRUE(stream(gz, named, error));
+    TEST_ASSERT_TRUE(named.written == s_image);
+
+    MemorySink all;
+    gz = gzip(s_image, "firmware.bin", true);
+    TEST_ASSERT_EQUAL_HEX8(0x1E, gz[3]); // FHCRC, FEXTRA, FNAME, FCOMMENT
+    TEST_ASSERT_TRUE(stream(gz, all, error));
+    TEST_ASSERT_TRUE(all.written == s_image);
+}
+
+static void test_truncated_image() {
+    Bytes gz = gzip(s_image, "firmware.bin");
+    const char* error = nullptr;
+
+    // A short file, and the same cut as a dropped connection
+    Bytes cut(gz.begin(), gz.begin() + gz.size() / 2);
+    MemorySink a, b;
+    TEST_ASSERT_FALSE(stream(cut, a, error));
+    TEST_ASSERT_EQUAL_STRING("truncated", error);
+    TEST_ASSERT_FALSE(stream(cut, b, error, true));
+    TEST_ASSERT_EQUAL_STRING("truncated", error);
+
+    cut.assign(gz.begin(), gz.end() - 3);
+    MemorySink c;
+    TEST_ASSERT_FALSE(stream(cut, c, error));
+    TEST_ASSERT_EQUAL_STRING("gzip trailer", error);
+
+    cut.assign(gz.begin(), gz.begin() + 14); // Inside the file name
+    MemorySink d;
+    TEST_ASSERT_FALSE(stream(cut, d, error));
+    TEST_ASSERT_EQUAL_STRING("gzip header", error);
+    TEST_ASSERT_EQUAL(0, d.written.size());
+}
+
+static void test_corrupted_crc() {
+    Bytes gz = gzip(s_image);
+    MemorySink sink;
+    const char* error = nullptr;
+    gz[gz.size() - 8] ^= 0x01; // CRC32, first byte
+    TEST_ASSERT_FALSE(stream(gz, sink, error));
+    TEST_ASSERT_EQUAL_STRING("gzip crc", error);
+
+    gz = gzip(s_image);
+    gz[gz.size() - 1] ^= 0x01; // ISIZE
+    TEST_ASSERT_FALSE(stream(gz, sink, error));
+    TEST_ASSERT_EQUAL_STRING("gzip crc", error);
+}
+
+static void test_corrupted_body() {
+    Bytes gz = gzip(s_image);
+    gz[gz.size() / 2] ^= 0x40;
+    MemorySink sink;
+    const char* error = nullptr;
+    TEST_ASSERT_FALSE(stream(gz, sink, error)); // Bad deflate data or a CRC mismatch
+    TEST_ASSERT_TRUE(strcmp(error, "inflate") == 0 || strcmp(error, "gzip crc") == 0);
+}
+
+static void test_not_deflate() {
+    Bytes gz = gzip(s_image);
+    gz[2] = 7;
+    MemorySink sink;
+    const char* error = nullptr;
+    TEST_ASSERT_FALSE(stream(gz, sink, error));
+    TEST_ASSERT_EQUAL_STRING("gzip method", error);
+}
+
+static void test_sink_error_is_reported() {
+    MemorySink sink;
+    sink.limit = 40000;
+    const char* error = nullptr;
+    TEST_ASSERT_FALSE(stream(gzip(s_image), sink, error));
+    TEST_ASSERT_EQUAL_STRING("partition full", error);
+}
+
+static void test_raw_image() {
+    MemorySink sink;
+    const char* error = nullptr;
+    TEST_ASSERT_TRUE(stream(s_image, sink, error));
+    TEST_ASSERT_TRUE(sink.written == s_image);
+
+    MemorySink dropped;
+    TEST_ASSERT_FALSE(stream(s_image, dropped, error, true));
+    TEST_ASSERT_EQUAL_STRING("truncated", error);
+
+    MemorySink empty;
+    TEST_ASSERT_FALSE(stream(Bytes(), empty, error));
+    TEST_ASSERT_EQUAL_STRING("empty body", error);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_valid_image);
+    RUN_TEST(test_header_fields_are_skipped);
+    RUN_TEST(test_truncated_image);
+    RUN_TEST(test_corrupted_crc);
+    RUN_TEST(test_corrupted_body);
+    RUN_TEST(test_not_deflate);
+    RUN_TEST(test_sink_error_is_reported);
+    RUN_TEST(test_raw_image);
+    return UNITY_END();
+}
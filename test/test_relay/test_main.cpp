@@ -0,0 +1,282 @@
+// Relay node and gateway over a simulated ESP-NOW link: a fake RelayLink
+// per radio, joined by a tiny "air" that delivers a frame only when the
+// receiver listens on the sender's channel and can lose its ack.
+
+#include <unity.h>
+#include "Relay/Relay.h"
+
+static const uint8_t NODE_MAC[6] = {0x24, 0x0A, 0xC4, 0x11, 0x22, 0x33};
+static const uint8_t GATEWAY_MAC[6] = {0x24, 0x0A, 0xC4, 0xAA, 0xBB, 0xCC};
+static const uint8_t STRAY_MAC[6] = {0x24, 0x0A, 0xC4, 0x99, 0x99, 0x99};
+#define PEERS "24:0A:C4:11:22:33=ST-00001"
+
+class FakeLink : public RelayLink {
+public:
+    FakeLink(const uint8_t mac[6], uint8_t channel) : channel(channel) { memcpy(this->mac, mac, 6); }
+
+    bool begin() override { return true; }
+    bool setChannel(uint8_t ch) override {
+        channel = ch;
+        return true;
+    }
+    bool send(const uint8_t to[6], const uint8_t* data, size_t len) override;
+    void onReceive(ReceiveFn fn, void* ctx) override {
+        _fn = fn;
+        _ctx = ctx;
+    }
+    void deliver(const uint8_t from[6], const uint8_t* data, size_t len) {
+        if (_fn) _fn(_ctx, from, data, len);
+    }
+
+    uint8_t mac[6];
+    uint8_t channel;
+    uint32_t sends = 0;
+
+private:
+    ReceiveFn _fn = nullptr;
+    void* _ctx = nullptr;
+};
+
+// --- Air ---
+static FakeLink* s_receiver = nullptr;
+static uint8_t s_dropAcks = 0; // Frame arrives, its ack is lost
+
+bool FakeLink::send(const uint8_t to[6], const uint8_t* data, size_t len) {
+    sends++;
+    if (!s_receiver || memcmp(to, s_receiver->mac, 6) != 0 || s_receiver->channel != channel) return false;
+    s_receiver->deliver(mac, data, len);
+    if (s_dropAcks) {
+        s_dropAcks--;
+        return false;
+    }
+    return true;
+}
+
+// --- Forwarding ---
+#define MAX_FORWARDED 32
+static RelayFrame s_forwarded[MAX_FORWARDED];
+static unsigned long s_forwardedEpoch[MAX_FORWARDED];
+static uint8_t s_forwardCount = 0;
+static bool s_uplinkFails = false;
+
+static bool forward(const RelayFrame &frame, unsigned long epoch) {
+    if (s_uplinkFails) return false;
+    if (s_forwardCount < MAX_FORWARDED) {
+        s_forwarded[s_forwardCount] = frame;
+        s_forwardedEpoch[s_forwardCount] = epoch;
+        s_forwardCount++;
+    }
+    return true;
+}
+
+static RelayFrame makeFrame(const char* station, float temperature) {
+    AirData air;
+    air.temperature = temperature;
+    air.humidity = 55.2;
+    air.pressure = 1013.25;
+    air.valid = true;
+    LightData light;
+    RelayFrame frame;
+    frame.encode(station, 41.01, 28.97, air, light);
+    return frame;
+}
+
+void setUp() {
+    s_receiver = nullptr;
+    s_dropAcks = 0;
+    s_forwardCount = 0;
+    s_uplinkFails = false;
+    Host::nowMs = 1000;
+}
+
+void tearDown() {}
+
+static void test_frame_round_trip() {
+    AirData air;
+    air.temperature = -12.34;
+    air.humidity = 87.65;
+    air.pressure = 987.65;
+    air.valid = true;
+    LightData light; // No UV sensor
+    RelayFrame frame;
+    frame.encode("ST-00001", 41.01, 28.97, air, light);
+
+    TEST_ASSERT_TRUE(frame.check(sizeof(frame)));
+    TEST_ASSERT_FALSE(frame.check(sizeof(frame) - 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.005, -12.34, frame.temperatureC());
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 87.65, frame.humidityPct());
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 987.65, frame.pressureHpa());
+    TEST_ASSERT_EQUAL_FLOAT(-999.0, frame.iaqIndex());
+    TEST_ASSERT_EQUAL_FLOAT(-1.0, frame.uvIdx());
+}
+
+static void test_node_sweeps_channels_and_remembers() {
+    FakeLink gatewayLink(GATEWAY_MAC, 6);
+    FakeLink nodeLink(NODE_MAC, 1);
+    s_receiver = &gatewayLink;
+    RelayGateway gateway;
+    gateway.begin(gatewayLink, PEERS);
+    RelayNode node;
+    TEST_ASSERT_TRUE(node.begin(nodeLink, "24:0A:C4:AA:BB:CC"));
+
+    RelayFrame frame = makeFrame("ST-00001", 21.5);
+    TEST_ASSERT_TRUE(node.send(frame));
+    TEST_ASSERT_EQUAL_UINT8(6, nodeLink.channel);
+
+    // The channel is cached: the next frame goes out with one send
+    uint32_t before = nodeLink.sends;
+    frame = makeFrame("ST-00001", 21.6);
+    TEST_ASSERT_TRUE(node.send(frame));
+    TEST_ASSERT_EQUAL_UINT32(before + 1, nodeLink.sends);
+
+    // Gateway's AP moved to channel 11
+    gatewayLink.channel = 11;
+    frame = makeFrame("ST-00001", 21.7);
+    TEST_ASSERT_TRUE(node.send(frame));
+    TEST_ASSERT_EQUAL_UINT8(11, nodeLink.channel);
+
+    // Gateway gone: every channel is tried once, then the send fails
+    s_receiver = nullptr;
+    before = nodeLink.sends;
+    frame = makeFrame("ST-00001", 21.8);
+    TEST_ASSERT_FALSE(node.send(frame));
+    TEST_ASSERT_EQUAL_UINT32(before + RELAY_MAX_CHANNEL, nodeLink.sends);
+}
+
+static void test_node_rejects_bad_gateway_mac() {
+    FakeLink nodeLink(NODE_MAC, 1);
+    RelayNode node;
+    TEST_ASSERT_FALSE(node.begin(nodeLink, "24:0A:C4:AA:BB"));
+    TEST_ASSERT_FALSE(node.begin(nodeLink, "24:0A:C4:AA:BB:CC:DD"));
+    RelayFrame frame = makeFrame("ST-00001", 20.0);
+    TEST_ASSERT_FALSE(node.send(frame));
+}
+
+static void test_gateway_drops_duplicates() {
+    FakeLink gatewayLink(GATEWAY_MAC, 1);
+    FakeLink nodeLink(NODE_MAC, 1);
+    s_receiver = &gatewayLink;
+    RelayGateway gateway;
+    gateway.begin(gatewayLink, PEERS);
+    RelayNode node;
+    node.begin(nodeLink, "24:0A:C4:AA:BB:CC");
+
+    // The frame arrives but its ack is lost, so the node counts it as
+    // failed; the radio's own retransmission delivers it a second time
+    s_dropAcks = 1;
+    RelayFrame frame = makeFrame("ST-00001", 22.0);
+    TEST_ASSERT_FALSE(node.send(frame));
+    gatewayLink.deliver(NODE_MAC, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+    RelayFrame next = makeFrame("ST-00001", 22.5);
+    TEST_ASSERT_TRUE(node.send(next));
+    // A late copy of an older frame is a duplicate too
+    gatewayLink.deliver(NODE_MAC, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+
+    gateway.flush();
+    gateway.update(true, 1718000000, forward);
+    TEST_ASSERT_EQUAL_UINT8(2, s_forwardCount);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 22.0, s_forwarded[0].temperatureC());
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 22.5, s_forwarded[1].temperatureC());
+    TEST_ASSERT_EQUAL_STRING("ST-00001", s_forwarded[0].station);
+}
+
+static void test_gateway_rejects_unlisted_senders() {
+    FakeLink gatewayLink(GATEWAY_MAC, 1);
+    RelayGateway gateway;
+    gateway.begin(gatewayLink, " 24:0A:C4:11:22:33=ST-00001,bogus,24:0A:C4:44:55:66=ST-00002");
+
+    RelayFrame frame = makeFrame("ST-00001", 20.0);
+    frame.seq = 1;
+    gatewayLink.deliver(STRAY_MAC, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+
+    // Listed MAC, but claiming another listed node's station
+    RelayFrame spoofed = makeFrame("ST-00002", 20.0);
+    spoofed.seq = 1;
+    gatewayLink.deliver(NODE_MAC, reinterpret_cast<uint8_t*>(&spoofed), sizeof(spoofed));
+
+    gatewayLink.deliver(NODE_MAC, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+
+    gateway.flush();
+    gateway.update(true, 1718000000, forward);
+    TEST_ASSERT_EQUAL_UINT8(1, s_forwardCount);
+    TEST_ASSERT_EQUAL_STRING("ST-00001", s_forwarded[0].station);
+}
+
+static void test_gateway_without_peers_rejects_everything() {
+    FakeLink gatewayLink(GATEWAY_MAC, 1);
+    RelayGateway gateway;
+    gateway.begin(gatewayLink, "");
+    RelayFrame frame = makeFrame("ST-00001", 20.0);
+    gatewayLink.deliver(NODE_MAC, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+    gateway.flush();
+    gateway.update(true, 1718000000, forward);
+    TEST_ASSERT_EQUAL_UINT8(0, s_forwardCount);
+}
+
+static void test_gateway_batches_and_retries() {
+    FakeLink gatewayLink(GATEWAY_MAC, 1);
+    FakeLink nodeLink(NODE_MAC, 1);
+    s_receiver = &gatewayLink;
+    RelayGateway gateway;
+    gateway.begin(gatewayLink, PEERS);
+    RelayNode node;
+    node.begin(nodeLink, "24:0A:C4:AA:BB:CC");
+
+    RelayFrame frame = makeFrame("ST-00001", 23.0);
+    node.send(frame);
+
+    // Not due yet: the batch waits for company
+    gateway.update(true, 1718000000, forward);
+    TEST_ASSERT_EQUAL_UINT8(0, s_forwardCount);
+
+    // Due, but the upload fails: kept and retried after RELAY_RETRY_MS
+    Host::nowMs += RELAY_BATCH_MS;
+    s_uplinkFails = true;
+    gateway.update(true, 1718000030, forward);
+    TEST_ASSERT_EQUAL_UINT8(0, s_forwardCount);
+
+    s_uplinkFails = false;
+    Host::nowMs += RELAY_RETRY_MS / 2;
+    gateway.update(true, 1718000060, forward);
+    TEST_ASSERT_EQUAL_UINT8(0, s_forwardCount);
+
+    Host::nowMs += RELAY_RETRY_MS / 2;
+    gateway.update(true, 1718000090, forward);
+    TEST_ASSERT_EQUAL_UINT8(1, s_forwardCount);
+    // Stamped with the receive time, not the upload time
+    unsigned long waited = (RELAY_BATCH_MS + RELAY_RETRY_MS) / 1000;
+    TEST_ASSERT_EQUAL_UINT32(1718000090 - waited, s_forwardedEpoch[0]);
+}
+
+static void test_gateway_rx_queue_overflow_is_counted() {
+    FakeLink gatewayLink(GATEWAY_MAC, 1);
+    RelayGateway gateway;
+    gateway.begin(gatewayLink, PEERS);
+
+    // More frames than the receive queue holds before loop() drains it
+    for (uint16_t seq = 1; seq <= RELAY_RX_QUEUE + 2; seq++) {
+        RelayFrame frame = makeFrame("ST-00001", 20.0);
+        frame.boot = 0x1234;
+        frame.seq = seq;
+        gatewayLink.deliver(NODE_MAC, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+    }
+    gateway.flush();
+    gateway.update(true, 1718000000, forward);
+    gateway.update(true, 1718000000, forward);
+    gateway.update(true, 1718000000, forward);
+    TEST_ASSERT_EQUAL_UINT8(RELAY_RX_QUEUE - 1, s_forwardCount); // One slot tells full from empty
+    TEST_ASSERT_EQUAL_UINT16(1, s_forwarded[0].seq);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_round_trip);
+    RUN_TEST(test_node_sweeps_channels_and_remembers);
+    RUN_TEST(test_node_rejects_bad_gateway_mac);
+    RUN_TEST(test_gateway_drops_duplicates);
+    RUN_TEST(test_gateway_rejects_unlisted_senders);
+    RUN_TEST(test_gateway_without_peers_rejects_everything);
+    RUN_TEST(test_gateway_batches_and_retries);
+    RUN_TEST(test_gateway_rx_queue_overflow_is_counted);
+    return UNITY_END();
+}
@@ -0,0 +1,243 @@
+// Sensor record / replay: a capture in the SampleLog format is replayed
+// through Sensor and DerivedMetrics, and the AirData / LightData /
+// DerivedData sequence must come out the same every time. A live run on the
+// fake drivers in test/stubs must also replay to exactly what it produced.
+
+#include <unity.h>
+#include <vector>
+#include "Sensor/Sensor.h"
+#include "Metrics/DerivedMetrics.h"
+#include "Bus/I2CBus.h"
+
+#define ALTITUDE_M 120.0
+
+// A BME680 + VEML6075 node as a front comes in: falling pressure, rising
+// humidity, fading UV. One gas measurement per 5 min, one failed BME680
+// read and one VEML6075 read with a NaN UV index. Written by `rec start`
+// and listed here the way `rec dump` prints it.
+static const SampleRecord CAPTURE[] = {
+    {600000, SAMPLE_AIR, AIR_BME680, 1, 0, {18.45, 62.0, 101325.0, 152300.0}},
+    {600004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {41.5, 28.0, 1.9, -999.0}},
+    {660000, SAMPLE_AIR, AIR_BME680, 1, 0, {18.32, 63.3, 101300.0, -999.0}},
+    {660004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {39.8, 26.9, 1.83, -999.0}},
+    {720000, SAMPLE_AIR, AIR_BME680, 1, 0, {18.24, 64.6, 101282.0, -999.0}},
+    {720004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {38.1, 25.8, 1.76, -999.0}},
+    {780000, SAMPLE_AIR, AIR_BME680, 1, 0, {18.21, 65.9, 101258.0, -999.0}},
+    {780004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {36.4, 24.7, 1.69, -999.0}},
+    {840000, SAMPLE_AIR, AIR_BME680, 1, 0, {18.08, 67.2, 101239.0, -999.0}},
+    {840004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {34.7, 23.6, 1.62, -999.0}},
+    {900000, SAMPLE_AIR, AIR_BME680, 1, 0, {18.0, 68.5, 101214.0, 141800.0}},
+    {900004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {33.0, 22.5, 1.55, -999.0}},
+    {960000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.97, 69.8, 101196.0, -999.0}},
+    {960004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {31.3, 21.4, 1.48, -999.0}},
+    {1020000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.84, 71.1, 101172.0, -999.0}},
+    {1020004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {29.6, 20.3, NAN, -999.0}},
+    {1080000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.76, 72.4, 101153.0, -999.0}},
+    {1080004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {27.9, 19.2, 1.34, -999.0}},
+    {1140000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.73, 73.7, 101128.0, -999.0}},
+    {1140004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {26.2, 18.1, 1.27, -999.0}},
+    {1200000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.6, 75.0, 101110.0, 131300.0}},
+    {1200004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {24.5, 17.0, 1.2, -999.0}},
+    {1260000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.52, 76.3, 101086.0, -999.0}},
+    {1260004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {22.8, 15.9, 1.13, -999.0}},
+    {1320000, SAMPLE_AIR, AIR_BME680, 0, 0, {-999.0, -999.0, -999.0, -999.0}},
+    {1320004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {21.1, 14.8, 1.06, -999.0}},
+    {1380000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.36, 78.9, 101042.0, -999.0}},
+    {1380004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {19.4, 13.7, 0.99, -999.0}},
+    {1440000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.28, 80.2, 101024.0, -999.0}},
+    {1440004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {17.7, 12.6, 0.92, -999.0}},
+    {1500000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.25, 81.5, 101000.0, 120800.0}},
+    {1500004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {16.0, 11.5, 0.85, -999.0}},
+    {1560000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.12, 82.8, 100981.0, -999.0}},
+    {1560004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {14.3, 10.4, 0.78, -999.0}},
+    {1620000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.04, 84.1, 100956.0, -999.0}},
+    {1620004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {12.6, 9.3, 0.71, -999.0}},
+    {1680000, SAMPLE_AIR, AIR_BME680, 1, 0, {17.01, 85.4, 100938.0, -999.0}},
+    {1680004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {10.9, 8.2, 0.64, -999.0}},
+    {1740000, SAMPLE_AIR, AIR_BME680, 1, 0, {16.88, 86.7, 100914.0, -999.0}},
+    {1740004, SAMPLE_LIGHT, LIGHT_VEML6075, 1, 0, {9.2, 7.1, 0.57, -999.0}},
+};
+#define CAPTURE_CYCLES (sizeof(CAPTURE) / sizeof(CAPTURE[0]) / 2)
+
+// One loop iteration of the firmware
+struct Step {
+    bool airOk;
+    bool lightOk;
+    AirData air;
+    LightData light;
+    DerivedData derived;
+};
+
+static void writeCapture() {
+    struct {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t recordSize;
+    } header = {SAMPLELOG_MAGIC, SAMPLELOG_VERSION, sizeof(SampleRecord)};
+    File f = LittleFS.open(SAMPLELOG_PATH, "w");
+    f.write((const uint8_t*)&header, sizeof(header));
+    f.write((const uint8_t*)CAPTURE, sizeof(CAPTURE));
+    f.close();
+}
+
+// The firmware loop: readings land in the same structs every cycle
+struct Node {
+    AirData air;
+    LightData light;
+    DerivedMetrics metrics;
+    Node() { metrics.setAltitude(ALTITUDE_M); }
+};
+
+static Step runStep(Sensor &sensor, Node &node) {
+    sensor.readAll(node.air, node.light);
+    node.metrics.update(node.air);
+    return {node.air.valid, node.light.valid, node.air, node.light, node.metrics.get()};
+}
+
+static std::vector<Step> replay(Sensor &sensor, SampleLog &log) {
+    Node node;
+    std::vector<Step> steps;
+    TEST_ASSERT_TRUE(log.startReplay(false));
+    for (;;) {
+        Step s = runStep(sensor, node);
+        if (!log.isReplaying()) break; // Read past the end of the capture
+        steps.push_back(s);
+    }
+    return steps;
+}
+
+// Bit-exact, so NaN and -999.0 sentinels compare too
+static bool same(float a, float b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static void assertSameSteps(const std::vector<Step> &a, const std::vector<Step> &b) {
+    TEST_ASSERT_EQUAL(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        const Step &x = a[i], &y = b[i];
+        TEST_ASSERT_EQUAL(x.airOk, y.airOk);
+        TEST_ASSERT_EQUAL(x.lightOk, y.lightOk);
+        TEST_ASSERT_TRUE(same(x.air.temperature, y.air.temperature));
+        TEST_ASSERT_TRUE(same(x.air.humidity, y.air.humidity));
+        TEST_ASSERT_TRUE(same(x.air.pressure, y.air.pressure));
+        TEST_ASSERT_TRUE(same(x.air.gasResistance, y.air.gasResistance));
+        TEST_ASSERT_TRUE(same(x.air.iaq, y.air.iaq));
+        TEST_ASSERT_EQUAL(x.air.iaqAccuracy, y.air.iaqAccuracy);
+        TEST_ASSERT_TRUE(same(x.light.uvIndex, y.light.uvIndex));
+        TEST_ASSERT_TRUE(same(x.light.uva, y.light.uva));
+        TEST_ASSERT_TRUE(same(x.light.uvb, y.light.uvb));
+        TEST_ASSERT_EQUAL(x.derived.valid, y.derived.valid);
+        TEST_ASSERT_TRUE(same(x.derived.dewPoint, y.derived.dewPoint));
+        TEST_ASSERT_TRUE(same(x.derived.heatIndex, y.derived.heatIndex));
+        TEST_ASSERT_TRUE(same(x.derived.seaLevelPressure, y.derived.seaLevelPressure));
+        TEST_ASSERT_TRUE(same(x.derived.absHumidity, y.derived.absHumidity));
+    }
+}
+
+void setUp() {
+    Host::nowMs = 1000;
+    LittleFS.format();
+    Host::nvs().clear();
+    Adafruit_BME680::fake = FakeSensor();
+    Adafruit_VEML6075::fake = FakeSensor();
+    Wire.detach(0x10);
+    I2CBus::begin(Wire, I2C_SDA, I2C_SCL);
+    for (uint8_t i = 0; i < I2C_DEV_COUNT; i++) I2CBus::report((I2CDevice)i, true);
+}
+
+void tearDown() {}
+
+static void test_capture_replays_as_recorded() {
+    writeCapture();
+    SampleLog log;
+    Sensor sensor;
+    sensor.attachLog(&log);
+    sensor.begin(); // No parts fitted: a bench node replaying a field capture
+    std::vector<Step> steps = replay(sensor, log);
+    TEST_ASSERT_EQUAL(CAPTURE_CYCLES, steps.size());
+
+    // Pa -> hPa, Ohm -> kOhm; the IAQ starts learning at the first gas reading
+    TEST_ASSERT_TRUE(steps[0].airOk);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1013.25, steps[0].air.pressure);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 152.3, steps[0].air.gasResistance);
+    TEST_ASSERT_TRUE(steps[0].air.iaq != -999.0);
+    TEST_ASSERT_EQUAL(1, steps[0].air.iaqAccuracy);
+    TEST_ASSERT_TRUE(steps[0].derived.valid);
+
+    // Unheated reads hold the last gas measurement
+    TEST_ASSERT_TRUE(same(steps[0].air.gasResistance, steps[4].air.gasResistance));
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 141.8, steps[5].air.gasResistance);
+
+    // The failed read and the NaN UV index are dropped, the other stream is not
+    TEST_ASSERT_FALSE(steps[12].airOk);
+    TEST_ASSERT_TRUE(steps[12].lightOk);
+    TEST_ASSERT_FALSE(steps[7].lightOk);
+    TEST_ASSERT_TRUE(steps[7].airOk);
+
+    // Once the capture ends the sensor is live again
+    TEST_ASSERT_FALSE(log.isReplaying());
+}
+
+static void test_replay_is_deterministic() {
+    writeCapture();
+    SampleLog log;
+    Sensor sensor;
+    sensor.attachLog(&log);
+    sensor.begin();
+    std::vector<Step> first = replay(sensor, log);
+    std::vector<Step> again = replay(sensor, log);
+
+    // A fresh node, as after a reboot
+    Sensor other;
+    SampleLog otherLog;
+    other.attachLog(&otherLog);
+    other.begin();
+    std::vector<Step> rebooted = replay(other, otherLog);
+
+    assertSameSteps(first, again);
+    assertSameSteps(first, rebooted);
+}
+
+static void test_live_run_replays_identically() {
+    Adafruit_BME680::fake.fitted = true;
+    Adafruit_VEML6075::fake.fitted = true;
+    Wire.attach(0x10);
+
+    SampleLog log;
+    Sensor sensor;
+    sensor.attachLog(&log);
+    sensor.begin();
+    TEST_ASSERT_EQUAL(AIR_BME680, sensor.getFoundAirSensor());
+    TEST_ASSERT_EQUAL(LIGHT_VEML6075, sensor.getFoundLightSensor());
+
+    // Live: the fake drivers follow the capture, recording on
+    Node node;
+    std::vector<Step> live;
+    TEST_ASSERT_TRUE(log.startRecording());
+    for (size_t i = 0; i < CAPTURE_CYCLES; i++) {
+        const SampleRecord &air = CAPTURE[2 * i];
+        const SampleRecord &light = CAPTURE[2 * i + 1];
+        Host::nowMs = air.ms;
+        if (air.ok) Adafruit_BME680::fake.set(air.v[0], air.v[1], air.v[2], 152300.0 - i * 1000.0);
+        else Adafruit_BME680::fake.set(NAN);
+        Adafruit_VEML6075::fake.set(light.v[0], light.v[1], light.v[2]);
+        live.push_back(runStep(sensor, node));
+    }
+    log.stopRecording();
+    TEST_ASSERT_EQUAL(2 * CAPTURE_CYCLES, log.recordCount());
+
+    // Gas was measured on the first read and then every 5 min
+    TEST_ASSERT_TRUE(live[0].air.gasResistance > 0);
+    TEST_ASSERT_TRUE(same(live[0].air.gasResistance, live[4].air.gasResistance));
+    TEST_ASSERT_FALSE(same(live[4].air.gasResistance, live[5].air.gasResistance));
+
+    assertSameSteps(live, replay(sensor, log));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_capture_replays_as_recorded);
+    RUN_TEST(test_replay_is_deterministic);
+    RUN_TEST(test_live_run_replays_identically);
+    return UNITY_END();
+}
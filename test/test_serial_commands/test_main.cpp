@@ -0,0 +1,140 @@
+// SerialCommands line assembly and dispatch, fed through a scripted Stream
+// the way bytes trickle in over USB-CDC.
+
+#include <unity.h>
+#include <string>
+#include "Config/SerialCommands.h"
+
+// Serves the bytes a test pushes and records what is printed back
+class FakeSerial : public Stream {
+public:
+    void push(const std::string &bytes) { _in += bytes; }
+    size_t write(uint8_t c) override {
+        out += (char)c;
+        return 1;
+    }
+    using Print::write;
+    int available() override { return (int)(_in.size() - _pos); }
+    int read() override { return _pos < _in.size() ? (uint8_t)_in[_pos++] : -1; }
+
+    std::string out;
+
+private:
+    std::string _in;
+    size_t _pos = 0;
+};
+
+static FakeSerial* s_io;
+static SerialCommands* s_commands;
+static std::string s_last;   // "<command>:<args>" of the last dispatch
+static uint32_t s_dispatched;
+
+static void record(const char* name, const char* args) {
+    s_last = std::string(name) + ":" + args;
+    s_dispatched++;
+}
+
+void setUp() {
+    s_io = new FakeSerial();
+    s_commands = new SerialCommands();
+    s_commands->begin(*s_io);
+    s_commands->add("info", [](const char* a) { record("info", a); });
+    s_commands->add("SET_CONFIG", [](const char* a) { record("SET_CONFIG", a); });
+    s_commands->add("ssid=", [](const char* a) { record("ssid=", a); });
+    s_last.clear();
+    s_dispatched = 0;
+}
+
+void tearDown() {
+    delete s_commands;
+    delete s_io;
+}
+
+static void test_line_split_across_polls() {
+    s_io->push("SET_CONF");
+    s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(0, s_dispatched);
+    s_io->push("IG {\"interval\":");
+    s_commands->poll();
+    s_io->push("10}\n");
+    s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(1, s_dispatched);
+    TEST_ASSERT_EQUAL_STRING("SET_CONFIG:{\"interval\":10}", s_last.c_str());
+}
+
+static void test_byte_at_a_time() {
+    for (const char* p = "info\n"; *p; p++) s_commands->feed(*p);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dispatched);
+    TEST_ASSERT_EQUAL_STRING("info:", s_last.c_str());
+}
+
+static void test_crlf_ends_one_line() {
+    s_io->push("info\r\ninfo\r\n");
+    s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(2, s_dispatched);
+    TEST_ASSERT_EQUAL_STRING("", s_io->out.c_str()); // The \n after \r is an empty line, not an error
+}
+
+static void test_overlong_line_is_dropped_whole() {
+    std::string line = "SET_CONFIG " + std::string(SERIAL_CMD_LINE_MAX, 'x') + "\n";
+    s_io->push(line);
+    while (s_io->available()) s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(0, s_dispatched);
+    TEST_ASSERT_EQUAL_STRING("LINE_TOO_LONG\r\n", s_io->out.c_str());
+
+    // The tail of the long line must not leak into the next command
+    s_io->push("info\n");
+    s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(1, s_dispatched);
+    TEST_ASSERT_EQUAL_STRING("info:", s_last.c_str());
+}
+
+static void test_longest_line_fits() {
+    std::string args(SERIAL_CMD_LINE_MAX - 1 - strlen("SET_CONFIG "), 'x');
+    s_io->push("SET_CONFIG " + args + "\n");
+    while (s_io->available()) s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(1, s_dispatched);
+    TEST_ASSERT_EQUAL_STRING(("SET_CONFIG:" + args).c_str(), s_last.c_str());
+}
+
+static void test_poll_budget() {
+    std::string burst;
+    for (int i = 0; i < SERIAL_CMD_POLL_BUDGET; i++) burst += "info\n";
+    s_io->push(burst);
+    s_commands->poll();
+    TEST_ASSERT_EQUAL_UINT32(SERIAL_CMD_POLL_BUDGET / 5, s_dispatched);
+    TEST_ASSERT_EQUAL(burst.size() - SERIAL_CMD_POLL_BUDGET, (size_t)s_io->available());
+}
+
+static void test_matching() {
+    char line[64];
+    strcpy(line, "  INFO  ");
+    TEST_ASSERT_TRUE(s_commands->dispatch(line));
+    TEST_ASSERT_EQUAL_STRING("info:", s_last.c_str());
+
+    strcpy(line, "infox");
+    TEST_ASSERT_FALSE(s_commands->dispatch(line));
+
+    strcpy(line, "ssid=My Net");
+    TEST_ASSERT_TRUE(s_commands->dispatch(line));
+    TEST_ASSERT_EQUAL_STRING("ssid=:My Net", s_last.c_str());
+
+    strcpy(line, "SET_CONFIG    {}");
+    TEST_ASSERT_TRUE(s_commands->dispatch(line));
+    TEST_ASSERT_EQUAL_STRING("SET_CONFIG:{}", s_last.c_str());
+
+    strcpy(line, " \t ");
+    TEST_ASSERT_FALSE(s_commands->dispatch(line));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_line_split_across_polls);
+    RUN_TEST(test_byte_at_a_time);
+    RUN_TEST(test_crlf_ends_one_line);
+    RUN_TEST(test_overlong_line_is_dropped_whole);
+    RUN_TEST(test_longest_line_fits);
+    RUN_TEST(test_poll_budget);
+    RUN_TEST(test_matching);
+    return UNITY_END();
+}
@@ -0,0 +1,96 @@
+// Current values from /api/weather (every 10 s) and hourly/5-min trends
+// from /api/archive (every 5 min). No dependencies.
+const CHANNELS = [
+  { key: "temperature", label: "Temperature", unit: "°C" },
+  { key: "humidity", label: "Humidity", unit: "%" },
+  { key: "pressure", label: "Pressure", unit: "hPa" },
+  { key: "air_quality", archive: "iaq", label: "Air Quality", unit: "IAQ" },
+  { key: "uv_index", label: "UV Index", unit: "" },
+  { key: "dew_point", label: "Dew Point", unit: "°C" },
+];
+
+const cards = document.getElementById("cards");
+const statusEl = document.getElementById("status");
+const hoursEl = document.getElementById("hours");
+
+for (const ch of CHANNELS) {
+  const el = document.createElement("div");
+  el.className = "card";
+  el.id = "card-" + ch.key;
+  el.innerHTML =
+    `<div class="label">${ch.label}</div>` +
+    `<div class="value">–<span class="unit">${ch.unit}</span></div>` +
+    `<svg viewBox="0 0 100 40" preserveAspectRatio="none"><polyline points=""/></svg>` +
+    `<div class="range"></div>`;
+  cards.appendChild(el);
+}
+
+function setStatus(ok, text) {
+  statusEl.textContent = text;
+  statusEl.className = "badge " + (ok ? "ok" : "err");
+}
+
+async function refreshCurrent() {
+  try {
+    const res = await fetch("/api/weather", { cache: "no-store" });
+    const data = await res.json();
+    for (const ch of CHANNELS) {
+      const v = data[ch.key];
+      const el = document.querySelector(`#card-${ch.key} .value`);
+      el.firstChild.textContent = v === null || v === undefined ? "–" : Number(v).toFixed(1);
+    }
+    setStatus(true, "Online · " + new Date().toLocaleTimeString());
+  } catch (e) {
+    setStatus(false, "Offline");
+  }
+}
+
+async function refreshTrend() {
+  const hours = Number(hoursEl.value);
+  const tier = hours > 48 ? "1h" : "5m";
+  const now = Math.floor(Date.now() / 1000);
+  try {
+    const res = await fetch(`/api/archive?tier=${tier}&from=${now - hours * 3600}&to=${now}`);
+    const data = await res.json();
+    for (const ch of CHANNELS) {
+      const idx = data.fields.indexOf((ch.archive || ch.key) + "_mean");
+      const card = document.getElementById("card-" + ch.key);
+      const points = idx < 0 ? [] : data.rows.filter((r) => r[idx] !== null).map((r) => [r[0], r[idx]]);
+      drawTrend(card, points, data.rows, idx);
+    }
+  } catch (e) {
+    // Archive disabled or clock not synced yet: keep the cards without trends
+  }
+}
+
+function drawTrend(card, points, rows, idx) {
+  const line = card.querySelector("polyline");
+  const range = card.querySelector(".range");
+  if (points.length < 2) {
+    line.setAttribute("points", "");
+    range.textContent = "";
+    return;
+  }
+  const t0 = points[0][0];
+  const t1 = points[points.length - 1][0];
+  let lo = Infinity;
+  let hi = -Infinity;
+  for (const r of rows) {
+    if (r[idx - 1] !== null) lo = Math.min(lo, r[idx - 1]);
+    if (r[idx + 1] !== null) hi = Math.max(hi, r[idx + 1]);
+  }
+  const span = hi - lo || 1;
+  line.setAttribute(
+    "points",
+    points
+      .map(([t, v]) => `${(((t - t0) / (t1 - t0 || 1)) * 100).toFixed(1)},${(38 - ((v - lo) / span) * 36).toFixed(1)}`)
+      .join(" ")
+  );
+  range.textContent = `min ${lo.toFixed(1)} · max ${hi.toFixed(1)}`;
+}
+
+hoursEl.addEventListener("change", refreshTrend);
+refreshCurrent();
+refreshTrend();
+setInterval(refreshCurrent, 10000);
+setInterval(refreshTrend, 300000);